@@ -37,6 +37,7 @@
 #include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/marshalls.h"
+#include "core/io/resource_streamer.h"
 #include "core/math/geometry_2d.h"
 #include "core/math/geometry_3d.h"
 #include "core/os/keyboard.h"
@@ -67,6 +68,58 @@ Ref<Resource> ResourceLoader::load_threaded_get(const String &p_path) {
 	return res;
 }
 
+Error ResourceLoader::load_streaming_request(const String &p_path, const String &p_type_hint, float p_priority, CacheMode p_cache_mode) {
+	return ResourceStreamer::request(p_path, p_type_hint, p_priority, ResourceFormatLoader::CacheMode(p_cache_mode));
+}
+
+bool ResourceLoader::load_streaming_cancel(const String &p_path) {
+	return ResourceStreamer::cancel(p_path);
+}
+
+ResourceLoader::ThreadLoadStatus ResourceLoader::load_streaming_get_status(const String &p_path) {
+	return (ThreadLoadStatus)ResourceStreamer::get_status(p_path);
+}
+
+Ref<Resource> ResourceLoader::load_streaming_get(const String &p_path) {
+	Error error;
+	Ref<Resource> res = ResourceStreamer::get(p_path, &error);
+	ERR_FAIL_COND_V_MSG(error != OK, res, "Error loading resource: '" + p_path + "'.");
+	return res;
+}
+
+void ResourceLoader::set_streaming_priority(const String &p_path, float p_priority) {
+	ResourceStreamer::set_priority(p_path, p_priority);
+}
+
+void ResourceLoader::set_streaming_position(const String &p_path, const Vector3 &p_position) {
+	ResourceStreamer::set_position(p_path, p_position);
+}
+
+void ResourceLoader::set_streaming_origin(const Vector3 &p_origin) {
+	ResourceStreamer::set_origin(p_origin);
+}
+
+Vector3 ResourceLoader::get_streaming_origin() const {
+	return ResourceStreamer::get_origin();
+}
+
+void ResourceLoader::set_streaming_max_loads(int p_max_loads) {
+	ResourceStreamer::set_max_loads(p_max_loads);
+}
+
+int ResourceLoader::get_streaming_max_loads() const {
+	return ResourceStreamer::get_max_loads();
+}
+
+void ResourceLoader::set_streaming_memory_budget(int64_t p_bytes) {
+	ERR_FAIL_COND(p_bytes < 0);
+	ResourceStreamer::set_memory_budget(p_bytes);
+}
+
+int64_t ResourceLoader::get_streaming_memory_budget() const {
+	return ResourceStreamer::get_memory_budget();
+}
+
 Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hint, CacheMode p_cache_mode) {
 	Error err = OK;
 	Ref<Resource> ret = ::ResourceLoader::load(p_path, p_type_hint, ResourceFormatLoader::CacheMode(p_cache_mode), &err);
@@ -128,6 +181,19 @@ void ResourceLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load_threaded_get_status", "path", "progress"), &ResourceLoader::load_threaded_get_status, DEFVAL(Array()));
 	ClassDB::bind_method(D_METHOD("load_threaded_get", "path"), &ResourceLoader::load_threaded_get);
 
+	ClassDB::bind_method(D_METHOD("load_streaming_request", "path", "type_hint", "priority", "cache_mode"), &ResourceLoader::load_streaming_request, DEFVAL(""), DEFVAL(0.0), DEFVAL(CACHE_MODE_REUSE));
+	ClassDB::bind_method(D_METHOD("load_streaming_cancel", "path"), &ResourceLoader::load_streaming_cancel);
+	ClassDB::bind_method(D_METHOD("load_streaming_get_status", "path"), &ResourceLoader::load_streaming_get_status);
+	ClassDB::bind_method(D_METHOD("load_streaming_get", "path"), &ResourceLoader::load_streaming_get);
+	ClassDB::bind_method(D_METHOD("set_streaming_priority", "path", "priority"), &ResourceLoader::set_streaming_priority);
+	ClassDB::bind_method(D_METHOD("set_streaming_position", "path", "position"), &ResourceLoader::set_streaming_position);
+	ClassDB::bind_method(D_METHOD("set_streaming_origin", "origin"), &ResourceLoader::set_streaming_origin);
+	ClassDB::bind_method(D_METHOD("get_streaming_origin"), &ResourceLoader::get_streaming_origin);
+	ClassDB::bind_method(D_METHOD("set_streaming_max_loads", "max_loads"), &ResourceLoader::set_streaming_max_loads);
+	ClassDB::bind_method(D_METHOD("get_streaming_max_loads"), &ResourceLoader::get_streaming_max_loads);
+	ClassDB::bind_method(D_METHOD("set_streaming_memory_budget", "bytes"), &ResourceLoader::set_streaming_memory_budget);
+	ClassDB::bind_method(D_METHOD("get_streaming_memory_budget"), &ResourceLoader::get_streaming_memory_budget);
+
 	ClassDB::bind_method(D_METHOD("load", "path", "type_hint", "cache_mode"), &ResourceLoader::load, DEFVAL(""), DEFVAL(CACHE_MODE_REUSE));
 	ClassDB::bind_method(D_METHOD("get_recognized_extensions_for_type", "type"), &ResourceLoader::get_recognized_extensions_for_type);
 	ClassDB::bind_method(D_METHOD("add_resource_format_loader", "format_loader", "at_front"), &ResourceLoader::add_resource_format_loader, DEFVAL(false));
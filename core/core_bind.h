@@ -76,6 +76,19 @@ public:
 	ThreadLoadStatus load_threaded_get_status(const String &p_path, Array r_progress = Array());
 	Ref<Resource> load_threaded_get(const String &p_path);
 
+	Error load_streaming_request(const String &p_path, const String &p_type_hint = "", float p_priority = 0.0, CacheMode p_cache_mode = CACHE_MODE_REUSE);
+	bool load_streaming_cancel(const String &p_path);
+	ThreadLoadStatus load_streaming_get_status(const String &p_path);
+	Ref<Resource> load_streaming_get(const String &p_path);
+	void set_streaming_priority(const String &p_path, float p_priority);
+	void set_streaming_position(const String &p_path, const Vector3 &p_position);
+	void set_streaming_origin(const Vector3 &p_origin);
+	Vector3 get_streaming_origin() const;
+	void set_streaming_max_loads(int p_max_loads);
+	int get_streaming_max_loads() const;
+	void set_streaming_memory_budget(int64_t p_bytes);
+	int64_t get_streaming_memory_budget() const;
+
 	Ref<Resource> load(const String &p_path, const String &p_type_hint = "", CacheMode p_cache_mode = CACHE_MODE_REUSE);
 	Vector<String> get_recognized_extensions_for_type(const String &p_type);
 	void add_resource_format_loader(Ref<ResourceFormatLoader> p_format_loader, bool p_at_front);
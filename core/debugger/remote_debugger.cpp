@@ -38,6 +38,7 @@
 #include "core/input/input.h"
 #include "core/io/resource_loader.h"
 #include "core/object/script_language.h"
+#include "core/os/heap_profiler.h"
 #include "core/os/os.h"
 
 class RemoteDebugger::PerformanceProfiler : public EngineProfiler {
@@ -92,6 +93,91 @@ public:
 	}
 };
 
+class RemoteDebugger::AllocationProfiler : public EngineProfiler {
+	static constexpr int MAX_SITES = 16;
+
+	bool started = false;
+	uint64_t last_tick_time = 0;
+	HeapProfiler::TagStats last_tags[HeapProfiler::MAX_TAGS];
+	HashMap<void *, String> symbol_cache;
+
+	String _get_symbol(void *p_address) {
+		HashMap<void *, String>::Iterator E = symbol_cache.find(p_address);
+		if (E) {
+			return E->value;
+		}
+		char buffer[512];
+		HeapProfiler::symbolize(p_address, buffer, sizeof(buffer));
+		return symbol_cache.insert(p_address, String::utf8(buffer))->value;
+	}
+
+public:
+	void toggle(bool p_enable, const Array &p_opts) {
+		if (p_enable) {
+			if (!HeapProfiler::is_active()) {
+				// Optional first option: sample period in bytes.
+				uint64_t period = p_opts.size() > 0 ? uint64_t(p_opts[0]) : uint64_t(HeapProfiler::DEFAULT_SAMPLE_PERIOD);
+				HeapProfiler::start(period);
+				started = true;
+			}
+			last_tick_time = OS::get_singleton()->get_ticks_usec();
+			HeapProfiler::get_tag_stats(last_tags, HeapProfiler::MAX_TAGS);
+		} else if (started) {
+			// Leave a profile started from the command line running.
+			HeapProfiler::stop();
+			started = false;
+		}
+	}
+
+	void add(const Array &p_data) {}
+
+	void tick(double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) {
+		uint64_t now = OS::get_singleton()->get_ticks_usec();
+		if (now - last_tick_time < 1000000) {
+			return;
+		}
+		double elapsed = (now - last_tick_time) / 1000000.0;
+		last_tick_time = now;
+
+		HeapProfiler::TagStats tags[HeapProfiler::MAX_TAGS];
+		int tag_count = HeapProfiler::get_tag_stats(tags, HeapProfiler::MAX_TAGS);
+
+		// Format: [tag_count, (name, live_bytes, allocs_per_second, bytes_per_second) * tag_count,
+		//          site_count, (tag_name, live_bytes, frame_count, frame symbols...) * site_count]
+		Array arr;
+		arr.push_back(tag_count);
+		for (int i = 0; i < tag_count; i++) {
+			// New tags start from zero.
+			const HeapProfiler::TagStats &prev = last_tags[i];
+			arr.push_back(String(tags[i].name));
+			arr.push_back(tags[i].live_bytes);
+			arr.push_back((tags[i].alloc_count - (prev.name ? prev.alloc_count : 0)) / elapsed);
+			arr.push_back((tags[i].alloc_bytes - (prev.name ? prev.alloc_bytes : 0)) / elapsed);
+			last_tags[i] = tags[i];
+		}
+
+		HeapProfiler::SiteStats sites[MAX_SITES];
+		int site_count = HeapProfiler::get_top_sites(sites, MAX_SITES);
+		arr.push_back(site_count);
+		for (int i = 0; i < site_count; i++) {
+			arr.push_back(sites[i].tag < (uint32_t)tag_count ? String(tags[sites[i].tag].name) : String());
+			arr.push_back(sites[i].live_bytes);
+			arr.push_back(sites[i].frame_count);
+			for (int j = 0; j < sites[i].frame_count; j++) {
+				arr.push_back(_get_symbol(sites[i].frames[j]));
+			}
+		}
+
+		EngineDebugger::get_singleton()->send_message("heap:profile_frame", arr);
+	}
+
+	~AllocationProfiler() {
+		if (started) {
+			HeapProfiler::stop();
+		}
+	}
+};
+
 Error RemoteDebugger::_put_msg(const String &p_message, const Array &p_data) {
 	Array msg;
 	msg.push_back(p_message);
@@ -669,6 +755,10 @@ RemoteDebugger::RemoteDebugger(Ref<RemoteDebuggerPeer> p_peer) {
 		profiler_enable("performance", true);
 	}
 
+	// Heap allocation profiler, only sampling while enabled.
+	allocation_profiler.instantiate();
+	allocation_profiler->bind("heap");
+
 	// Core and profiler captures.
 	Capture core_cap(this,
 			[](void *p_user, const String &p_cmd, const Array &p_data, bool &r_captured) {
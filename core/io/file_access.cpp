@@ -39,10 +39,12 @@
 #include "core/os/os.h"
 
 FileAccess::CreateFunc FileAccess::create_func[ACCESS_MAX] = {};
+FileAccess::CreateFunc FileAccess::create_mapped_func[ACCESS_MAX] = {};
 
 FileAccess::FileCloseFailNotify FileAccess::close_fail_notify = nullptr;
 
 bool FileAccess::backup_save = false;
+bool FileAccess::mapped_reads = false;
 thread_local Error FileAccess::last_file_open_error = OK;
 
 Ref<FileAccess> FileAccess::create(AccessType p_access) {
@@ -70,19 +72,20 @@ void FileAccess::_set_access_type(AccessType p_access) {
 	_access_type = p_access;
 }
 
-Ref<FileAccess> FileAccess::create_for_path(const String &p_path) {
-	Ref<FileAccess> ret;
+FileAccess::AccessType FileAccess::_get_access_type_for_path(const String &p_path) {
 	if (p_path.begins_with("res://")) {
-		ret = create(ACCESS_RESOURCES);
+		return ACCESS_RESOURCES;
 	} else if (p_path.begins_with("user://")) {
-		ret = create(ACCESS_USERDATA);
+		return ACCESS_USERDATA;
 	} else if (p_path.begins_with("pipe://")) {
-		ret = create(ACCESS_PIPE);
+		return ACCESS_PIPE;
 	} else {
-		ret = create(ACCESS_FILESYSTEM);
+		return ACCESS_FILESYSTEM;
 	}
+}
 
-	return ret;
+Ref<FileAccess> FileAccess::create_for_path(const String &p_path) {
+	return create(_get_access_type_for_path(p_path));
 }
 
 Error FileAccess::reopen(const String &p_path, int p_mode_flags) {
@@ -103,7 +106,22 @@ Ref<FileAccess> FileAccess::open(const String &p_path, int p_mode_flags, Error *
 		}
 	}
 
-	ret = create_for_path(p_path);
+	if (p_mode_flags == READ && mapped_reads) {
+		Error err = OK;
+		ret = _open_mapped(p_path, err);
+		if (ret.is_valid()) {
+			if (r_error) {
+				*r_error = OK;
+			}
+			return ret;
+		}
+	}
+
+	return _open_default(p_path, p_mode_flags, r_error);
+}
+
+Ref<FileAccess> FileAccess::_open_default(const String &p_path, int p_mode_flags, Error *r_error) {
+	Ref<FileAccess> ret = create_for_path(p_path);
 	Error err = ret->open_internal(p_path, p_mode_flags);
 
 	if (r_error) {
@@ -116,6 +134,47 @@ Ref<FileAccess> FileAccess::open(const String &p_path, int p_mode_flags, Error *
 	return ret;
 }
 
+Ref<FileAccess> FileAccess::_open_mapped(const String &p_path, Error &r_error) {
+	AccessType access = _get_access_type_for_path(p_path);
+	if (!create_mapped_func[access]) {
+		r_error = ERR_UNAVAILABLE;
+		return Ref<FileAccess>();
+	}
+
+	Ref<FileAccess> ret = create_mapped_func[access]();
+	ret->_set_access_type(access);
+	r_error = ret->open_internal(p_path, READ);
+	if (r_error != OK) {
+		ret.unref();
+	}
+	return ret;
+}
+
+Ref<FileAccess> FileAccess::open_mapped(const String &p_path, Error *r_error) {
+	if (PackedData::get_singleton() && !PackedData::get_singleton()->is_disabled()) {
+		Ref<FileAccess> ret = PackedData::get_singleton()->try_open_path(p_path);
+		if (ret.is_valid()) {
+			if (r_error) {
+				*r_error = OK;
+			}
+			return ret;
+		}
+	}
+
+	Error err = OK;
+	Ref<FileAccess> ret = _open_mapped(p_path, err);
+	if (ret.is_valid()) {
+		if (r_error) {
+			*r_error = OK;
+		}
+		return ret;
+	}
+
+	// No mapping available (unsupported platform, special file, mmap failure), read it the usual way.
+	// The regular backend also reports the error if the file can't be opened at all.
+	return _open_default(p_path, READ, r_error);
+}
+
 Ref<FileAccess> FileAccess::_open(const String &p_path, ModeFlags p_mode_flags) {
 	Error err = OK;
 	Ref<FileAccess> fa = open(p_path, p_mode_flags, &err);
@@ -950,3 +1009,18 @@ void FileAccess::_bind_methods() {
 	BIND_BITFIELD_FLAG(UNIX_SET_GROUP_ID);
 	BIND_BITFIELD_FLAG(UNIX_RESTRICTED_DELETE);
 }
+
+Ref<FileBufferView> FileBufferView::create(const Ref<FileAccess> &p_file, uint64_t p_length) {
+	ERR_FAIL_COND_V(p_file.is_null(), Ref<FileBufferView>());
+
+	const uint8_t *ptr = p_file->get_buffer_ptr(p_length);
+	if (!ptr) {
+		return Ref<FileBufferView>();
+	}
+
+	Ref<FileBufferView> view = memnew(FileBufferView);
+	view->file = p_file;
+	view->data = ptr;
+	view->size = p_length;
+	return view;
+}
@@ -111,16 +111,21 @@ protected:
 
 private:
 	static bool backup_save;
+	static bool mapped_reads;
 	thread_local static Error last_file_open_error;
 
 	AccessType _access_type = ACCESS_FILESYSTEM;
 	static CreateFunc create_func[ACCESS_MAX]; /** default file access creation function for a platform */
+	static CreateFunc create_mapped_func[ACCESS_MAX]; /** read-only, memory-mapped file access creation function, if the platform has one */
 	template <typename T>
 	static Ref<FileAccess> _create_builtin() {
 		return memnew(T);
 	}
 
 	static Ref<FileAccess> _open(const String &p_path, ModeFlags p_mode_flags);
+	static AccessType _get_access_type_for_path(const String &p_path);
+	static Ref<FileAccess> _open_mapped(const String &p_path, Error &r_error);
+	static Ref<FileAccess> _open_default(const String &p_path, int p_mode_flags, Error *r_error);
 
 public:
 	static void set_file_close_fail_notify_callback(FileCloseFailNotify p_cbk) { close_fail_notify = p_cbk; }
@@ -150,6 +155,12 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	/**
+	 * Returns a pointer to the next p_length bytes and advances past them, or nullptr
+	 * (without moving) when the backend can't expose its storage directly, in which
+	 * case get_buffer() must be used. The pointer is valid until the file is closed.
+	 */
+	virtual const uint8_t *get_buffer_ptr(uint64_t p_length) const { return nullptr; }
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -198,6 +209,7 @@ public:
 	static Ref<FileAccess> create(AccessType p_access); /// Create a file access (for the current platform) this is the only portable way of accessing files.
 	static Ref<FileAccess> create_for_path(const String &p_path);
 	static Ref<FileAccess> open(const String &p_path, int p_mode_flags, Error *r_error = nullptr); /// Create a file access (for the current platform) this is the only portable way of accessing files.
+	static Ref<FileAccess> open_mapped(const String &p_path, Error *r_error = nullptr); /// Open for reading through a memory mapping if the platform supports it, regular open otherwise.
 
 	static Ref<FileAccess> open_encrypted(const String &p_path, ModeFlags p_mode_flags, const Vector<uint8_t> &p_key);
 	static Ref<FileAccess> open_encrypted_pass(const String &p_path, ModeFlags p_mode_flags, const String &p_pass);
@@ -218,6 +230,9 @@ public:
 	static void set_backup_save(bool p_enable) { backup_save = p_enable; };
 	static bool is_backup_save_enabled() { return backup_save; };
 
+	static void set_mapped_reads_enabled(bool p_enable) { mapped_reads = p_enable; }
+	static bool is_mapped_reads_enabled() { return mapped_reads; }
+
 	static String get_md5(const String &p_file);
 	static String get_sha256(const String &p_file);
 	static String get_multiple_md5(const Vector<String> &p_file);
@@ -233,10 +248,33 @@ public:
 		create_func[p_access] = _create_builtin<T>;
 	}
 
+	template <typename T>
+	static void make_mapped_default(AccessType p_access) {
+		create_mapped_func[p_access] = _create_builtin<T>;
+	}
+
 	FileAccess() {}
 	virtual ~FileAccess() {}
 };
 
+/**
+ * Read-only window over bytes a FileAccess exposes in place (see FileAccess::get_buffer_ptr()),
+ * such as a region of a memory-mapped PCK. Holds on to the file, so the memory stays valid for
+ * as long as the view is referenced.
+ */
+class FileBufferView : public RefCounted {
+	Ref<FileAccess> file;
+	const uint8_t *data = nullptr;
+	uint64_t size = 0;
+
+public:
+	// Takes the next p_length bytes of p_file, or returns null if they aren't directly addressable.
+	static Ref<FileBufferView> create(const Ref<FileAccess> &p_file, uint64_t p_length);
+
+	_FORCE_INLINE_ const uint8_t *ptr() const { return data; }
+	_FORCE_INLINE_ uint64_t get_size() const { return size; }
+};
+
 VARIANT_ENUM_CAST(FileAccess::CompressionMode);
 VARIANT_ENUM_CAST(FileAccess::ModeFlags);
 VARIANT_BITFIELD_CAST(FileAccess::UnixPermissionFlags);
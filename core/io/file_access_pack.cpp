@@ -102,6 +102,15 @@ void PackedData::add_pack_source(PackSource *p_source) {
 	}
 }
 
+Ref<FileBufferView> PackedData::try_open_view(const String &p_path) {
+	Ref<FileAccess> f = try_open_path(p_path);
+	if (f.is_null()) {
+		return Ref<FileBufferView>();
+	}
+	// Null unless the pack is mapped (see FileAccess::is_mapped_reads_enabled()) and the file is stored unencrypted.
+	return FileBufferView::create(f, f->get_length());
+}
+
 PackedData *PackedData::singleton = nullptr;
 
 PackedData::PackedData() {
@@ -344,6 +353,21 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_buffer_ptr(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), nullptr, "File must be opened before use.");
+
+	if (eof || p_length > pf.size - pos) {
+		return nullptr;
+	}
+
+	// Only succeeds when the pack itself is mapped, encrypted files always need a copy.
+	const uint8_t *ptr = f->get_buffer_ptr(p_length);
+	if (ptr) {
+		pos += p_length;
+	}
+	return ptr;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
@@ -119,6 +119,7 @@ public:
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
 
 	_FORCE_INLINE_ Ref<FileAccess> try_open_path(const String &p_path);
+	Ref<FileBufferView> try_open_view(const String &p_path);
 	_FORCE_INLINE_ bool has_path(const String &p_path);
 
 	_FORCE_INLINE_ Ref<DirAccess> try_open_directory(const String &p_path);
@@ -172,6 +173,7 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_buffer_ptr(uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -513,7 +513,7 @@ Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index,
 
 void JSON::set_data(const Variant &p_data) {
 	data = p_data;
-	text.clear();
+	text = CompactString();
 }
 
 Error JSON::_parse_string(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line) {
@@ -651,7 +651,10 @@ Error ResourceFormatSaverJSON::save(const Ref<Resource> &p_resource, const Strin
 	Ref<JSON> json = p_resource;
 	ERR_FAIL_COND_V(json.is_null(), ERR_INVALID_PARAMETER);
 
-	String source = json->get_parsed_text().is_empty() ? JSON::stringify(json->get_data(), "\t", false, true) : json->get_parsed_text();
+	String source = json->get_parsed_text();
+	if (source.is_empty()) {
+		source = JSON::stringify(json->get_data(), "\t", false, true);
+	}
 
 	Error err;
 	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
@@ -34,6 +34,7 @@
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/string/compact_string.h"
 #include "core/variant/variant.h"
 
 class JSON : public Resource {
@@ -65,7 +66,7 @@ class JSON : public Resource {
 		Variant value;
 	};
 
-	String text;
+	CompactString text; // Mostly ASCII, stored one byte per character.
 	Variant data;
 	String err_str;
 	int err_line = 0;
@@ -35,6 +35,8 @@
 #include "core/object/script_language.h"
 #include "core/os/keyboard.h"
 #include "core/string/print_string.h"
+#include "core/templates/hash_map.h"
+#include "core/variant/variant_internal.h"
 
 #include <limits.h>
 #include <stdio.h>
@@ -114,6 +116,11 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 	const uint8_t *buf = p_buffer;
 	int len = p_len;
 
+	if (p_depth == 0 && is_variant_packed(buf, len)) {
+		// The type byte of this format never reaches PACKED_VARIANT_MAGIC.
+		return decode_variant_packed(r_variant, buf, len, r_len, p_allow_objects);
+	}
+
 	ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
 
 	uint32_t header = decode_uint32(buf);
@@ -2048,6 +2055,917 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 	return OK;
 }
 
+/* Packed format */
+
+// Layout: magic, version, flags, the string table if enabled (a count, then a
+// varint length and UTF-8 bytes per entry), zero padding up to the body
+// alignment, and the root value. Every value starts with a PackedVariantTag.
+// Packed arrays of fixed-size elements store a varint count, zero padding up
+// to their component size (relative to the start of the buffer) and the raw
+// little-endian elements.
+#define PACKED_VARIANT_MAGIC 0xE1
+#define PACKED_VARIANT_VERSION 1
+#define PACKED_VARIANT_BODY_ALIGN 8
+
+enum PackedVariantTag {
+	PACKED_TAG_NIL,
+	PACKED_TAG_FALSE,
+	PACKED_TAG_TRUE,
+	PACKED_TAG_INT,
+	PACKED_TAG_FLOAT32,
+	PACKED_TAG_FLOAT64,
+	PACKED_TAG_STRING,
+	PACKED_TAG_STRING_NAME,
+	PACKED_TAG_STRING_REF,
+	PACKED_TAG_STRING_NAME_REF,
+	PACKED_TAG_ARRAY,
+	PACKED_TAG_DICTIONARY,
+	PACKED_TAG_PACKED_BYTE_ARRAY,
+	PACKED_TAG_PACKED_INT32_ARRAY,
+	PACKED_TAG_PACKED_INT64_ARRAY,
+	PACKED_TAG_PACKED_FLOAT32_ARRAY,
+	PACKED_TAG_PACKED_FLOAT64_ARRAY,
+	PACKED_TAG_PACKED_STRING_ARRAY,
+	PACKED_TAG_PACKED_VECTOR2_ARRAY,
+	PACKED_TAG_PACKED_VECTOR3_ARRAY,
+	PACKED_TAG_PACKED_COLOR_ARRAY,
+	PACKED_TAG_PACKED_VECTOR4_ARRAY,
+	PACKED_TAG_LEGACY, // A varint length followed by the encode_variant() format, for every other type.
+	PACKED_TAG_MAX,
+};
+
+static const Variant::Type packed_tag_types[PACKED_TAG_MAX] = {
+	Variant::NIL,
+	Variant::BOOL,
+	Variant::BOOL,
+	Variant::INT,
+	Variant::FLOAT,
+	Variant::FLOAT,
+	Variant::STRING,
+	Variant::STRING_NAME,
+	Variant::STRING,
+	Variant::STRING_NAME,
+	Variant::ARRAY,
+	Variant::DICTIONARY,
+	Variant::PACKED_BYTE_ARRAY,
+	Variant::PACKED_INT32_ARRAY,
+	Variant::PACKED_INT64_ARRAY,
+	Variant::PACKED_FLOAT32_ARRAY,
+	Variant::PACKED_FLOAT64_ARRAY,
+	Variant::PACKED_STRING_ARRAY,
+	Variant::PACKED_VECTOR2_ARRAY,
+	Variant::PACKED_VECTOR3_ARRAY,
+	Variant::PACKED_COLOR_ARRAY,
+	Variant::PACKED_VECTOR4_ARRAY,
+	Variant::NIL,
+};
+
+// Size of the elements of packed arrays stored raw, and of their components.
+// Vector arrays always use 32-bit components, like Color.
+static bool _packed_get_element_layout(uint8_t p_tag, int &r_size, int &r_component_size) {
+	switch (p_tag) {
+		case PACKED_TAG_PACKED_BYTE_ARRAY: {
+			r_size = 1;
+			r_component_size = 1;
+		} break;
+		case PACKED_TAG_PACKED_INT32_ARRAY:
+		case PACKED_TAG_PACKED_FLOAT32_ARRAY: {
+			r_size = 4;
+			r_component_size = 4;
+		} break;
+		case PACKED_TAG_PACKED_INT64_ARRAY:
+		case PACKED_TAG_PACKED_FLOAT64_ARRAY: {
+			r_size = 8;
+			r_component_size = 8;
+		} break;
+		case PACKED_TAG_PACKED_VECTOR2_ARRAY: {
+			r_size = 8;
+			r_component_size = 4;
+		} break;
+		case PACKED_TAG_PACKED_VECTOR3_ARRAY: {
+			r_size = 12;
+			r_component_size = 4;
+		} break;
+		case PACKED_TAG_PACKED_COLOR_ARRAY:
+		case PACKED_TAG_PACKED_VECTOR4_ARRAY: {
+			r_size = 16;
+			r_component_size = 4;
+		} break;
+		default: {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Whether the raw elements of a packed array have the same layout as the engine type.
+static bool _packed_is_native_layout(uint8_t p_tag) {
+#ifdef REAL_T_IS_DOUBLE
+	if (p_tag == PACKED_TAG_PACKED_VECTOR2_ARRAY || p_tag == PACKED_TAG_PACKED_VECTOR3_ARRAY || p_tag == PACKED_TAG_PACKED_VECTOR4_ARRAY) {
+		return false;
+	}
+#endif
+	return true;
+}
+
+static _FORCE_INLINE_ int _packed_get_padding(int p_pos, int p_align) {
+	return (p_align - p_pos % p_align) % p_align;
+}
+
+static bool _packed_get_varint(const uint8_t *p_buffer, int p_len, int &r_pos, uint64_t &r_value) {
+	uint64_t value = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		if (r_pos >= p_len) {
+			return false;
+		}
+		uint8_t byte = p_buffer[r_pos++];
+		value |= uint64_t(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			r_value = value;
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool _packed_get_count(const uint8_t *p_buffer, int p_len, int &r_pos, int &r_count) {
+	uint64_t count;
+	if (!_packed_get_varint(p_buffer, p_len, r_pos, count) || count > INT32_MAX) {
+		return false;
+	}
+	r_count = count;
+	return true;
+}
+
+static _FORCE_INLINE_ int64_t _packed_unzigzag(uint64_t p_value) {
+	return int64_t(p_value >> 1) ^ -int64_t(p_value & 1);
+}
+
+static _FORCE_INLINE_ uint64_t _packed_zigzag(int64_t p_value) {
+	return (uint64_t(p_value) << 1) ^ uint64_t(p_value >> 63);
+}
+
+static int _packed_write_varint(uint8_t *p_dst, uint64_t p_value) {
+	int size = 0;
+	while (p_value >= 0x80) {
+		p_dst[size++] = uint8_t(p_value) | 0x80;
+		p_value >>= 7;
+	}
+	p_dst[size++] = uint8_t(p_value);
+	return size;
+}
+
+// Copies raw little-endian components, swapping them on big-endian hosts.
+static void _packed_copy_components(const void *p_src, void *p_dst, int p_bytes, int p_component_size) {
+	memcpy(p_dst, p_src, p_bytes);
+#ifdef BIG_ENDIAN_ENABLED
+	uint8_t *dst = (uint8_t *)p_dst;
+	for (int i = 0; i < p_bytes; i += p_component_size) {
+		for (int j = 0; j < p_component_size / 2; j++) {
+			SWAP(dst[i + j], dst[i + p_component_size - 1 - j]);
+		}
+	}
+#endif
+}
+
+class PackedVariantEncoder {
+	LocalVector<uint8_t> body;
+	HashMap<StringName, uint32_t> string_indices;
+	LocalVector<StringName> strings;
+	uint32_t flags = 0;
+	bool full_objects = false;
+
+	void _put_u8(uint8_t p_value) {
+		body.push_back(p_value);
+	}
+
+	void _put_bytes(const void *p_data, int p_size) {
+		uint32_t pos = body.size();
+		body.resize(pos + p_size);
+		memcpy(body.ptr() + pos, p_data, p_size);
+	}
+
+	void _put_varint(uint64_t p_value) {
+		while (p_value >= 0x80) {
+			body.push_back(uint8_t(p_value) | 0x80);
+			p_value >>= 7;
+		}
+		body.push_back(uint8_t(p_value));
+	}
+
+	void _put_utf8(uint8_t p_tag, const String &p_string) {
+		CharString utf8 = p_string.utf8();
+		_put_u8(p_tag);
+		_put_varint(utf8.length());
+		_put_bytes(utf8.get_data(), utf8.length());
+	}
+
+	void _put_string_ref(uint8_t p_tag, const StringName &p_name) {
+		uint32_t *index = string_indices.getptr(p_name);
+		if (!index) {
+			index = &string_indices.insert(p_name, strings.size())->value;
+			strings.push_back(p_name);
+		}
+		_put_u8(p_tag);
+		_put_varint(*index);
+	}
+
+	void _put_raw(uint8_t p_tag, const void *p_data, int p_count) {
+		int element_size = 0;
+		int component_size = 0;
+		_packed_get_element_layout(p_tag, element_size, component_size);
+		_put_u8(p_tag);
+		_put_varint(p_count);
+		// The body starts aligned, so positions in it have the same alignment as in the buffer.
+		body.resize(body.size() + _packed_get_padding(body.size(), component_size));
+		uint32_t pos = body.size();
+		body.resize(pos + p_count * element_size);
+		if (p_count) {
+			_packed_copy_components(p_data, body.ptr() + pos, p_count * element_size, component_size);
+		}
+	}
+
+#ifdef REAL_T_IS_DOUBLE
+	template <typename T>
+	void _put_real_vectors(uint8_t p_tag, const Vector<T> &p_array, int p_components) {
+		LocalVector<float> components;
+		components.resize(p_array.size() * p_components);
+		const real_t *src = (const real_t *)p_array.ptr();
+		for (uint32_t i = 0; i < components.size(); i++) {
+			components[i] = src[i];
+		}
+		_put_raw(p_tag, components.ptr(), p_array.size());
+	}
+#endif
+
+	Error _put_legacy(const Variant &p_variant, int p_depth) {
+		int len = 0;
+		Error err = encode_variant(p_variant, nullptr, len, full_objects, p_depth);
+		ERR_FAIL_COND_V(err != OK, err);
+		_put_u8(PACKED_TAG_LEGACY);
+		_put_varint(len);
+		uint32_t pos = body.size();
+		body.resize(pos + len);
+		return encode_variant(p_variant, body.ptr() + pos, len, full_objects, p_depth);
+	}
+
+public:
+	Error put_value(const Variant &p_variant, bool p_key, int p_depth) {
+		ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
+
+		switch (p_variant.get_type()) {
+			case Variant::NIL: {
+				_put_u8(PACKED_TAG_NIL);
+			} break;
+			case Variant::BOOL: {
+				_put_u8(p_variant.operator bool() ? PACKED_TAG_TRUE : PACKED_TAG_FALSE);
+			} break;
+			case Variant::INT: {
+				int64_t value = p_variant;
+				_put_u8(PACKED_TAG_INT);
+				if (flags & PACKED_VARIANT_VARINT) {
+					_put_varint(_packed_zigzag(value));
+				} else {
+					uint8_t bytes[8];
+					encode_uint64(value, bytes);
+					_put_bytes(bytes, 8);
+				}
+			} break;
+			case Variant::FLOAT: {
+				double value = p_variant;
+				uint8_t bytes[8];
+				if ((double)(float)value == value) {
+					// Exactly representable, halve the size.
+					_put_u8(PACKED_TAG_FLOAT32);
+					encode_float(value, bytes);
+					_put_bytes(bytes, 4);
+				} else {
+					_put_u8(PACKED_TAG_FLOAT64);
+					encode_double(value, bytes);
+					_put_bytes(bytes, 8);
+				}
+			} break;
+			case Variant::STRING: {
+				if (p_key && (flags & PACKED_VARIANT_STRING_TABLE)) {
+					_put_string_ref(PACKED_TAG_STRING_REF, p_variant.operator String());
+				} else {
+					_put_utf8(PACKED_TAG_STRING, p_variant);
+				}
+			} break;
+			case Variant::STRING_NAME: {
+				if (flags & PACKED_VARIANT_STRING_TABLE) {
+					_put_string_ref(PACKED_TAG_STRING_NAME_REF, p_variant);
+				} else {
+					_put_utf8(PACKED_TAG_STRING_NAME, p_variant);
+				}
+			} break;
+			case Variant::ARRAY: {
+				Array array = p_variant;
+				if (array.is_typed()) {
+					return _put_legacy(p_variant, p_depth);
+				}
+				_put_u8(PACKED_TAG_ARRAY);
+				_put_varint(array.size());
+				for (int i = 0; i < array.size(); i++) {
+					Error err = put_value(array[i], false, p_depth + 1);
+					ERR_FAIL_COND_V(err != OK, err);
+				}
+			} break;
+			case Variant::DICTIONARY: {
+				Dictionary dictionary = p_variant;
+				_put_u8(PACKED_TAG_DICTIONARY);
+				_put_varint(dictionary.size());
+				List<Variant> keys;
+				dictionary.get_key_list(&keys);
+				for (const Variant &key : keys) {
+					Error err = put_value(key, true, p_depth + 1);
+					ERR_FAIL_COND_V(err != OK, err);
+					err = put_value(dictionary[key], false, p_depth + 1);
+					ERR_FAIL_COND_V(err != OK, err);
+				}
+			} break;
+			case Variant::PACKED_BYTE_ARRAY: {
+				const PackedByteArray *array = VariantInternal::get_byte_array(&p_variant);
+				_put_raw(PACKED_TAG_PACKED_BYTE_ARRAY, array->ptr(), array->size());
+			} break;
+			case Variant::PACKED_INT32_ARRAY: {
+				const PackedInt32Array *array = VariantInternal::get_int32_array(&p_variant);
+				_put_raw(PACKED_TAG_PACKED_INT32_ARRAY, array->ptr(), array->size());
+			} break;
+			case Variant::PACKED_INT64_ARRAY: {
+				const PackedInt64Array *array = VariantInternal::get_int64_array(&p_variant);
+				_put_raw(PACKED_TAG_PACKED_INT64_ARRAY, array->ptr(), array->size());
+			} break;
+			case Variant::PACKED_FLOAT32_ARRAY: {
+				const PackedFloat32Array *array = VariantInternal::get_float32_array(&p_variant);
+				_put_raw(PACKED_TAG_PACKED_FLOAT32_ARRAY, array->ptr(), array->size());
+			} break;
+			case Variant::PACKED_FLOAT64_ARRAY: {
+				const PackedFloat64Array *array = VariantInternal::get_float64_array(&p_variant);
+				_put_raw(PACKED_TAG_PACKED_FLOAT64_ARRAY, array->ptr(), array->size());
+			} break;
+			case Variant::PACKED_STRING_ARRAY: {
+				const PackedStringArray *array = VariantInternal::get_string_array(&p_variant);
+				_put_u8(PACKED_TAG_PACKED_STRING_ARRAY);
+				_put_varint(array->size());
+				for (const String &string : *array) {
+					CharString utf8 = string.utf8();
+					_put_varint(utf8.length());
+					_put_bytes(utf8.get_data(), utf8.length());
+				}
+			} break;
+			case Variant::PACKED_COLOR_ARRAY: {
+				const PackedColorArray *array = VariantInternal::get_color_array(&p_variant);
+				_put_raw(PACKED_TAG_PACKED_COLOR_ARRAY, array->ptr(), array->size());
+			} break;
+#ifdef REAL_T_IS_DOUBLE
+			case Variant::PACKED_VECTOR2_ARRAY: {
+				_put_real_vectors(PACKED_TAG_PACKED_VECTOR2_ARRAY, *VariantInternal::get_vector2_array(&p_variant), 2);
+			} break;
+			case Variant::PACKED_VECTOR3_ARRAY: {
+				_put_real_vectors(PACKED_TAG_PACKED_VECTOR3_ARRAY, *VariantInternal::get_vector3_array(&p_variant), 3);
+			} break;
+			case Variant::PACKED_VECTOR4_ARRAY: {
+				_put_real_vectors(PACKED_TAG_PACKED_VECTOR4_ARRAY, *VariantInternal::get_vector4_array(&p_variant), 4);
+			} break;
+#else
+			case Variant::PACKED_VECTOR2_ARRAY: {
+				const PackedVector2Array *array = VariantInternal::get_vector2_array(&p_variant);
+				_put_raw(PACKED_TAG_PACKED_VECTOR2_ARRAY, array->ptr(), array->size());
+			} break;
+			case Variant::PACKED_VECTOR3_ARRAY: {
+				const PackedVector3Array *array = VariantInternal::get_vector3_array(&p_variant);
+				_put_raw(PACKED_TAG_PACKED_VECTOR3_ARRAY, array->ptr(), array->size());
+			} break;
+			case Variant::PACKED_VECTOR4_ARRAY: {
+				const PackedVector4Array *array = VariantInternal::get_vector4_array(&p_variant);
+				_put_raw(PACKED_TAG_PACKED_VECTOR4_ARRAY, array->ptr(), array->size());
+			} break;
+#endif
+			default: {
+				return _put_legacy(p_variant, p_depth);
+			}
+		}
+		return OK;
+	}
+
+	void finish(Vector<uint8_t> &r_buffer) const {
+		LocalVector<CharString> table;
+		int size = 3;
+		if (flags & PACKED_VARIANT_STRING_TABLE) {
+			table.resize(strings.size());
+			size += 10;
+			for (uint32_t i = 0; i < strings.size(); i++) {
+				table[i] = String(strings[i]).utf8();
+				size += 10 + table[i].length();
+			}
+		}
+		// Upper bound, the buffer is trimmed below.
+		r_buffer.resize(size + PACKED_VARIANT_BODY_ALIGN + body.size());
+		uint8_t *w = r_buffer.ptrw();
+		int pos = 0;
+		w[pos++] = PACKED_VARIANT_MAGIC;
+		w[pos++] = PACKED_VARIANT_VERSION;
+		w[pos++] = flags;
+		if (flags & PACKED_VARIANT_STRING_TABLE) {
+			pos += _packed_write_varint(w + pos, table.size());
+			for (const CharString &utf8 : table) {
+				pos += _packed_write_varint(w + pos, utf8.length());
+				memcpy(w + pos, utf8.get_data(), utf8.length());
+				pos += utf8.length();
+			}
+		}
+		int padding = _packed_get_padding(pos, PACKED_VARIANT_BODY_ALIGN);
+		memset(w + pos, 0, padding);
+		pos += padding;
+		memcpy(w + pos, body.ptr(), body.size());
+		pos += body.size();
+		r_buffer.resize(pos);
+	}
+
+	PackedVariantEncoder(uint32_t p_flags, bool p_full_objects) :
+			flags(p_flags),
+			full_objects(p_full_objects) {}
+};
+
+Error encode_variant_packed(const Variant &p_variant, Vector<uint8_t> &r_buffer, uint32_t p_flags, bool p_full_objects) {
+	ERR_FAIL_COND_V(p_flags & ~uint32_t(PACKED_VARIANT_DEFAULT), ERR_INVALID_PARAMETER);
+	PackedVariantEncoder encoder(p_flags, p_full_objects);
+	Error err = encoder.put_value(p_variant, false, 0);
+	ERR_FAIL_COND_V(err != OK, err);
+	encoder.finish(r_buffer);
+	return OK;
+}
+
+bool is_variant_packed(const uint8_t *p_buffer, int p_len) {
+	return p_len >= 3 && p_buffer[0] == PACKED_VARIANT_MAGIC;
+}
+
+Error decode_variant_packed(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects) {
+	PackedVariantReader reader;
+	Error err = reader.open(p_buffer, p_len);
+	if (err != OK) {
+		return err;
+	}
+	err = reader.get_root().decode(r_variant, p_allow_objects);
+	if (err != OK) {
+		return err;
+	}
+	if (r_len) {
+		*r_len = reader.get_length();
+	}
+	return OK;
+}
+
+Error PackedVariantReader::open(const uint8_t *p_buffer, int p_len) {
+	buffer = nullptr;
+	length = 0;
+	strings.clear();
+
+	ERR_FAIL_COND_V(p_len < 3 || p_buffer[0] != PACKED_VARIANT_MAGIC, ERR_INVALID_DATA);
+	ERR_FAIL_COND_V_MSG(p_buffer[1] != PACKED_VARIANT_VERSION, ERR_UNAVAILABLE, vformat("Unsupported packed Variant format version %d.", p_buffer[1]));
+	uint32_t header_flags = p_buffer[2];
+	ERR_FAIL_COND_V(header_flags & ~uint32_t(PACKED_VARIANT_DEFAULT), ERR_INVALID_DATA);
+
+	int pos = 3;
+	if (header_flags & PACKED_VARIANT_STRING_TABLE) {
+		int count;
+		ERR_FAIL_COND_V(!_packed_get_count(p_buffer, p_len, pos, count), ERR_INVALID_DATA);
+		// Each entry takes at least one byte, so this also bounds the allocation.
+		ERR_FAIL_COND_V(count > p_len - pos, ERR_INVALID_DATA);
+		strings.resize(count);
+		for (int i = 0; i < count; i++) {
+			int string_length;
+			ERR_FAIL_COND_V(!_packed_get_count(p_buffer, p_len, pos, string_length), ERR_INVALID_DATA);
+			ERR_FAIL_COND_V(string_length > p_len - pos, ERR_INVALID_DATA);
+			strings[i].offset = pos;
+			strings[i].length = string_length;
+			pos += string_length;
+		}
+	}
+	pos += _packed_get_padding(pos, PACKED_VARIANT_BODY_ALIGN);
+	ERR_FAIL_COND_V(pos >= p_len, ERR_INVALID_DATA);
+
+	buffer = p_buffer;
+	length = p_len;
+	flags = header_flags;
+	root = pos;
+	Error err = _skip(pos, 0);
+	if (err != OK) {
+		buffer = nullptr;
+		return err;
+	}
+	length = pos;
+	return OK;
+}
+
+PackedVariantView PackedVariantReader::get_root() const {
+	PackedVariantView view;
+	if (buffer) {
+		view.reader = this;
+		view.offset = root;
+	}
+	return view;
+}
+
+Error PackedVariantReader::_skip(int &r_pos, int p_depth) const {
+	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Variant is too deep. Bailing.");
+	ERR_FAIL_COND_V(r_pos >= length, ERR_INVALID_DATA);
+	uint8_t tag = buffer[r_pos++];
+	switch (tag) {
+		case PACKED_TAG_NIL:
+		case PACKED_TAG_FALSE:
+		case PACKED_TAG_TRUE: {
+		} break;
+		case PACKED_TAG_INT: {
+			if (flags & PACKED_VARIANT_VARINT) {
+				uint64_t value;
+				ERR_FAIL_COND_V(!_packed_get_varint(buffer, length, r_pos, value), ERR_INVALID_DATA);
+			} else {
+				ERR_FAIL_COND_V(length - r_pos < 8, ERR_INVALID_DATA);
+				r_pos += 8;
+			}
+		} break;
+		case PACKED_TAG_FLOAT32: {
+			ERR_FAIL_COND_V(length - r_pos < 4, ERR_INVALID_DATA);
+			r_pos += 4;
+		} break;
+		case PACKED_TAG_FLOAT64: {
+			ERR_FAIL_COND_V(length - r_pos < 8, ERR_INVALID_DATA);
+			r_pos += 8;
+		} break;
+		case PACKED_TAG_STRING:
+		case PACKED_TAG_STRING_NAME: {
+			int string_length;
+			ERR_FAIL_COND_V(!_packed_get_count(buffer, length, r_pos, string_length), ERR_INVALID_DATA);
+			ERR_FAIL_COND_V(string_length > length - r_pos, ERR_INVALID_DATA);
+			r_pos += string_length;
+		} break;
+		case PACKED_TAG_STRING_REF:
+		case PACKED_TAG_STRING_NAME_REF: {
+			int index;
+			ERR_FAIL_COND_V(!_packed_get_count(buffer, length, r_pos, index), ERR_INVALID_DATA);
+			ERR_FAIL_COND_V(index >= (int)strings.size(), ERR_INVALID_DATA);
+		} break;
+		case PACKED_TAG_ARRAY:
+		case PACKED_TAG_DICTIONARY: {
+			int count;
+			ERR_FAIL_COND_V(!_packed_get_count(buffer, length, r_pos, count), ERR_INVALID_DATA);
+			if (tag == PACKED_TAG_DICTIONARY) {
+				ERR_FAIL_COND_V(count > (length - r_pos) / 2, ERR_INVALID_DATA);
+				count *= 2;
+			}
+			for (int i = 0; i < count; i++) {
+				Error err = _skip(r_pos, p_depth + 1);
+				if (err != OK) {
+					return err;
+				}
+			}
+		} break;
+		case PACKED_TAG_PACKED_STRING_ARRAY: {
+			int count;
+			ERR_FAIL_COND_V(!_packed_get_count(buffer, length, r_pos, count), ERR_INVALID_DATA);
+			for (int i = 0; i < count; i++) {
+				int string_length;
+				ERR_FAIL_COND_V(!_packed_get_count(buffer, length, r_pos, string_length), ERR_INVALID_DATA);
+				ERR_FAIL_COND_V(string_length > length - r_pos, ERR_INVALID_DATA);
+				r_pos += string_length;
+			}
+		} break;
+		case PACKED_TAG_LEGACY: {
+			int legacy_length;
+			ERR_FAIL_COND_V(!_packed_get_count(buffer, length, r_pos, legacy_length), ERR_INVALID_DATA);
+			ERR_FAIL_COND_V(legacy_length < 4 || legacy_length > length - r_pos, ERR_INVALID_DATA);
+			ERR_FAIL_COND_V(buffer[r_pos] >= Variant::VARIANT_MAX, ERR_INVALID_DATA);
+			r_pos += legacy_length;
+		} break;
+		default: {
+			int element_size;
+			int component_size;
+			ERR_FAIL_COND_V(!_packed_get_element_layout(tag, element_size, component_size), ERR_INVALID_DATA);
+			int count;
+			ERR_FAIL_COND_V(!_packed_get_count(buffer, length, r_pos, count), ERR_INVALID_DATA);
+			r_pos += _packed_get_padding(r_pos, component_size);
+			ERR_FAIL_COND_V(r_pos > length || count > (length - r_pos) / element_size, ERR_INVALID_DATA);
+			r_pos += count * element_size;
+		}
+	}
+	return OK;
+}
+
+template <typename T>
+static void _packed_decode_raw(const uint8_t *p_data, int p_count, int p_component_size, Variant &r_variant) {
+	Vector<T> array;
+	array.resize(p_count);
+	if (p_count) {
+		_packed_copy_components(p_data, array.ptrw(), p_count * sizeof(T), p_component_size);
+	}
+	r_variant = std::move(array);
+}
+
+#ifdef REAL_T_IS_DOUBLE
+template <typename T>
+static void _packed_decode_real_vectors(const uint8_t *p_data, int p_count, int p_components, Variant &r_variant) {
+	Vector<T> array;
+	array.resize(p_count);
+	real_t *w = (real_t *)array.ptrw();
+	for (int i = 0; i < p_count * p_components; i++) {
+		w[i] = decode_float(p_data + i * 4);
+	}
+	r_variant = std::move(array);
+}
+#endif
+
+Error PackedVariantReader::_decode(int &r_pos, Variant &r_variant, bool p_allow_objects, int p_depth, LocalVector<StringName> &r_names) const {
+	// The structure was validated by open(), only the contents are checked here.
+	uint8_t tag = buffer[r_pos++];
+	switch (tag) {
+		case PACKED_TAG_NIL: {
+			r_variant = Variant();
+		} break;
+		case PACKED_TAG_FALSE:
+		case PACKED_TAG_TRUE: {
+			r_variant = tag == PACKED_TAG_TRUE;
+		} break;
+		case PACKED_TAG_INT: {
+			if (flags & PACKED_VARIANT_VARINT) {
+				uint64_t value;
+				_packed_get_varint(buffer, length, r_pos, value);
+				r_variant = _packed_unzigzag(value);
+			} else {
+				r_variant = (int64_t)decode_uint64(buffer + r_pos);
+				r_pos += 8;
+			}
+		} break;
+		case PACKED_TAG_FLOAT32: {
+			r_variant = decode_float(buffer + r_pos);
+			r_pos += 4;
+		} break;
+		case PACKED_TAG_FLOAT64: {
+			r_variant = decode_double(buffer + r_pos);
+			r_pos += 8;
+		} break;
+		case PACKED_TAG_STRING:
+		case PACKED_TAG_STRING_NAME: {
+			int string_length;
+			_packed_get_count(buffer, length, r_pos, string_length);
+			String string;
+			ERR_FAIL_COND_V(string.parse_utf8((const char *)buffer + r_pos, string_length) != OK, ERR_INVALID_DATA);
+			r_pos += string_length;
+			if (tag == PACKED_TAG_STRING_NAME) {
+				r_variant = StringName(string);
+			} else {
+				r_variant = std::move(string);
+			}
+		} break;
+		case PACKED_TAG_STRING_REF:
+		case PACKED_TAG_STRING_NAME_REF: {
+			int index;
+			_packed_get_count(buffer, length, r_pos, index);
+			if (r_names[index] == StringName() && strings[index].length) {
+				String string;
+				ERR_FAIL_COND_V(string.parse_utf8((const char *)buffer + strings[index].offset, strings[index].length) != OK, ERR_INVALID_DATA);
+				r_names[index] = string;
+			}
+			if (tag == PACKED_TAG_STRING_NAME_REF) {
+				r_variant = r_names[index];
+			} else {
+				r_variant = String(r_names[index]);
+			}
+		} break;
+		case PACKED_TAG_ARRAY: {
+			int count;
+			_packed_get_count(buffer, length, r_pos, count);
+			Array array;
+			array.resize(count);
+			for (int i = 0; i < count; i++) {
+				Error err = _decode(r_pos, array[i], p_allow_objects, p_depth + 1, r_names);
+				if (err != OK) {
+					return err;
+				}
+			}
+			r_variant = std::move(array);
+		} break;
+		case PACKED_TAG_DICTIONARY: {
+			int count;
+			_packed_get_count(buffer, length, r_pos, count);
+			Dictionary dictionary;
+			for (int i = 0; i < count; i++) {
+				Variant key;
+				Error err = _decode(r_pos, key, p_allow_objects, p_depth + 1, r_names);
+				if (err != OK) {
+					return err;
+				}
+				err = _decode(r_pos, dictionary[key], p_allow_objects, p_depth + 1, r_names);
+				if (err != OK) {
+					return err;
+				}
+			}
+			r_variant = std::move(dictionary);
+		} break;
+		case PACKED_TAG_PACKED_STRING_ARRAY: {
+			int count;
+			_packed_get_count(buffer, length, r_pos, count);
+			PackedStringArray array;
+			array.resize(count);
+			String *w = array.ptrw();
+			for (int i = 0; i < count; i++) {
+				int string_length;
+				_packed_get_count(buffer, length, r_pos, string_length);
+				ERR_FAIL_COND_V(w[i].parse_utf8((const char *)buffer + r_pos, string_length) != OK, ERR_INVALID_DATA);
+				r_pos += string_length;
+			}
+			r_variant = std::move(array);
+		} break;
+		case PACKED_TAG_LEGACY: {
+			int legacy_length;
+			_packed_get_count(buffer, length, r_pos, legacy_length);
+			Error err = decode_variant(r_variant, buffer + r_pos, legacy_length, nullptr, p_allow_objects, p_depth);
+			if (err != OK) {
+				return err;
+			}
+			r_pos += legacy_length;
+		} break;
+		default: {
+			int element_size;
+			int component_size;
+			_packed_get_element_layout(tag, element_size, component_size);
+			int count;
+			_packed_get_count(buffer, length, r_pos, count);
+			r_pos += _packed_get_padding(r_pos, component_size);
+			const uint8_t *data = buffer + r_pos;
+			r_pos += count * element_size;
+			switch (tag) {
+				case PACKED_TAG_PACKED_BYTE_ARRAY: {
+					_packed_decode_raw<uint8_t>(data, count, component_size, r_variant);
+				} break;
+				case PACKED_TAG_PACKED_INT32_ARRAY: {
+					_packed_decode_raw<int32_t>(data, count, component_size, r_variant);
+				} break;
+				case PACKED_TAG_PACKED_INT64_ARRAY: {
+					_packed_decode_raw<int64_t>(data, count, component_size, r_variant);
+				} break;
+				case PACKED_TAG_PACKED_FLOAT32_ARRAY: {
+					_packed_decode_raw<float>(data, count, component_size, r_variant);
+				} break;
+				case PACKED_TAG_PACKED_FLOAT64_ARRAY: {
+					_packed_decode_raw<double>(data, count, component_size, r_variant);
+				} break;
+				case PACKED_TAG_PACKED_COLOR_ARRAY: {
+					_packed_decode_raw<Color>(data, count, component_size, r_variant);
+				} break;
+#ifdef REAL_T_IS_DOUBLE
+				case PACKED_TAG_PACKED_VECTOR2_ARRAY: {
+					_packed_decode_real_vectors<Vector2>(data, count, 2, r_variant);
+				} break;
+				case PACKED_TAG_PACKED_VECTOR3_ARRAY: {
+					_packed_decode_real_vectors<Vector3>(data, count, 3, r_variant);
+				} break;
+				case PACKED_TAG_PACKED_VECTOR4_ARRAY: {
+					_packed_decode_real_vectors<Vector4>(data, count, 4, r_variant);
+				} break;
+#else
+				case PACKED_TAG_PACKED_VECTOR2_ARRAY: {
+					_packed_decode_raw<Vector2>(data, count, component_size, r_variant);
+				} break;
+				case PACKED_TAG_PACKED_VECTOR3_ARRAY: {
+					_packed_decode_raw<Vector3>(data, count, component_size, r_variant);
+				} break;
+				case PACKED_TAG_PACKED_VECTOR4_ARRAY: {
+					_packed_decode_raw<Vector4>(data, count, component_size, r_variant);
+				} break;
+#endif
+			}
+		}
+	}
+	return OK;
+}
+
+Variant::Type PackedVariantView::get_type() const {
+	ERR_FAIL_NULL_V(reader, Variant::NIL);
+	uint8_t tag = reader->buffer[offset];
+	if (tag == PACKED_TAG_LEGACY) {
+		int pos = offset + 1;
+		int legacy_length;
+		_packed_get_count(reader->buffer, reader->length, pos, legacy_length);
+		return Variant::Type(reader->buffer[pos]);
+	}
+	return packed_tag_types[tag];
+}
+
+bool PackedVariantView::get_bool() const {
+	ERR_FAIL_NULL_V(reader, false);
+	return reader->buffer[offset] == PACKED_TAG_TRUE;
+}
+
+int64_t PackedVariantView::get_int() const {
+	ERR_FAIL_NULL_V(reader, 0);
+	ERR_FAIL_COND_V(reader->buffer[offset] != PACKED_TAG_INT, 0);
+	int pos = offset + 1;
+	if (reader->flags & PACKED_VARIANT_VARINT) {
+		uint64_t value;
+		_packed_get_varint(reader->buffer, reader->length, pos, value);
+		return _packed_unzigzag(value);
+	}
+	return decode_uint64(reader->buffer + pos);
+}
+
+double PackedVariantView::get_float() const {
+	ERR_FAIL_NULL_V(reader, 0);
+	uint8_t tag = reader->buffer[offset];
+	if (tag == PACKED_TAG_FLOAT32) {
+		return decode_float(reader->buffer + offset + 1);
+	}
+	ERR_FAIL_COND_V(tag != PACKED_TAG_FLOAT64, 0);
+	return decode_double(reader->buffer + offset + 1);
+}
+
+Error PackedVariantView::get_utf8(const char *&r_utf8, int &r_length) const {
+	ERR_FAIL_NULL_V(reader, ERR_UNCONFIGURED);
+	uint8_t tag = reader->buffer[offset];
+	int pos = offset + 1;
+	switch (tag) {
+		case PACKED_TAG_STRING:
+		case PACKED_TAG_STRING_NAME: {
+			_packed_get_count(reader->buffer, reader->length, pos, r_length);
+			r_utf8 = (const char *)reader->buffer + pos;
+		} break;
+		case PACKED_TAG_STRING_REF:
+		case PACKED_TAG_STRING_NAME_REF: {
+			int index;
+			_packed_get_count(reader->buffer, reader->length, pos, index);
+			r_utf8 = (const char *)reader->buffer + reader->strings[index].offset;
+			r_length = reader->strings[index].length;
+		} break;
+		default: {
+			ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "The value is not a String or StringName.");
+		}
+	}
+	return OK;
+}
+
+Error PackedVariantView::get_packed_data(const void *&r_data, int &r_count) const {
+	ERR_FAIL_NULL_V(reader, ERR_UNCONFIGURED);
+	uint8_t tag = reader->buffer[offset];
+	int element_size;
+	int component_size;
+	ERR_FAIL_COND_V_MSG(!_packed_get_element_layout(tag, element_size, component_size), ERR_INVALID_PARAMETER, "The value is not a packed array of fixed-size elements.");
+	int pos = offset + 1;
+	_packed_get_count(reader->buffer, reader->length, pos, r_count);
+	pos += _packed_get_padding(pos, component_size);
+	r_data = reader->buffer + pos;
+#ifdef BIG_ENDIAN_ENABLED
+	return ERR_UNAVAILABLE;
+#else
+	if (!_packed_is_native_layout(tag) || (uintptr_t(r_data) % component_size) != 0) {
+		return ERR_UNAVAILABLE;
+	}
+	return OK;
+#endif
+}
+
+int PackedVariantView::get_size() const {
+	ERR_FAIL_NULL_V(reader, 0);
+	uint8_t tag = reader->buffer[offset];
+	int element_size;
+	int component_size;
+	if (tag != PACKED_TAG_ARRAY && tag != PACKED_TAG_DICTIONARY && tag != PACKED_TAG_PACKED_STRING_ARRAY && !_packed_get_element_layout(tag, element_size, component_size)) {
+		return 0;
+	}
+	int pos = offset + 1;
+	int count = 0;
+	_packed_get_count(reader->buffer, reader->length, pos, count);
+	return count;
+}
+
+Error PackedVariantView::get_elements(LocalVector<PackedVariantView> &r_elements) const {
+	ERR_FAIL_NULL_V(reader, ERR_UNCONFIGURED);
+	uint8_t tag = reader->buffer[offset];
+	ERR_FAIL_COND_V_MSG(tag != PACKED_TAG_ARRAY && tag != PACKED_TAG_DICTIONARY, ERR_INVALID_PARAMETER, "The value is not an Array or Dictionary.");
+	int pos = offset + 1;
+	int count;
+	_packed_get_count(reader->buffer, reader->length, pos, count);
+	if (tag == PACKED_TAG_DICTIONARY) {
+		count *= 2;
+	}
+	r_elements.resize(count);
+	for (int i = 0; i < count; i++) {
+		r_elements[i].reader = reader;
+		r_elements[i].offset = pos;
+		Error err = reader->_skip(pos, 0);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+	return OK;
+}
+
+Error PackedVariantView::decode(Variant &r_variant, bool p_allow_objects) const {
+	ERR_FAIL_NULL_V(reader, ERR_UNCONFIGURED);
+	LocalVector<StringName> names;
+	names.resize(reader->strings.size());
+	int pos = offset;
+	return reader->_decode(pos, r_variant, p_allow_objects, 0, names);
+}
+
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count) {
 	// We always allocate a new array, and we don't memcpy.
 	// We also don't consider returning a pointer to the passed vectors when sizeof(real_t) == 4.
@@ -33,6 +33,7 @@
 
 #include "core/math/math_defs.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 #include "core/variant/variant.h"
 
@@ -215,6 +216,77 @@ public:
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false, int p_depth = 0);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0);
 
+// Compact, versioned alternative to the format above. Lengths are stored as
+// varints and packed arrays of fixed-size elements are stored raw and aligned,
+// so PackedVariantReader can hand them out as views into the source buffer.
+// decode_variant() recognizes this format and decodes it transparently.
+enum PackedVariantFlags {
+	PACKED_VARIANT_VARINT = 1 << 0, // Integers are stored as zigzag varints.
+	PACKED_VARIANT_STRING_TABLE = 1 << 1, // StringNames and dictionary keys are stored once and referenced by index.
+	PACKED_VARIANT_DEFAULT = PACKED_VARIANT_VARINT | PACKED_VARIANT_STRING_TABLE,
+};
+
+Error encode_variant_packed(const Variant &p_variant, Vector<uint8_t> &r_buffer, uint32_t p_flags = PACKED_VARIANT_DEFAULT, bool p_full_objects = false);
+Error decode_variant_packed(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false);
+bool is_variant_packed(const uint8_t *p_buffer, int p_len);
+
+class PackedVariantReader;
+
+// A value inside a buffer opened by PackedVariantReader. Views are only valid
+// while the reader and its source buffer are alive.
+class PackedVariantView {
+	friend class PackedVariantReader;
+
+	const PackedVariantReader *reader = nullptr;
+	int offset = 0;
+
+public:
+	bool is_valid() const { return reader != nullptr; }
+	Variant::Type get_type() const;
+
+	bool get_bool() const;
+	int64_t get_int() const;
+	double get_float() const;
+	// STRING and STRING_NAME values, as UTF-8 pointing into the source buffer (not null-terminated).
+	Error get_utf8(const char *&r_utf8, int &r_length) const;
+	// Packed arrays of fixed-size elements, pointing into the source buffer. Fails with
+	// ERR_UNAVAILABLE if the buffer is misaligned or the element layout differs from this build.
+	Error get_packed_data(const void *&r_data, int &r_count) const;
+	// Number of elements of arrays and packed arrays, or of pairs of dictionaries.
+	int get_size() const;
+	// Elements of an array, or keys and values interleaved for a dictionary.
+	Error get_elements(LocalVector<PackedVariantView> &r_elements) const;
+
+	Error decode(Variant &r_variant, bool p_allow_objects = false) const;
+};
+
+class PackedVariantReader {
+	friend class PackedVariantView;
+
+	struct StringEntry {
+		int offset = 0;
+		int length = 0;
+	};
+
+	const uint8_t *buffer = nullptr;
+	int length = 0;
+	uint32_t flags = 0;
+	int root = 0;
+	LocalVector<StringEntry> strings;
+
+	Error _skip(int &r_pos, int p_depth) const;
+	// `r_names` caches the string table entries interned so far by this decode.
+	Error _decode(int &r_pos, Variant &r_variant, bool p_allow_objects, int p_depth, LocalVector<StringName> &r_names) const;
+
+public:
+	// Validates the whole buffer, so views and decoding can trust its structure.
+	Error open(const uint8_t *p_buffer, int p_len);
+	// Bytes taken by the encoded value, which may be less than the buffer given to open().
+	int get_length() const { return length; }
+	uint32_t get_flags() const { return flags; }
+	PackedVariantView get_root() const;
+};
+
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count);
 
 #endif // MARSHALLS_H
@@ -33,10 +33,12 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/image.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
 //#define print_bl(m_what) print_line(m_what)
@@ -157,19 +159,37 @@ StringName ResourceLoaderBinary::_get_string() {
 	uint32_t id = f->get_32();
 	if (id & 0x80000000) {
 		uint32_t len = id & 0x7FFFFFFF;
-		if ((int)len > str_buf.size()) {
-			str_buf.resize(len);
-		}
 		if (len == 0) {
 			return StringName();
 		}
-		f->get_buffer((uint8_t *)&str_buf[0], len);
+		return _read_utf8_string(len);
+	}
+
+	return string_map[id];
+}
+
+String ResourceLoaderBinary::_read_utf8_string(uint32_t p_len) {
+	// Parse in place when the file is memory-mapped, saving the copy into str_buf.
+	const char *mapped = (const char *)f->get_buffer_ptr(p_len);
+	if (mapped) {
+		// Stored length includes the null terminator.
+		int len = p_len;
+		while (len > 0 && mapped[len - 1] == 0) {
+			len--;
+		}
 		String s;
-		s.parse_utf8(&str_buf[0]);
+		s.parse_utf8(mapped, len);
 		return s;
 	}
 
-	return string_map[id];
+	if ((int)p_len > str_buf.size()) {
+		str_buf.resize(p_len);
+	}
+	char *buf = str_buf.ptrw();
+	f->get_buffer((uint8_t *)buf, p_len);
+	String s;
+	s.parse_utf8(buf);
+	return s;
 }
 
 Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
@@ -448,21 +468,15 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
 					} else {
-						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
-						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
-							Error err;
-							Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
-							if (res.is_null()) {
-								if (!ResourceLoader::is_cleaning_tasks()) {
-									if (!ResourceLoader::get_abort_on_missing_resources()) {
-										ResourceLoader::notify_dependency_error(local_path, external_resources[erindex].path, external_resources[erindex].type);
-									} else {
-										error = ERR_FILE_MISSING_DEPENDENCIES;
-										ERR_FAIL_V_MSG(error, "Can't load dependency: " + external_resources[erindex].path + ".");
-									}
+						if (external_resources[erindex].load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
+							if (!external_resources[erindex].completed) {
+								Error err = _complete_external_resource(erindex);
+								if (err != OK) {
+									return err;
 								}
-							} else {
-								r_v = res;
+							}
+							if (external_resources[erindex].resource.is_valid()) {
+								r_v = external_resources[erindex].resource;
 							}
 						}
 					}
@@ -709,172 +723,323 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
+	if (use_sub_threads && using_named_scene_ids && internal_resources.size() > 2 && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+		return _load_threaded();
+	}
+
 	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
+		Ref<Resource> res;
+		MissingResource *missing_resource = nullptr;
+		error = _instantiate_internal_resource(i, res, missing_resource);
+		if (error != OK) {
+			return error;
+		}
+		if (res.is_null()) {
+			continue; // Already loaded.
+		}
 
-		//maybe it is loaded already
-		String path;
-		String id;
+		int pc = f->get_32();
 
-		if (!main) {
-			path = internal_resources[i].path;
+		//set properties
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+		Dictionary missing_resource_properties;
 
-				internal_resources.write[i].path = path; // Update path.
+		for (int j = 0; j < pc; j++) {
+			StringName name = _get_string();
+
+			if (name == StringName()) {
+				error = ERR_FILE_CORRUPT;
+				ERR_FAIL_V(ERR_FILE_CORRUPT);
 			}
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
-				}
+			Variant value;
+
+			error = parse_variant(value);
+			if (error) {
+				return error;
 			}
+
+			_set_resource_property(res, missing_resource, name, value, missing_resource_properties);
+		}
+
+		if (_finish_internal_resource(i, res, missing_resource, missing_resource_properties)) {
+			return OK;
+		}
+	}
+
+	return ERR_FILE_EOF;
+}
+
+Error ResourceLoaderBinary::_complete_external_resource(int p_index) {
+	ExtResource &er = external_resources.write[p_index];
+	er.completed = true;
+
+	Error err;
+	er.resource = ResourceLoader::_load_complete(*er.load_token.ptr(), &err);
+	if (er.resource.is_null() && !ResourceLoader::is_cleaning_tasks()) {
+		if (!ResourceLoader::get_abort_on_missing_resources()) {
+			ResourceLoader::notify_dependency_error(local_path, er.path, er.type);
 		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
-			}
+			error = ERR_FILE_MISSING_DEPENDENCIES;
+			ERR_FAIL_V_MSG(error, "Can't load dependency: " + er.path + ".");
 		}
+	}
+	return OK;
+}
 
-		uint64_t offset = internal_resources[i].offset;
+// Creates internal resource `p_index` and leaves the file at its property count.
+// `r_res` is left null if the resource is already loaded and must be skipped.
+Error ResourceLoaderBinary::_instantiate_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource) {
+	bool main = p_index == (internal_resources.size() - 1);
 
-		f->seek(offset);
+	//maybe it is loaded already
+	String path;
+	String id;
 
-		String t = get_unicode_string();
+	if (!main) {
+		path = internal_resources[p_index].path;
 
-		Ref<Resource> res;
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
+
+			internal_resources.write[p_index].path = path; // Update path.
+		}
 
-		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-			//use the existing one
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
 			Ref<Resource> cached = ResourceCache::get_ref(path);
-			if (cached->get_class() == t) {
-				cached->reset_state();
-				res = cached;
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				internal_index_cache[path] = cached;
+				return OK;
 			}
 		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
+	}
 
-		MissingResource *missing_resource = nullptr;
+	uint64_t offset = internal_resources[p_index].offset;
 
-		if (res.is_null()) {
-			//did not replace
-
-			Object *obj = ClassDB::instantiate(t);
-			if (!obj) {
-				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-					//create a missing resource
-					missing_resource = memnew(MissingResource);
-					missing_resource->set_original_class(t);
-					missing_resource->set_recording_properties(true);
-					obj = missing_resource;
-				} else {
-					error = ERR_FILE_CORRUPT;
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
-				}
-			}
+	f->seek(offset);
 
-			Resource *r = Object::cast_to<Resource>(obj);
-			if (!r) {
-				String obj_class = obj->get_class();
+	String t = get_unicode_string();
+
+	Ref<Resource> res;
+
+	if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+		//use the existing one
+		Ref<Resource> cached = ResourceCache::get_ref(path);
+		if (cached->get_class() == t) {
+			cached->reset_state();
+			res = cached;
+		}
+	}
+
+	MissingResource *missing_resource = nullptr;
+
+	if (res.is_null()) {
+		//did not replace
+
+		Object *obj = ClassDB::instantiate(t);
+		if (!obj) {
+			if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+				//create a missing resource
+				missing_resource = memnew(MissingResource);
+				missing_resource->set_original_class(t);
+				missing_resource->set_recording_properties(true);
+				obj = missing_resource;
+			} else {
 				error = ERR_FILE_CORRUPT;
-				memdelete(obj); //bye
-				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
 			}
+		}
 
-			res = Ref<Resource>(r);
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
-				} else {
-					r->set_path_cache(path);
-				}
-			}
-			r->set_scene_unique_id(id);
+		Resource *r = Object::cast_to<Resource>(obj);
+		if (!r) {
+			String obj_class = obj->get_class();
+			error = ERR_FILE_CORRUPT;
+			memdelete(obj); //bye
+			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
 		}
 
-		if (!main) {
-			internal_index_cache[path] = res;
+		res = Ref<Resource>(r);
+		if (!path.is_empty()) {
+			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+			} else {
+				r->set_path_cache(path);
+			}
 		}
+		r->set_scene_unique_id(id);
+	}
 
-		int pc = f->get_32();
+	if (!main) {
+		internal_index_cache[path] = res;
+	}
 
-		//set properties
+	r_res = res;
+	r_missing_resource = missing_resource;
+	return OK;
+}
 
-		Dictionary missing_resource_properties;
+void ResourceLoaderBinary::_set_resource_property(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const StringName &p_name, Variant &p_value, Dictionary &r_missing_resource_properties) {
+	if (p_value.get_type() == Variant::OBJECT && p_missing_resource != nullptr) {
+		// If the property being set is a missing resource (and the parent is not),
+		// then setting it will most likely not work.
+		// Instead, save it as metadata.
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+		Ref<MissingResource> mr = p_value;
+		if (mr.is_valid()) {
+			r_missing_resource_properties[p_name] = mr;
+			return;
+		}
+	}
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
+	if (p_value.get_type() == Variant::ARRAY) {
+		Array set_array = p_value;
+		bool is_get_valid = false;
+		Variant get_value = p_res->get(p_name, &is_get_valid);
+		if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+			Array get_array = get_value;
+			if (!set_array.is_same_typed(get_array)) {
+				p_value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
 			}
+		}
+	}
 
-			Variant value;
+	p_res->set(p_name, p_value);
+}
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
-			}
+// Returns true once the main resource is done.
+bool ResourceLoaderBinary::_finish_internal_resource(int p_index, const Ref<Resource> &p_res, MissingResource *p_missing_resource, const Dictionary &p_missing_resource_properties) {
+	if (p_missing_resource) {
+		p_missing_resource->set_recording_properties(false);
+	}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+	if (!p_missing_resource_properties.is_empty()) {
+		p_res->set_meta(META_MISSING_RESOURCES, p_missing_resource_properties);
+	}
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
+#ifdef TOOLS_ENABLED
+	p_res->set_edited(false);
+#endif
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
-				}
-			}
+	if (progress) {
+		*progress = (p_index + 1) / float(internal_resources.size());
+	}
+
+	resource_cache.push_back(p_res);
+
+	if (p_index == internal_resources.size() - 1) {
+		f.unref();
+		resource = p_res;
+		resource->set_as_translation_remapped(translation_remapped);
+		error = OK;
+		return true;
+	}
+	return false;
+}
+
+void ResourceLoaderBinary::_parse_resources_threaded(uint32_t p_task, ThreadedParseData *p_data) {
+	// Each task parses with its own copy of the loader, reading the tables filled by load() and its own file cursor.
+	ResourceLoaderBinary loader = *this;
+	loader.str_buf = Vector<char>(); // Shared with this loader until written, never write to it from several tasks.
+	Ref<FileAccessMemory> file;
+	file.instantiate();
+	file->open_custom(p_data->data, p_data->length);
+	file->set_big_endian(f->is_big_endian());
+	file->real_is_double = f->real_is_double;
+	loader.f = file;
+
+	while (true) {
+		uint32_t index = p_data->next_resource.postincrement();
+		if (index >= p_data->resources.size()) {
+			break;
+		}
+		ParsedResource &parsed = p_data->resources[index];
+		if (parsed.resource.is_null()) {
+			continue;
+		}
 
-			if (set_valid) {
-				res->set(name, value);
+		file->seek(parsed.properties_offset);
+		uint32_t pc = file->get_32();
+		for (uint32_t j = 0; j < pc; j++) {
+			StringName name = loader._get_string();
+			if (name == StringName()) {
+				parsed.error = ERR_FILE_CORRUPT;
+				break;
 			}
+			Variant value;
+			parsed.error = loader.parse_variant(value);
+			if (parsed.error != OK) {
+				break;
+			}
+			parsed.properties.push_back(Pair<StringName, Variant>(name, value));
 		}
+	}
+}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+// Creates all internal resources on this thread, parses their properties in parallel,
+// then sets the properties in file order. Internal references resolve to the created
+// resources, whose properties are only set at the end, as when loading sequentially.
+Error ResourceLoaderBinary::_load_threaded() {
+	// Complete external resources up front, so workers only read them.
+	for (int i = 0; i < external_resources.size(); i++) {
+		if (external_resources[i].load_token.is_valid()) {
+			Error err = _complete_external_resource(i);
+			if (err != OK) {
+				return err;
+			}
 		}
+	}
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	ThreadedParseData data;
+	data.resources.resize(internal_resources.size());
+	for (int i = 0; i < internal_resources.size(); i++) {
+		ParsedResource &parsed = data.resources[i];
+		error = _instantiate_internal_resource(i, parsed.resource, parsed.missing_resource);
+		if (error != OK) {
+			return error;
+		}
+		if (parsed.resource.is_valid()) {
+			parsed.properties_offset = f->get_position();
 		}
+	}
 
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
+	// Workers read from memory. Mapped files are used in place, others are read once.
+	Vector<uint8_t> file_data;
+	data.length = f->get_length();
+	f->seek(0);
+	data.data = f->get_buffer_ptr(data.length);
+	if (!data.data) {
+		file_data = f->get_buffer(data.length);
+		ERR_FAIL_COND_V((uint64_t)file_data.size() != data.length, ERR_FILE_CORRUPT);
+		data.data = file_data.ptr();
+	}
 
-		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
+	int tasks = MIN(WorkerThreadPool::get_singleton()->get_thread_count(), internal_resources.size());
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ResourceLoaderBinary::_parse_resources_threaded, &data, tasks, -1, true, SNAME("ResourceLoaderBinary"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (int i = 0; i < internal_resources.size(); i++) {
+		ParsedResource &parsed = data.resources[i];
+		if (parsed.resource.is_null()) {
+			continue; // Already loaded.
+		}
+		if (parsed.error != OK) {
+			error = parsed.error;
+			ERR_FAIL_V_MSG(error, local_path + ": Can't parse the properties of resource " + itos(i) + ".");
 		}
 
-		resource_cache.push_back(res);
+		Dictionary missing_resource_properties;
+		for (Pair<StringName, Variant> &property : parsed.properties) {
+			_set_resource_property(parsed.resource, parsed.missing_resource, property.first, property.second, missing_resource_properties);
+		}
 
-		if (main) {
-			f.unref();
-			resource = res;
-			resource->set_as_translation_remapped(translation_remapped);
-			error = OK;
+		if (_finish_internal_resource(i, parsed.resource, parsed.missing_resource, missing_resource_properties)) {
 			return OK;
 		}
 	}
@@ -904,16 +1069,10 @@ static String get_ustring(Ref<FileAccess> f) {
 
 String ResourceLoaderBinary::get_unicode_string() {
 	int len = f->get_32();
-	if (len > str_buf.size()) {
-		str_buf.resize(len);
-	}
-	if (len == 0) {
+	if (len <= 0) {
 		return String();
 	}
-	f->get_buffer((uint8_t *)&str_buf[0], len);
-	String s;
-	s.parse_utf8(&str_buf[0]);
-	return s;
+	return _read_utf8_string(len);
 }
 
 void ResourceLoaderBinary::get_classes_used(Ref<FileAccess> p_f, HashSet<StringName> *p_classes) {
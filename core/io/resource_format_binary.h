@@ -34,6 +34,11 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
+
+class MissingResource;
 
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
@@ -55,12 +60,15 @@ class ResourceLoaderBinary {
 	Vector<StringName> string_map;
 
 	StringName _get_string();
+	String _read_utf8_string(uint32_t p_len);
 
 	struct ExtResource {
 		String path;
 		String type;
 		ResourceUID::ID uid = ResourceUID::INVALID_ID;
 		Ref<ResourceLoader::LoadToken> load_token;
+		Ref<Resource> resource; // Set once the load through `load_token` completed.
+		bool completed = false;
 	};
 
 	bool using_named_scene_ids = false;
@@ -91,6 +99,29 @@ class ResourceLoaderBinary {
 
 	Error parse_variant(Variant &r_v);
 
+	// Internal resource whose properties are parsed on a worker thread, see _load_threaded().
+	struct ParsedResource {
+		Ref<Resource> resource;
+		MissingResource *missing_resource = nullptr;
+		uint64_t properties_offset = 0;
+		LocalVector<Pair<StringName, Variant>> properties;
+		Error error = OK;
+	};
+
+	struct ThreadedParseData {
+		const uint8_t *data = nullptr;
+		uint64_t length = 0;
+		LocalVector<ParsedResource> resources;
+		SafeNumeric<uint32_t> next_resource;
+	};
+
+	Error _complete_external_resource(int p_index);
+	Error _instantiate_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource);
+	void _set_resource_property(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const StringName &p_name, Variant &p_value, Dictionary &r_missing_resource_properties);
+	bool _finish_internal_resource(int p_index, const Ref<Resource> &p_res, MissingResource *p_missing_resource, const Dictionary &p_missing_resource_properties);
+	void _parse_resources_threaded(uint32_t p_task, ThreadedParseData *p_data);
+	Error _load_threaded();
+
 	HashMap<String, Ref<Resource>> dependency_cache;
 
 public:
@@ -0,0 +1,403 @@
+/**************************************************************************/
+/*  resource_streamer.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "resource_streamer.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+BinaryMutex ResourceStreamer::mutex;
+ConditionVariable ResourceStreamer::done_cond;
+HashMap<String, ResourceStreamer::Request *> ResourceStreamer::requests;
+LocalVector<ResourceStreamer::Request *> ResourceStreamer::pending;
+LocalVector<WorkerThreadPool::TaskID> ResourceStreamer::started_tasks;
+
+Vector3 ResourceStreamer::origin;
+int ResourceStreamer::max_loads = 0;
+uint64_t ResourceStreamer::memory_budget = 0;
+int ResourceStreamer::loads_in_flight = 0;
+uint64_t ResourceStreamer::size_in_flight = 0;
+uint64_t ResourceStreamer::next_sequence = 0;
+uint64_t ResourceStreamer::average_latency_usec = 0;
+
+float ResourceStreamer::_get_effective_priority(const Request *p_request) {
+	if (!p_request->has_position) {
+		return p_request->priority;
+	}
+	return p_request->priority - origin.distance_to(p_request->position);
+}
+
+uint64_t ResourceStreamer::_estimate_size(const String &p_path) {
+	String path = ResourceLoader::path_remap(p_path);
+	if (ResourceLoader::is_imported(path)) {
+		path = ResourceLoader::import_remap(path);
+	}
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	return f.is_valid() ? f->get_length() : 0;
+}
+
+void ResourceStreamer::_remove_pending(Request *p_request) {
+	int64_t idx = pending.find(p_request);
+	if (idx >= 0) {
+		pending.remove_at_unordered(idx);
+	}
+}
+
+// Picks the requests to load next, within the limits. Must be called with the
+// mutex held, and the result passed to _start() once it is released.
+void ResourceStreamer::_dispatch(LocalVector<Request *> &r_to_start) {
+	const int load_limit = max_loads > 0 ? max_loads : MAX(1, WorkerThreadPool::get_singleton()->get_thread_count() / 2);
+
+	while (!pending.is_empty() && loads_in_flight < load_limit) {
+		uint32_t best = 0;
+		float best_priority = _get_effective_priority(pending[0]);
+		for (uint32_t i = 1; i < pending.size(); i++) {
+			float priority = _get_effective_priority(pending[i]);
+			if (priority > best_priority || (priority == best_priority && pending[i]->sequence < pending[best]->sequence)) {
+				best = i;
+				best_priority = priority;
+			}
+		}
+
+		Request *r = pending[best];
+		if (memory_budget && loads_in_flight > 0 && size_in_flight + r->size > memory_budget) {
+			break; // Wait for loads in flight to finish, so the top priority is not overtaken.
+		}
+
+		pending.remove_at_unordered(best);
+		r->state = Request::STATE_LOADING;
+		loads_in_flight++;
+		size_in_flight += r->size;
+		r_to_start.push_back(r);
+	}
+}
+
+void ResourceStreamer::_start(const LocalVector<Request *> &p_requests) {
+	for (Request *r : p_requests) {
+		// Without worker threads the task runs right here, so the mutex must not be held.
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceStreamer::_load_task, r, false, "Stream " + r->path);
+		MutexLock lock(mutex);
+		started_tasks.push_back(task_id);
+	}
+}
+
+void ResourceStreamer::_reap_finished_tasks(bool p_wait_all) {
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	{
+		MutexLock lock(mutex);
+		for (uint32_t i = 0; i < started_tasks.size(); i++) {
+			if (p_wait_all || WorkerThreadPool::get_singleton()->is_task_completed(started_tasks[i])) {
+				tasks.push_back(started_tasks[i]);
+				started_tasks.remove_at_unordered(i);
+				i--;
+			}
+		}
+	}
+	for (WorkerThreadPool::TaskID task_id : tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	}
+}
+
+void ResourceStreamer::_finish_load(Request *p_request, const Ref<Resource> &p_resource, Error p_error) {
+	LocalVector<Request *> to_start;
+	{
+		MutexLock lock(mutex);
+		loads_in_flight--;
+		size_in_flight -= p_request->size;
+
+		if (p_request->cancelled) {
+			// Already removed from the requests, nobody else will see it.
+			memdelete(p_request);
+		} else {
+			p_request->resource = p_resource;
+			p_request->error = p_resource.is_valid() ? OK : (p_error != OK ? p_error : FAILED);
+			p_request->state = Request::STATE_DONE;
+
+			uint64_t latency = OS::get_singleton()->get_ticks_usec() - p_request->requested_usec;
+			average_latency_usec = average_latency_usec ? (average_latency_usec * 7 + latency) / 8 : latency;
+		}
+
+		done_cond.notify_all();
+		_dispatch(to_start);
+	}
+	_start(to_start);
+}
+
+void ResourceStreamer::_load_task(void *p_userdata) {
+	Request *r = (Request *)p_userdata;
+
+	Error err = OK;
+	Ref<Resource> res = ResourceLoader::load(r->path, r->type_hint, r->cache_mode, &err);
+	_finish_load(r, res, err);
+}
+
+Error ResourceStreamer::request(const String &p_path, const String &p_type_hint, float p_priority, ResourceFormatLoader::CacheMode p_cache_mode) {
+	_reap_finished_tasks();
+
+	{
+		MutexLock lock(mutex);
+		HashMap<String, Request *>::Iterator E = requests.find(p_path);
+		if (E) {
+			// Repeated request, shared with the previous requesters. It only matters if it is more urgent.
+			E->value->user_rc++;
+			E->value->priority = MAX(E->value->priority, p_priority);
+			return OK;
+		}
+	}
+
+	uint64_t size = _estimate_size(p_path);
+
+	LocalVector<Request *> to_start;
+	{
+		MutexLock lock(mutex);
+		HashMap<String, Request *>::Iterator E = requests.find(p_path);
+		if (E) {
+			// Requested from another thread in the meantime.
+			E->value->user_rc++;
+			E->value->priority = MAX(E->value->priority, p_priority);
+			return OK;
+		}
+
+		Request *r = memnew(Request);
+		r->path = p_path;
+		r->type_hint = p_type_hint;
+		r->cache_mode = p_cache_mode;
+		r->priority = p_priority;
+		r->size = size;
+		r->sequence = next_sequence++;
+		r->requested_usec = OS::get_singleton()->get_ticks_usec();
+		requests[p_path] = r;
+		pending.push_back(r);
+
+		_dispatch(to_start);
+	}
+	_start(to_start);
+	return OK;
+}
+
+bool ResourceStreamer::cancel(const String &p_path) {
+	_reap_finished_tasks();
+
+	Ref<Resource> discarded; // Released outside the lock.
+	MutexLock lock(mutex);
+	HashMap<String, Request *>::Iterator E = requests.find(p_path);
+	if (!E) {
+		return false;
+	}
+
+	Request *r = E->value;
+	r->user_rc--;
+	if (r->user_rc > 0) {
+		return true; // Still wanted by other requesters.
+	}
+
+	requests.remove(E);
+	switch (r->state) {
+		case Request::STATE_PENDING: {
+			_remove_pending(r);
+			memdelete(r);
+		} break;
+		case Request::STATE_LOADING: {
+			// The load cannot be interrupted, the task frees the request when done.
+			r->cancelled = true;
+		} break;
+		case Request::STATE_DONE: {
+			discarded = r->resource;
+			memdelete(r);
+		} break;
+	}
+	return true;
+}
+
+ResourceLoader::ThreadLoadStatus ResourceStreamer::get_status(const String &p_path) {
+	_reap_finished_tasks();
+
+	MutexLock lock(mutex);
+	HashMap<String, Request *>::ConstIterator E = requests.find(p_path);
+	if (!E) {
+		return ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+	}
+	if (E->value->state != Request::STATE_DONE) {
+		return ResourceLoader::THREAD_LOAD_IN_PROGRESS;
+	}
+	return E->value->error == OK ? ResourceLoader::THREAD_LOAD_LOADED : ResourceLoader::THREAD_LOAD_FAILED;
+}
+
+Ref<Resource> ResourceStreamer::get(const String &p_path, Error *r_error) {
+	_reap_finished_tasks();
+
+	Request *r = nullptr;
+	bool load_here = false;
+	{
+		MutexLock lock(mutex);
+		HashMap<String, Request *>::Iterator E = requests.find(p_path);
+		if (!E) {
+			if (r_error) {
+				*r_error = ERR_INVALID_PARAMETER;
+			}
+			return Ref<Resource>();
+		}
+
+		r = E->value;
+		if (r->state == Request::STATE_PENDING) {
+			// Counted as in flight, so other requesters wait for it like for any other load.
+			_remove_pending(r);
+			r->state = Request::STATE_LOADING;
+			loads_in_flight++;
+			size_in_flight += r->size;
+			load_here = true;
+		} else {
+			while (r->state == Request::STATE_LOADING) {
+				done_cond.wait(lock);
+			}
+		}
+	}
+
+	if (load_here) {
+		// Needed right now, so load it on this thread instead of waiting for its turn.
+		Error err = OK;
+		Ref<Resource> res = ResourceLoader::load(r->path, r->type_hint, r->cache_mode, &err);
+		_finish_load(r, res, err);
+	}
+
+	Ref<Resource> res;
+	{
+		// This requester's reference kept the request alive while it was loading.
+		MutexLock lock(mutex);
+		res = r->resource;
+		if (r_error) {
+			*r_error = r->error;
+		}
+		r->user_rc--;
+		if (r->user_rc == 0) {
+			requests.erase(r->path);
+			memdelete(r);
+		}
+	}
+	return res;
+}
+
+void ResourceStreamer::set_priority(const String &p_path, float p_priority) {
+	MutexLock lock(mutex);
+	HashMap<String, Request *>::Iterator E = requests.find(p_path);
+	ERR_FAIL_COND_MSG(!E, "No streaming request for resource path '" + p_path + "'.");
+	E->value->priority = p_priority;
+}
+
+void ResourceStreamer::set_position(const String &p_path, const Vector3 &p_position) {
+	MutexLock lock(mutex);
+	HashMap<String, Request *>::Iterator E = requests.find(p_path);
+	ERR_FAIL_COND_MSG(!E, "No streaming request for resource path '" + p_path + "'.");
+	E->value->has_position = true;
+	E->value->position = p_position;
+}
+
+void ResourceStreamer::set_origin(const Vector3 &p_origin) {
+	// Pending requests are ranked when dispatched, so moving the origin reprioritizes them all.
+	MutexLock lock(mutex);
+	origin = p_origin;
+}
+
+Vector3 ResourceStreamer::get_origin() {
+	MutexLock lock(mutex);
+	return origin;
+}
+
+void ResourceStreamer::set_max_loads(int p_max_loads) {
+	ERR_FAIL_COND(p_max_loads < 0);
+	LocalVector<Request *> to_start;
+	{
+		MutexLock lock(mutex);
+		max_loads = p_max_loads;
+		_dispatch(to_start);
+	}
+	_start(to_start);
+}
+
+int ResourceStreamer::get_max_loads() {
+	MutexLock lock(mutex);
+	return max_loads;
+}
+
+void ResourceStreamer::set_memory_budget(uint64_t p_bytes) {
+	LocalVector<Request *> to_start;
+	{
+		MutexLock lock(mutex);
+		memory_budget = p_bytes;
+		_dispatch(to_start);
+	}
+	_start(to_start);
+}
+
+uint64_t ResourceStreamer::get_memory_budget() {
+	MutexLock lock(mutex);
+	return memory_budget;
+}
+
+int ResourceStreamer::get_queue_depth() {
+	MutexLock lock(mutex);
+	return pending.size();
+}
+
+int ResourceStreamer::get_loads_in_flight() {
+	MutexLock lock(mutex);
+	return loads_in_flight;
+}
+
+uint64_t ResourceStreamer::get_size_in_flight() {
+	MutexLock lock(mutex);
+	return size_in_flight;
+}
+
+double ResourceStreamer::get_average_latency() {
+	MutexLock lock(mutex);
+	return average_latency_usec / 1000000.0;
+}
+
+void ResourceStreamer::clear() {
+	{
+		MutexLock lock(mutex);
+		for (Request *r : pending) {
+			requests.erase(r->path);
+			memdelete(r);
+		}
+		pending.clear();
+
+		while (loads_in_flight > 0) {
+			done_cond.wait(lock);
+		}
+
+		for (const KeyValue<String, Request *> &E : requests) {
+			memdelete(E.value);
+		}
+		requests.clear();
+	}
+	_reap_finished_tasks(true);
+}
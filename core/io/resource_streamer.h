@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  resource_streamer.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RESOURCE_STREAMER_H
+#define RESOURCE_STREAMER_H
+
+#include "core/io/resource_loader.h"
+#include "core/math/vector3.h"
+#include "core/os/condition_variable.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+
+// Priority-aware background loading on top of ResourceLoader, meant for streaming
+// large worlds. Requests wait in a queue and are handed to the WorkerThreadPool
+// highest priority first, while the number of loads in flight and their estimated
+// size stay under configurable limits. Requests can be reprioritized or cancelled
+// at any time. Each request may carry a world position, in which case its distance
+// to the streaming origin is subtracted from its priority.
+class ResourceStreamer {
+	struct Request {
+		String path;
+		String type_hint;
+		ResourceFormatLoader::CacheMode cache_mode = ResourceFormatLoader::CACHE_MODE_REUSE;
+		float priority = 0.0f;
+		bool has_position = false;
+		Vector3 position;
+		uint64_t size = 0; // Estimated from the file size.
+		uint64_t sequence = 0; // Keeps equal priorities in request order.
+		uint64_t requested_usec = 0;
+		int user_rc = 1; // Each request() must be matched by a get() or cancel().
+
+		enum State {
+			STATE_PENDING,
+			STATE_LOADING,
+			STATE_DONE,
+		};
+		State state = STATE_PENDING;
+		bool cancelled = false;
+		Ref<Resource> resource;
+		Error error = OK;
+	};
+
+	static BinaryMutex mutex;
+	static ConditionVariable done_cond;
+	static HashMap<String, Request *> requests;
+	static LocalVector<Request *> pending;
+	static LocalVector<WorkerThreadPool::TaskID> started_tasks;
+
+	static Vector3 origin;
+	static int max_loads;
+	static uint64_t memory_budget;
+	static int loads_in_flight;
+	static uint64_t size_in_flight;
+	static uint64_t next_sequence;
+	static uint64_t average_latency_usec;
+
+	static float _get_effective_priority(const Request *p_request);
+	static uint64_t _estimate_size(const String &p_path);
+	static void _dispatch(LocalVector<Request *> &r_to_start);
+	static void _start(const LocalVector<Request *> &p_requests);
+	static void _reap_finished_tasks(bool p_wait_all = false);
+	static void _finish_load(Request *p_request, const Ref<Resource> &p_resource, Error p_error);
+	static void _load_task(void *p_userdata);
+	static void _remove_pending(Request *p_request);
+
+public:
+	static Error request(const String &p_path, const String &p_type_hint = "", float p_priority = 0.0f, ResourceFormatLoader::CacheMode p_cache_mode = ResourceFormatLoader::CACHE_MODE_REUSE);
+	static bool cancel(const String &p_path);
+	static ResourceLoader::ThreadLoadStatus get_status(const String &p_path);
+	static Ref<Resource> get(const String &p_path, Error *r_error = nullptr);
+
+	static void set_priority(const String &p_path, float p_priority);
+	static void set_position(const String &p_path, const Vector3 &p_position);
+	static void set_origin(const Vector3 &p_origin);
+	static Vector3 get_origin();
+
+	// 0 uses half of the WorkerThreadPool threads.
+	static void set_max_loads(int p_max_loads);
+	static int get_max_loads();
+	// 0 disables the budget. A single load larger than the budget still runs on its own.
+	static void set_memory_budget(uint64_t p_bytes);
+	static uint64_t get_memory_budget();
+
+	static int get_queue_depth();
+	static int get_loads_in_flight();
+	static uint64_t get_size_in_flight();
+	static double get_average_latency();
+
+	static void clear();
+};
+
+#endif // RESOURCE_STREAMER_H
@@ -0,0 +1,397 @@
+/**************************************************************************/
+/*  packed_math.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "packed_math.h"
+
+#include "core/math/aabb.h"
+#include "core/math/color.h"
+#include "core/math/rect2.h"
+#include "core/math/transform_2d.h"
+#include "core/math/transform_3d.h"
+
+#if !defined(REAL_T_IS_DOUBLE)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PACKED_MATH_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define PACKED_MATH_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(PACKED_MATH_SSE2) || defined(PACKED_MATH_NEON)
+#define PACKED_MATH_SIMD
+
+static_assert(sizeof(Vector2) == 2 * sizeof(float) && sizeof(Vector3) == 3 * sizeof(float) && sizeof(Color) == 4 * sizeof(float), "Packed math kernels expect tightly packed float components.");
+
+// Four floats per register. load3()/store3() transpose four Vector3s from and
+// to one register per component, load2()/store2() do the same for Vector2s.
+
+#if defined(PACKED_MATH_SSE2)
+
+typedef __m128 PackedMathF4;
+
+static _FORCE_INLINE_ PackedMathF4 _pm_set1(float p_value) { return _mm_set1_ps(p_value); }
+static _FORCE_INLINE_ PackedMathF4 _pm_load(const float *p_src) { return _mm_loadu_ps(p_src); }
+static _FORCE_INLINE_ void _pm_store(float *p_dst, PackedMathF4 p_value) { _mm_storeu_ps(p_dst, p_value); }
+static _FORCE_INLINE_ PackedMathF4 _pm_add(PackedMathF4 p_a, PackedMathF4 p_b) { return _mm_add_ps(p_a, p_b); }
+static _FORCE_INLINE_ PackedMathF4 _pm_sub(PackedMathF4 p_a, PackedMathF4 p_b) { return _mm_sub_ps(p_a, p_b); }
+static _FORCE_INLINE_ PackedMathF4 _pm_mul(PackedMathF4 p_a, PackedMathF4 p_b) { return _mm_mul_ps(p_a, p_b); }
+static _FORCE_INLINE_ PackedMathF4 _pm_min(PackedMathF4 p_a, PackedMathF4 p_b) { return _mm_min_ps(p_a, p_b); }
+static _FORCE_INLINE_ PackedMathF4 _pm_max(PackedMathF4 p_a, PackedMathF4 p_b) { return _mm_max_ps(p_a, p_b); }
+static _FORCE_INLINE_ PackedMathF4 _pm_sqrt(PackedMathF4 p_a) { return _mm_sqrt_ps(p_a); }
+
+static _FORCE_INLINE_ void _pm_load3(const float *p_src, PackedMathF4 &r_x, PackedMathF4 &r_y, PackedMathF4 &r_z) {
+	// m0 = x0 y0 z0 x1, m1 = y1 z1 x2 y2, m2 = z2 x3 y3 z3.
+	__m128 m0 = _mm_loadu_ps(p_src);
+	__m128 m1 = _mm_loadu_ps(p_src + 4);
+	__m128 m2 = _mm_loadu_ps(p_src + 8);
+	__m128 t = _mm_shuffle_ps(m1, m2, _MM_SHUFFLE(2, 1, 3, 2)); // x2 y2 x3 y3
+	__m128 u = _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(1, 0, 2, 1)); // y0 z0 y1 z1
+	r_x = _mm_shuffle_ps(m0, t, _MM_SHUFFLE(2, 0, 3, 0));
+	r_y = _mm_shuffle_ps(u, t, _MM_SHUFFLE(3, 1, 2, 0));
+	r_z = _mm_shuffle_ps(u, m2, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+static _FORCE_INLINE_ void _pm_store3(float *p_dst, PackedMathF4 p_x, PackedMathF4 p_y, PackedMathF4 p_z) {
+	__m128 xy_lo = _mm_unpacklo_ps(p_x, p_y); // x0 y0 x1 y1
+	__m128 xy_hi = _mm_unpackhi_ps(p_x, p_y); // x2 y2 x3 y3
+	__m128 zx_lo = _mm_shuffle_ps(p_z, p_x, _MM_SHUFFLE(1, 1, 0, 0)); // z0 z0 x1 x1
+	__m128 yz_lo = _mm_shuffle_ps(p_y, p_z, _MM_SHUFFLE(1, 1, 1, 1)); // y1 y1 z1 z1
+	__m128 zx_hi = _mm_shuffle_ps(p_z, p_x, _MM_SHUFFLE(3, 3, 2, 2)); // z2 z2 x3 x3
+	__m128 yz_hi = _mm_shuffle_ps(p_y, p_z, _MM_SHUFFLE(3, 3, 3, 3)); // y3 y3 z3 z3
+	_mm_storeu_ps(p_dst, _mm_shuffle_ps(xy_lo, zx_lo, _MM_SHUFFLE(2, 0, 1, 0)));
+	_mm_storeu_ps(p_dst + 4, _mm_shuffle_ps(yz_lo, xy_hi, _MM_SHUFFLE(1, 0, 2, 0)));
+	_mm_storeu_ps(p_dst + 8, _mm_shuffle_ps(zx_hi, yz_hi, _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+static _FORCE_INLINE_ void _pm_load2(const float *p_src, PackedMathF4 &r_x, PackedMathF4 &r_y) {
+	__m128 a = _mm_loadu_ps(p_src); // x0 y0 x1 y1
+	__m128 b = _mm_loadu_ps(p_src + 4); // x2 y2 x3 y3
+	r_x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+	r_y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+static _FORCE_INLINE_ void _pm_store2(float *p_dst, PackedMathF4 p_x, PackedMathF4 p_y) {
+	_mm_storeu_ps(p_dst, _mm_unpacklo_ps(p_x, p_y));
+	_mm_storeu_ps(p_dst + 4, _mm_unpackhi_ps(p_x, p_y));
+}
+
+#elif defined(PACKED_MATH_NEON)
+
+typedef float32x4_t PackedMathF4;
+
+static _FORCE_INLINE_ PackedMathF4 _pm_set1(float p_value) { return vdupq_n_f32(p_value); }
+static _FORCE_INLINE_ PackedMathF4 _pm_load(const float *p_src) { return vld1q_f32(p_src); }
+static _FORCE_INLINE_ void _pm_store(float *p_dst, PackedMathF4 p_value) { vst1q_f32(p_dst, p_value); }
+static _FORCE_INLINE_ PackedMathF4 _pm_add(PackedMathF4 p_a, PackedMathF4 p_b) { return vaddq_f32(p_a, p_b); }
+static _FORCE_INLINE_ PackedMathF4 _pm_sub(PackedMathF4 p_a, PackedMathF4 p_b) { return vsubq_f32(p_a, p_b); }
+static _FORCE_INLINE_ PackedMathF4 _pm_mul(PackedMathF4 p_a, PackedMathF4 p_b) { return vmulq_f32(p_a, p_b); }
+static _FORCE_INLINE_ PackedMathF4 _pm_min(PackedMathF4 p_a, PackedMathF4 p_b) { return vminq_f32(p_a, p_b); }
+static _FORCE_INLINE_ PackedMathF4 _pm_max(PackedMathF4 p_a, PackedMathF4 p_b) { return vmaxq_f32(p_a, p_b); }
+static _FORCE_INLINE_ PackedMathF4 _pm_sqrt(PackedMathF4 p_a) { return vsqrtq_f32(p_a); }
+
+static _FORCE_INLINE_ void _pm_load3(const float *p_src, PackedMathF4 &r_x, PackedMathF4 &r_y, PackedMathF4 &r_z) {
+	float32x4x3_t v = vld3q_f32(p_src);
+	r_x = v.val[0];
+	r_y = v.val[1];
+	r_z = v.val[2];
+}
+
+static _FORCE_INLINE_ void _pm_store3(float *p_dst, PackedMathF4 p_x, PackedMathF4 p_y, PackedMathF4 p_z) {
+	float32x4x3_t v = { { p_x, p_y, p_z } };
+	vst3q_f32(p_dst, v);
+}
+
+static _FORCE_INLINE_ void _pm_load2(const float *p_src, PackedMathF4 &r_x, PackedMathF4 &r_y) {
+	float32x4x2_t v = vld2q_f32(p_src);
+	r_x = v.val[0];
+	r_y = v.val[1];
+}
+
+static _FORCE_INLINE_ void _pm_store2(float *p_dst, PackedMathF4 p_x, PackedMathF4 p_y) {
+	float32x4x2_t v = { { p_x, p_y } };
+	vst2q_f32(p_dst, v);
+}
+
+#endif
+
+static _FORCE_INLINE_ float _pm_reduce_min(PackedMathF4 p_a) {
+	float lanes[4];
+	_pm_store(lanes, p_a);
+	return MIN(MIN(lanes[0], lanes[1]), MIN(lanes[2], lanes[3]));
+}
+
+static _FORCE_INLINE_ float _pm_reduce_max(PackedMathF4 p_a) {
+	float lanes[4];
+	_pm_store(lanes, p_a);
+	return MAX(MAX(lanes[0], lanes[1]), MAX(lanes[2], lanes[3]));
+}
+
+// Componentwise a + (b - a) * w over a flat float array, as done by Math::lerp().
+static void _pm_lerp_floats(const float *p_from, const float *p_to, float p_weight, float *r_dst, int64_t p_count) {
+	const PackedMathF4 w = _pm_set1(p_weight);
+	int64_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		PackedMathF4 a = _pm_load(p_from + i);
+		_pm_store(r_dst + i, _pm_add(a, _pm_mul(_pm_sub(_pm_load(p_to + i), a), w)));
+	}
+	for (; i < p_count; i++) {
+		r_dst[i] = Math::lerp(p_from[i], p_to[i], p_weight);
+	}
+}
+
+#endif // PACKED_MATH_SSE2 || PACKED_MATH_NEON
+
+void PackedMath::xform(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, int64_t p_count) {
+	int64_t i = 0;
+#ifdef PACKED_MATH_SIMD
+	const Basis &b = p_xform.basis;
+	const PackedMathF4 b00 = _pm_set1(b.rows[0][0]), b01 = _pm_set1(b.rows[0][1]), b02 = _pm_set1(b.rows[0][2]);
+	const PackedMathF4 b10 = _pm_set1(b.rows[1][0]), b11 = _pm_set1(b.rows[1][1]), b12 = _pm_set1(b.rows[1][2]);
+	const PackedMathF4 b20 = _pm_set1(b.rows[2][0]), b21 = _pm_set1(b.rows[2][1]), b22 = _pm_set1(b.rows[2][2]);
+	const PackedMathF4 ox = _pm_set1(p_xform.origin.x), oy = _pm_set1(p_xform.origin.y), oz = _pm_set1(p_xform.origin.z);
+	for (; i + 4 <= p_count; i += 4) {
+		PackedMathF4 x, y, z;
+		_pm_load3(&p_src[i].x, x, y, z);
+		PackedMathF4 rx = _pm_add(_pm_add(_pm_add(_pm_mul(b00, x), _pm_mul(b01, y)), _pm_mul(b02, z)), ox);
+		PackedMathF4 ry = _pm_add(_pm_add(_pm_add(_pm_mul(b10, x), _pm_mul(b11, y)), _pm_mul(b12, z)), oy);
+		PackedMathF4 rz = _pm_add(_pm_add(_pm_add(_pm_mul(b20, x), _pm_mul(b21, y)), _pm_mul(b22, z)), oz);
+		_pm_store3(&r_dst[i].x, rx, ry, rz);
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_xform.xform(p_src[i]);
+	}
+}
+
+void PackedMath::xform(const Transform2D &p_xform, const Vector2 *p_src, Vector2 *r_dst, int64_t p_count) {
+	int64_t i = 0;
+#ifdef PACKED_MATH_SIMD
+	const PackedMathF4 c00 = _pm_set1(p_xform.columns[0][0]), c10 = _pm_set1(p_xform.columns[1][0]);
+	const PackedMathF4 c01 = _pm_set1(p_xform.columns[0][1]), c11 = _pm_set1(p_xform.columns[1][1]);
+	const PackedMathF4 ox = _pm_set1(p_xform.columns[2][0]), oy = _pm_set1(p_xform.columns[2][1]);
+	for (; i + 4 <= p_count; i += 4) {
+		PackedMathF4 x, y;
+		_pm_load2(&p_src[i].x, x, y);
+		PackedMathF4 rx = _pm_add(_pm_add(_pm_mul(c00, x), _pm_mul(c10, y)), ox);
+		PackedMathF4 ry = _pm_add(_pm_add(_pm_mul(c01, x), _pm_mul(c11, y)), oy);
+		_pm_store2(&r_dst[i].x, rx, ry);
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_xform.xform(p_src[i]);
+	}
+}
+
+AABB PackedMath::get_aabb(const Vector3 *p_src, int64_t p_count) {
+	if (p_count <= 0) {
+		return AABB();
+	}
+	Vector3 min = p_src[0];
+	Vector3 max = p_src[0];
+	int64_t i = 0;
+#ifdef PACKED_MATH_SIMD
+	if (p_count >= 4) {
+		PackedMathF4 min_x, min_y, min_z;
+		_pm_load3(&p_src[0].x, min_x, min_y, min_z);
+		PackedMathF4 max_x = min_x, max_y = min_y, max_z = min_z;
+		for (i = 4; i + 4 <= p_count; i += 4) {
+			PackedMathF4 x, y, z;
+			_pm_load3(&p_src[i].x, x, y, z);
+			min_x = _pm_min(min_x, x);
+			min_y = _pm_min(min_y, y);
+			min_z = _pm_min(min_z, z);
+			max_x = _pm_max(max_x, x);
+			max_y = _pm_max(max_y, y);
+			max_z = _pm_max(max_z, z);
+		}
+		min = Vector3(_pm_reduce_min(min_x), _pm_reduce_min(min_y), _pm_reduce_min(min_z));
+		max = Vector3(_pm_reduce_max(max_x), _pm_reduce_max(max_y), _pm_reduce_max(max_z));
+	}
+#endif
+	for (; i < p_count; i++) {
+		min = min.min(p_src[i]);
+		max = max.max(p_src[i]);
+	}
+	return AABB(min, max - min);
+}
+
+Rect2 PackedMath::get_rect(const Vector2 *p_src, int64_t p_count) {
+	if (p_count <= 0) {
+		return Rect2();
+	}
+	Vector2 min = p_src[0];
+	Vector2 max = p_src[0];
+	int64_t i = 0;
+#ifdef PACKED_MATH_SIMD
+	if (p_count >= 4) {
+		PackedMathF4 min_x, min_y;
+		_pm_load2(&p_src[0].x, min_x, min_y);
+		PackedMathF4 max_x = min_x, max_y = min_y;
+		for (i = 4; i + 4 <= p_count; i += 4) {
+			PackedMathF4 x, y;
+			_pm_load2(&p_src[i].x, x, y);
+			min_x = _pm_min(min_x, x);
+			min_y = _pm_min(min_y, y);
+			max_x = _pm_max(max_x, x);
+			max_y = _pm_max(max_y, y);
+		}
+		min = Vector2(_pm_reduce_min(min_x), _pm_reduce_min(min_y));
+		max = Vector2(_pm_reduce_max(max_x), _pm_reduce_max(max_y));
+	}
+#endif
+	for (; i < p_count; i++) {
+		min = min.min(p_src[i]);
+		max = max.max(p_src[i]);
+	}
+	return Rect2(min, max - min);
+}
+
+void PackedMath::lerp(const Vector3 *p_from, const Vector3 *p_to, real_t p_weight, Vector3 *r_dst, int64_t p_count) {
+#ifdef PACKED_MATH_SIMD
+	_pm_lerp_floats(&p_from->x, &p_to->x, p_weight, &r_dst->x, p_count * 3);
+#else
+	for (int64_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_from[i].lerp(p_to[i], p_weight);
+	}
+#endif
+}
+
+void PackedMath::lerp(const Vector2 *p_from, const Vector2 *p_to, real_t p_weight, Vector2 *r_dst, int64_t p_count) {
+#ifdef PACKED_MATH_SIMD
+	_pm_lerp_floats(&p_from->x, &p_to->x, p_weight, &r_dst->x, p_count * 2);
+#else
+	for (int64_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_from[i].lerp(p_to[i], p_weight);
+	}
+#endif
+}
+
+void PackedMath::lerp(const Color *p_from, const Color *p_to, float p_weight, Color *r_dst, int64_t p_count) {
+#ifdef PACKED_MATH_SIMD
+	_pm_lerp_floats(&p_from->r, &p_to->r, p_weight, &r_dst->r, p_count * 4);
+#else
+	for (int64_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_from[i].lerp(p_to[i], p_weight);
+	}
+#endif
+}
+
+void PackedMath::dot(const Vector3 *p_a, const Vector3 *p_b, float *r_dst, int64_t p_count) {
+	int64_t i = 0;
+#ifdef PACKED_MATH_SIMD
+	for (; i + 4 <= p_count; i += 4) {
+		PackedMathF4 ax, ay, az, bx, by, bz;
+		_pm_load3(&p_a[i].x, ax, ay, az);
+		_pm_load3(&p_b[i].x, bx, by, bz);
+		_pm_store(r_dst + i, _pm_add(_pm_add(_pm_mul(ax, bx), _pm_mul(ay, by)), _pm_mul(az, bz)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_a[i].dot(p_b[i]);
+	}
+}
+
+void PackedMath::dot(const Vector2 *p_a, const Vector2 *p_b, float *r_dst, int64_t p_count) {
+	int64_t i = 0;
+#ifdef PACKED_MATH_SIMD
+	for (; i + 4 <= p_count; i += 4) {
+		PackedMathF4 ax, ay, bx, by;
+		_pm_load2(&p_a[i].x, ax, ay);
+		_pm_load2(&p_b[i].x, bx, by);
+		_pm_store(r_dst + i, _pm_add(_pm_mul(ax, bx), _pm_mul(ay, by)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_a[i].dot(p_b[i]);
+	}
+}
+
+void PackedMath::cross(const Vector3 *p_a, const Vector3 *p_b, Vector3 *r_dst, int64_t p_count) {
+	int64_t i = 0;
+#ifdef PACKED_MATH_SIMD
+	for (; i + 4 <= p_count; i += 4) {
+		PackedMathF4 ax, ay, az, bx, by, bz;
+		_pm_load3(&p_a[i].x, ax, ay, az);
+		_pm_load3(&p_b[i].x, bx, by, bz);
+		PackedMathF4 rx = _pm_sub(_pm_mul(ay, bz), _pm_mul(az, by));
+		PackedMathF4 ry = _pm_sub(_pm_mul(az, bx), _pm_mul(ax, bz));
+		PackedMathF4 rz = _pm_sub(_pm_mul(ax, by), _pm_mul(ay, bx));
+		_pm_store3(&r_dst[i].x, rx, ry, rz);
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_a[i].cross(p_b[i]);
+	}
+}
+
+void PackedMath::cross(const Vector2 *p_a, const Vector2 *p_b, float *r_dst, int64_t p_count) {
+	int64_t i = 0;
+#ifdef PACKED_MATH_SIMD
+	for (; i + 4 <= p_count; i += 4) {
+		PackedMathF4 ax, ay, bx, by;
+		_pm_load2(&p_a[i].x, ax, ay);
+		_pm_load2(&p_b[i].x, bx, by);
+		_pm_store(r_dst + i, _pm_sub(_pm_mul(ax, by), _pm_mul(ay, bx)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_a[i].cross(p_b[i]);
+	}
+}
+
+void PackedMath::length(const Vector3 *p_src, float *r_dst, int64_t p_count) {
+	int64_t i = 0;
+#ifdef PACKED_MATH_SIMD
+	for (; i + 4 <= p_count; i += 4) {
+		PackedMathF4 x, y, z;
+		_pm_load3(&p_src[i].x, x, y, z);
+		_pm_store(r_dst + i, _pm_sqrt(_pm_add(_pm_add(_pm_mul(x, x), _pm_mul(y, y)), _pm_mul(z, z))));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_src[i].length();
+	}
+}
+
+void PackedMath::length(const Vector2 *p_src, float *r_dst, int64_t p_count) {
+	int64_t i = 0;
+#ifdef PACKED_MATH_SIMD
+	for (; i + 4 <= p_count; i += 4) {
+		PackedMathF4 x, y;
+		_pm_load2(&p_src[i].x, x, y);
+		_pm_store(r_dst + i, _pm_sqrt(_pm_add(_pm_mul(x, x), _pm_mul(y, y))));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_src[i].length();
+	}
+}
@@ -0,0 +1,76 @@
+/**************************************************************************/
+/*  packed_math.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef PACKED_MATH_H
+#define PACKED_MATH_H
+
+#include "core/math/math_defs.h"
+#include "core/typedefs.h"
+
+struct AABB;
+struct Color;
+struct Rect2;
+struct Transform2D;
+struct Transform3D;
+struct Vector2;
+struct Vector3;
+
+/**
+ * Bulk math kernels over contiguous arrays of vectors and colors, as stored in
+ * packed arrays.
+ *
+ * With single-precision reals, the kernels load four elements per step with
+ * SSE2 or NEON and transpose them to one register per component, so the math
+ * runs on four elements at once. The remainder, and double-precision builds,
+ * use the scalar loop. Results match the per-element methods (Vector3::dot(),
+ * Transform3D::xform(), ...) as the same operations are applied in the same
+ * order. Source and destination may be the same array.
+ */
+class PackedMath {
+public:
+	static void xform(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, int64_t p_count);
+	static void xform(const Transform2D &p_xform, const Vector2 *p_src, Vector2 *r_dst, int64_t p_count);
+
+	static AABB get_aabb(const Vector3 *p_src, int64_t p_count);
+	static Rect2 get_rect(const Vector2 *p_src, int64_t p_count);
+
+	static void lerp(const Vector3 *p_from, const Vector3 *p_to, real_t p_weight, Vector3 *r_dst, int64_t p_count);
+	static void lerp(const Vector2 *p_from, const Vector2 *p_to, real_t p_weight, Vector2 *r_dst, int64_t p_count);
+	static void lerp(const Color *p_from, const Color *p_to, float p_weight, Color *r_dst, int64_t p_count);
+
+	static void dot(const Vector3 *p_a, const Vector3 *p_b, float *r_dst, int64_t p_count);
+	static void dot(const Vector2 *p_a, const Vector2 *p_b, float *r_dst, int64_t p_count);
+	static void cross(const Vector3 *p_a, const Vector3 *p_b, Vector3 *r_dst, int64_t p_count);
+	static void cross(const Vector2 *p_a, const Vector2 *p_b, float *r_dst, int64_t p_count);
+	static void length(const Vector3 *p_src, float *r_dst, int64_t p_count);
+	static void length(const Vector2 *p_src, float *r_dst, int64_t p_count);
+};
+
+#endif // PACKED_MATH_H
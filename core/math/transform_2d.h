@@ -32,6 +32,7 @@
 #define TRANSFORM_2D_H
 
 #include "core/math/math_funcs.h"
+#include "core/math/packed_math.h"
 #include "core/math/rect2.h"
 #include "core/math/vector2.h"
 #include "core/templates/vector.h"
@@ -224,13 +225,7 @@ Rect2 Transform2D::xform_inv(const Rect2 &p_rect) const {
 Vector<Vector2> Transform2D::xform(const Vector<Vector2> &p_array) const {
 	Vector<Vector2> array;
 	array.resize(p_array.size());
-
-	const Vector2 *r = p_array.ptr();
-	Vector2 *w = array.ptrw();
-
-	for (int i = 0; i < p_array.size(); ++i) {
-		w[i] = xform(r[i]);
-	}
+	PackedMath::xform(*this, p_array.ptr(), array.ptrw(), p_array.size());
 	return array;
 }
 
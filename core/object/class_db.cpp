@@ -32,12 +32,112 @@
 
 #include "core/config/engine.h"
 #include "core/io/resource_loader.h"
+#include "core/object/object_inline_cache.h"
 #include "core/object/script_language.h"
 #include "core/os/mutex.h"
 #include "core/version.h"
 
-#define OBJTYPE_RLOCK RWLockRead _rw_lockr_(lock);
-#define OBJTYPE_WLOCK RWLockWrite _rw_lockw_(lock);
+#include <thread>
+
+// While ClassDB is frozen, readers don't touch the shared RWLock. Each thread
+// only announces itself in its own reader slot, so lookups from many threads
+// never contend on the same cache line. Writers clear the frozen flag under the
+// write lock and wait for the slots to drain before modifying anything.
+static constexpr uint32_t CLASSDB_READER_SLOTS = 64;
+
+struct alignas(64) ClassDBReaderSlot {
+	std::atomic<uint32_t> readers = { 0 };
+};
+
+static ClassDBReaderSlot classdb_reader_slots[CLASSDB_READER_SLOTS];
+static std::atomic<uint32_t> classdb_reader_slot_next = { 0 };
+static std::atomic<bool> classdb_frozen = { false };
+
+static _FORCE_INLINE_ std::atomic<uint32_t> &_get_reader_slot() {
+	static thread_local uint32_t index = classdb_reader_slot_next.fetch_add(1, std::memory_order_relaxed) % CLASSDB_READER_SLOTS;
+	return classdb_reader_slots[index].readers;
+}
+
+// Number of frozen readers active on this thread. Nested lookups (validators or
+// creation functions calling back into ClassDB) reuse the outer reader's slot:
+// a writer draining the slots must never make them fall back to the RWLock it
+// holds, or the thread would wait on itself.
+static thread_local uint32_t classdb_frozen_read_depth = 0;
+
+static void _wait_for_frozen_readers() {
+	// seq_cst, like the store clearing the flag, so these loads can't be reordered before it.
+	// Together with the readers' increment and flag check, one side always sees the other.
+	for (ClassDBReaderSlot &slot : classdb_reader_slots) {
+		while (slot.readers.load(std::memory_order_seq_cst) != 0) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+class ClassDBReadLock {
+	const RWLock &lock;
+	std::atomic<uint32_t> *slot = nullptr;
+
+public:
+	_FORCE_INLINE_ ClassDBReadLock(const RWLock &p_lock) :
+			lock(p_lock) {
+		if (classdb_frozen_read_depth > 0) {
+			classdb_frozen_read_depth++;
+			return;
+		}
+		if (classdb_frozen.load(std::memory_order_relaxed)) {
+			std::atomic<uint32_t> &s = _get_reader_slot();
+			s.fetch_add(1, std::memory_order_seq_cst);
+			// Pairs with the writer clearing the flag before draining the slots.
+			if (classdb_frozen.load(std::memory_order_seq_cst)) {
+				slot = &s;
+				classdb_frozen_read_depth = 1;
+				return;
+			}
+			s.fetch_sub(1, std::memory_order_release);
+		}
+		lock.read_lock();
+	}
+
+	_FORCE_INLINE_ ~ClassDBReadLock() {
+		if (slot) {
+			classdb_frozen_read_depth = 0;
+			slot->fetch_sub(1, std::memory_order_release);
+		} else if (classdb_frozen_read_depth > 0) {
+			classdb_frozen_read_depth--;
+		} else {
+			lock.read_unlock();
+		}
+	}
+};
+
+class ClassDBWriteLock {
+	RWLock &lock;
+	bool was_frozen = false;
+
+public:
+	ClassDBWriteLock(RWLock &p_lock) :
+			lock(p_lock) {
+		lock.write_lock();
+		was_frozen = classdb_frozen.load(std::memory_order_relaxed);
+		if (was_frozen) {
+			classdb_frozen.store(false, std::memory_order_seq_cst);
+			_wait_for_frozen_readers();
+		}
+		ObjectInlineCache::invalidate_all();
+	}
+
+	~ClassDBWriteLock() {
+		ObjectInlineCache::invalidate_all();
+		if (was_frozen) {
+			classdb_frozen.store(true, std::memory_order_release);
+		}
+		lock.write_unlock();
+	}
+};
+
+#define OBJTYPE_RLOCK ClassDBReadLock _rw_lockr_(lock);
+#define OBJTYPE_WLOCK ClassDBWriteLock _rw_lockw_(lock);
 
 #ifdef DEBUG_METHODS_ENABLED
 
@@ -542,6 +642,23 @@ Object *ClassDB::instantiate_no_placeholders(const StringName &p_class) {
 	return _instantiate_internal(p_class, true);
 }
 
+Object *(*ClassDB::get_creation_func(const StringName &p_class))() {
+	OBJTYPE_RLOCK;
+	ClassInfo *ti = classes.getptr(p_class);
+	if (!ti || ti->disabled || ti->gdextension) {
+		return nullptr;
+	}
+#ifdef TOOLS_ENABLED
+	if ((ti->api == API_EDITOR || ti->api == API_EDITOR_EXTENSION) && !Engine::get_singleton()->is_editor_hint()) {
+		return nullptr;
+	}
+	if (ti->is_runtime && Engine::get_singleton()->is_editor_hint()) {
+		return nullptr;
+	}
+#endif
+	return ti->creation_func;
+}
+
 #ifdef TOOLS_ENABLED
 ObjectGDExtension *ClassDB::get_placeholder_extension(const StringName &p_class) {
 	ObjectGDExtension *placeholder_extension = placeholder_extensions.getptr(p_class);
@@ -1389,26 +1506,33 @@ void ClassDB::add_linked_property(const StringName &p_class, const String &p_pro
 }
 
 void ClassDB::get_property_list(const StringName &p_class, List<PropertyInfo> *p_list, bool p_no_inheritance, const Object *p_validator) {
-	OBJTYPE_RLOCK;
+	List<PropertyInfo>::Element *last = p_list->back();
 
-	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
-	while (check) {
-		for (const PropertyInfo &pi : check->property_list) {
-			if (p_validator) {
-				// Making a copy as we may modify it.
-				PropertyInfo pi_mut = pi;
-				p_validator->validate_property(pi_mut);
-				p_list->push_back(pi_mut);
-			} else {
+	{
+		OBJTYPE_RLOCK;
+
+		ClassInfo *type = classes.getptr(p_class);
+		ClassInfo *check = type;
+		while (check) {
+			for (const PropertyInfo &pi : check->property_list) {
 				p_list->push_back(pi);
 			}
-		}
 
-		if (p_no_inheritance) {
-			return;
+			if (p_no_inheritance) {
+				break;
+			}
+			check = check->inherits_ptr;
 		}
-		check = check->inherits_ptr;
+	}
+
+	if (!p_validator) {
+		return;
+	}
+
+	// Validators may run script or extension code that calls back into ClassDB,
+	// so they are only called once the lock is released.
+	for (List<PropertyInfo>::Element *E = last ? last->next() : p_list->front(); E; E = E->next()) {
+		p_validator->validate_property(E->get());
 	}
 }
 
@@ -1432,27 +1556,39 @@ void ClassDB::get_linked_properties_info(const StringName &p_class, const String
 }
 
 bool ClassDB::get_property_info(const StringName &p_class, const StringName &p_property, PropertyInfo *r_info, bool p_no_inheritance, const Object *p_validator) {
-	OBJTYPE_RLOCK;
+	PropertyInfo pinfo;
+	bool found = false;
 
-	ClassInfo *check = classes.getptr(p_class);
-	while (check) {
-		if (check->property_map.has(p_property)) {
-			PropertyInfo pinfo = check->property_map[p_property];
-			if (p_validator) {
-				p_validator->validate_property(pinfo);
+	{
+		OBJTYPE_RLOCK;
+
+		ClassInfo *check = classes.getptr(p_class);
+		while (check) {
+			const PropertyInfo *info = check->property_map.getptr(p_property);
+			if (info) {
+				pinfo = *info;
+				found = true;
+				break;
 			}
-			if (r_info) {
-				*r_info = pinfo;
+			if (p_no_inheritance) {
+				break;
 			}
-			return true;
+			check = check->inherits_ptr;
 		}
-		if (p_no_inheritance) {
-			break;
-		}
-		check = check->inherits_ptr;
 	}
 
-	return false;
+	if (!found) {
+		return false;
+	}
+
+	// See get_property_list(), validators run outside the lock.
+	if (p_validator) {
+		p_validator->validate_property(pinfo);
+	}
+	if (r_info) {
+		*r_info = pinfo;
+	}
+	return true;
 }
 
 bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
@@ -1504,6 +1640,40 @@ bool ClassDB::set_property(Object *p_object, const StringName &p_property, const
 	return false;
 }
 
+MethodBind *ClassDB::get_property_setter_bind(const StringName &p_class, const StringName &p_property) {
+	OBJTYPE_RLOCK;
+
+	ClassInfo *check = classes.getptr(p_class);
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			return psg->index < 0 ? psg->_setptr : nullptr;
+		}
+		check = check->inherits_ptr;
+	}
+
+	return nullptr;
+}
+
+MethodBind *ClassDB::get_property_getter_bind(const StringName &p_class, const StringName &p_property) {
+	OBJTYPE_RLOCK;
+
+	ClassInfo *check = classes.getptr(p_class);
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			return psg->index < 0 ? psg->_getptr : nullptr;
+		}
+		// Constants, methods and signals shadow properties of parent classes.
+		if (check->constant_map.has(p_property) || check->method_map.has(p_property) || check->signal_map.has(p_property)) {
+			return nullptr;
+		}
+		check = check->inherits_ptr;
+	}
+
+	return nullptr;
+}
+
 bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
 	ERR_FAIL_NULL_V(p_object, false);
 
@@ -2057,6 +2227,7 @@ Variant ClassDB::class_get_default_property_value(const StringName &p_class, con
 
 void ClassDB::register_extension_class(ObjectGDExtension *p_extension) {
 	GLOBAL_LOCK_FUNCTION;
+	OBJTYPE_WLOCK;
 
 	ERR_FAIL_COND_MSG(classes.has(p_extension->class_name), "Class already registered: " + String(p_extension->class_name));
 	ERR_FAIL_COND_MSG(!classes.has(p_extension->parent_class_name), "Parent class name for extension class not found: " + String(p_extension->parent_class_name));
@@ -2099,6 +2270,8 @@ void ClassDB::register_extension_class(ObjectGDExtension *p_extension) {
 }
 
 void ClassDB::unregister_extension_class(const StringName &p_class, bool p_free_method_binds) {
+	OBJTYPE_WLOCK;
+
 	ClassInfo *c = classes.getptr(p_class);
 	ERR_FAIL_NULL_MSG(c, "Class '" + String(p_class) + "' does not exist.");
 	if (p_free_method_binds) {
@@ -2140,6 +2313,25 @@ uint64_t ClassDB::get_native_struct_size(const StringName &p_name) {
 
 RWLock ClassDB::lock;
 
+void ClassDB::freeze() {
+	lock.write_lock();
+	classdb_frozen.store(true, std::memory_order_release);
+	lock.write_unlock();
+}
+
+void ClassDB::unfreeze() {
+	lock.write_lock();
+	if (classdb_frozen.load(std::memory_order_relaxed)) {
+		classdb_frozen.store(false, std::memory_order_seq_cst);
+		_wait_for_frozen_readers();
+	}
+	lock.write_unlock();
+}
+
+bool ClassDB::is_frozen() {
+	return classdb_frozen.load(std::memory_order_acquire);
+}
+
 void ClassDB::cleanup_defaults() {
 	default_values.clear();
 	default_values_cached.clear();
@@ -290,6 +290,9 @@ public:
 	static bool is_virtual(const StringName &p_class);
 	static Object *instantiate(const StringName &p_class);
 	static Object *instantiate_no_placeholders(const StringName &p_class);
+	// Returns the native constructor instantiate() would end up calling, or nullptr when
+	// instantiating the class needs more than that (extensions, placeholders, disabled classes).
+	static Object *(*get_creation_func(const StringName &p_class))();
 	static void set_object_extension_instance(Object *p_object, const StringName &p_class, GDExtensionClassInstancePtr p_instance);
 
 	static APIType get_api_type(const StringName &p_class);
@@ -418,6 +421,10 @@ public:
 	static void get_linked_properties_info(const StringName &p_class, const StringName &p_property, List<StringName> *r_properties, bool p_no_inheritance = false);
 	static bool set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid = nullptr);
 	static bool get_property(Object *p_object, const StringName &p_property, Variant &r_value);
+	// Resolve p_property the way set_property() and get_property() do, but only
+	// return the accessor when it's a plain bound method (not indexed).
+	static MethodBind *get_property_setter_bind(const StringName &p_class, const StringName &p_property);
+	static MethodBind *get_property_getter_bind(const StringName &p_class, const StringName &p_property);
 	static bool has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance = false);
 	static int get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
 	static Variant::Type get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
@@ -474,6 +481,13 @@ public:
 	static void cleanup_defaults();
 	static void cleanup();
 
+	// Once frozen, lookups no longer take the shared lock. Later modifications
+	// (lazily initialized classes, GDExtension reloading) are still allowed but
+	// become expensive, as they wait for all in-flight lookups to finish.
+	static void freeze();
+	static void unfreeze();
+	static bool is_frozen();
+
 	static void register_native_struct(const StringName &p_name, const String &p_code, uint64_t p_current_size);
 	static void get_native_struct_list(List<StringName> *r_names);
 	static String get_native_struct_code(const StringName &p_name);
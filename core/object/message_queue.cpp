@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/os/thread.h"
 
 #include <stdio.h>
 
@@ -58,13 +59,132 @@
 		mutex.unlock();                           \
 	}
 
-void CallQueue::_add_page() {
-	if (pages_used == page_bytes.size()) {
-		pages.push_back(allocator->alloc());
-		page_bytes.push_back(0);
+// Pushes go either to the shared pages, guarded by the queue mutex, or to the
+// buffer of the pushing thread.
+#define LOCK_PUSH                                       \
+	ThreadBuffer *thread_buffer = _get_thread_buffer(); \
+	if (thread_buffer) {                                \
+		thread_buffer->mutex.lock();                    \
+	} else {                                            \
+		LOCK_MUTEX;                                     \
 	}
-	page_bytes[pages_used] = 0;
-	pages_used++;
+
+#define UNLOCK_PUSH                    \
+	if (thread_buffer) {               \
+		thread_buffer->mutex.unlock(); \
+	} else {                           \
+		UNLOCK_MUTEX;                  \
+	}
+
+#define ALLOCATE_MESSAGE(m_room_needed) \
+	(thread_buffer ? _allocate_message(*thread_buffer, m_room_needed) : _allocate_message(*this, m_room_needed))
+
+#define TAKE_SEQUENCE \
+	(thread_buffer ? _take_sequence(*thread_buffer) : _take_sequence(*this))
+
+// Compares tickets, tolerating wrap-around.
+static _FORCE_INLINE_ bool _sequence_before(uint32_t p_a, uint32_t p_b) {
+	return int32_t(p_a - p_b) < 0;
+}
+
+struct CallQueue::ThreadBufferCache {
+	uint32_t queue_id = 0;
+	ThreadBuffer *buffer = nullptr;
+
+	void release() {
+		if (buffer) {
+			buffer->orphaned.set();
+			if (buffer->refcount.unref()) {
+				memdelete(buffer);
+			}
+			buffer = nullptr;
+			queue_id = 0;
+		}
+	}
+
+	~ThreadBufferCache() {
+		release();
+	}
+};
+
+thread_local CallQueue::ThreadBufferCache CallQueue::thread_buffer_cache;
+
+static SafeNumeric<uint32_t> last_queue_id;
+
+bool CallQueue::_reserve_page() {
+	// Counted across all buffers, so the limit doesn't grow with the number of
+	// pushing threads.
+	if (total_pages_used.increment() > max_pages) {
+		total_pages_used.decrement();
+		return false;
+	}
+	return true;
+}
+
+template <typename T>
+uint8_t *CallQueue::_allocate_message(T &p_buffer, uint32_t p_room_needed) {
+	if (unlikely(p_buffer.pages.is_empty())) {
+		if (!_reserve_page()) {
+			return nullptr;
+		}
+		p_buffer.pages.push_back(allocator->alloc());
+		p_buffer.page_bytes.push_back(0);
+		p_buffer.pages_used = 1;
+	}
+
+	if ((p_buffer.page_bytes[p_buffer.pages_used - 1] + p_room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (!_reserve_page()) {
+			return nullptr;
+		}
+		if (p_buffer.pages_used == p_buffer.page_bytes.size()) {
+			p_buffer.pages.push_back(allocator->alloc());
+			p_buffer.page_bytes.push_back(0);
+		}
+		p_buffer.page_bytes[p_buffer.pages_used] = 0;
+		p_buffer.pages_used++;
+	}
+
+	uint8_t *room = &p_buffer.pages[p_buffer.pages_used - 1]->data[p_buffer.page_bytes[p_buffer.pages_used - 1]];
+	p_buffer.page_bytes[p_buffer.pages_used - 1] += p_room_needed;
+	return room;
+}
+
+template <typename T>
+uint32_t CallQueue::_take_sequence(T &p_buffer) {
+	// If no other buffer took a ticket since the last message of this one,
+	// nothing pushed elsewhere has to run in between, so the ticket is reused.
+	// Messages of the same buffer always run in push order anyway, and a thread
+	// pushing in bursts doesn't keep writing to the shared counter.
+	if (p_buffer.has_last_sequence && next_sequence.get() == p_buffer.last_sequence + 1) {
+		return p_buffer.last_sequence;
+	}
+	p_buffer.last_sequence = next_sequence.postincrement();
+	p_buffer.has_last_sequence = true;
+	return p_buffer.last_sequence;
+}
+
+CallQueue::ThreadBuffer *CallQueue::_get_thread_buffer() {
+	if (!use_thread_buffers || Thread::is_main_thread() || this == MessageQueue::thread_singleton) {
+		return nullptr;
+	}
+
+	if (likely(thread_buffer_cache.queue_id == queue_id)) {
+		return thread_buffer_cache.buffer;
+	}
+
+	// First push from this thread, or the queue it pushed to before is gone.
+	thread_buffer_cache.release();
+
+	ThreadBuffer *buffer = memnew(ThreadBuffer);
+	buffer->refcount.init(2);
+
+	mutex.lock();
+	thread_buffers.push_back(buffer);
+	mutex.unlock();
+
+	thread_buffer_cache.queue_id = queue_id;
+	thread_buffer_cache.buffer = buffer;
+	return buffer;
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -84,124 +204,103 @@ Error CallQueue::push_set(Object *p_object, const StringName &p_prop, const Vari
 }
 
 Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
+	return push_callablep(Callable(p_callable), p_args, p_argcount, p_show_error);
+}
+
+Error CallQueue::push_callablep(Callable &&p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
-
-	_ensure_first_page();
+	LOCK_PUSH;
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	uint8_t *buffer_end = ALLOCATE_MESSAGE(room_needed);
+	if (!buffer_end) {
+		fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		UNLOCK_PUSH;
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
+	msg->sequence = TAKE_SEQUENCE;
 	msg->args = p_argcount;
-	msg->callable = p_callable;
+	msg->callable = std::move(p_callable);
 	msg->type = TYPE_CALL;
 	if (p_show_error) {
 		msg->type |= FLAG_SHOW_ERROR;
 	}
 	// Support callables of static methods.
-	if (p_callable.get_object_id().is_null() && p_callable.is_valid()) {
+	if (msg->callable.get_object_id().is_null() && msg->callable.is_valid()) {
 		msg->type |= FLAG_NULL_IS_OK;
 	}
 
 	buffer_end += sizeof(Message);
 
 	for (int i = 0; i < p_argcount; i++) {
-		Variant *v = memnew_placement(buffer_end, Variant);
+		memnew_placement(buffer_end, Variant(*p_args[i]));
 		buffer_end += sizeof(Variant);
-		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
-
-	UNLOCK_MUTEX;
+	UNLOCK_PUSH;
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
+	LOCK_PUSH;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
+	uint8_t *buffer_end = ALLOCATE_MESSAGE(room_needed);
+	if (!buffer_end) {
+		String type;
+		if (ObjectDB::get_instance(p_id)) {
+			type = ObjectDB::get_instance(p_id)->get_class();
 		}
-		_add_page();
-	}
+		fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
+		UNLOCK_PUSH;
+		return ERR_OUT_OF_MEMORY;
+	}
 
 	Message *msg = memnew_placement(buffer_end, Message);
+	msg->sequence = TAKE_SEQUENCE;
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
 	msg->type = TYPE_SET;
 
 	buffer_end += sizeof(Message);
 
-	Variant *v = memnew_placement(buffer_end, Variant);
-	*v = p_value;
+	memnew_placement(buffer_end, Variant(p_value));
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	UNLOCK_PUSH;
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
+	LOCK_PUSH;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	uint8_t *buffer_end = ALLOCATE_MESSAGE(room_needed);
+	if (!buffer_end) {
+		fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		UNLOCK_PUSH;
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
+	msg->sequence = TAKE_SEQUENCE;
 
 	msg->type = TYPE_NOTIFICATION;
 	msg->callable = Callable(p_id, CoreStringName(notification)); //name is meaningless but callable needs it
 	//msg->target;
 	msg->notification = p_notification;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	UNLOCK_PUSH;
 
 	return OK;
 }
@@ -223,10 +322,139 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 	}
 }
 
+CallQueue::Message *CallQueue::_peek_shared_pages(uint32_t &r_page, uint32_t &r_offset) {
+	while (r_page < pages_used) {
+		if (r_offset < page_bytes[r_page]) {
+			return (Message *)&pages[r_page]->data[r_offset];
+		}
+		if (r_page + 1 == pages_used) {
+			break;
+		}
+		r_page++;
+		r_offset = 0;
+	}
+	return nullptr;
+}
+
+CallQueue::Message *CallQueue::_peek_thread_buffer(ThreadBuffer *p_buffer) {
+	// The owner thread only ever appends to its last page.
+	while (p_buffer->read_page < p_buffer->pages_used) {
+		if (p_buffer->read_offset < p_buffer->page_bytes[p_buffer->read_page]) {
+			return (Message *)&p_buffer->pages[p_buffer->read_page]->data[p_buffer->read_offset];
+		}
+		if (p_buffer->read_page + 1 == p_buffer->pages_used) {
+			break;
+		}
+		p_buffer->read_page++;
+		p_buffer->read_offset = 0;
+	}
+
+	// Drained. Flushing is not reentrant, so no message from this buffer is
+	// being called and its pages can be reused.
+	if (p_buffer->pages_used > 0) {
+		total_pages_used.sub(p_buffer->pages_used - 1);
+		p_buffer->pages_used = 1;
+		p_buffer->page_bytes[0] = 0;
+		p_buffer->read_page = 0;
+		p_buffer->read_offset = 0;
+	}
+	return nullptr;
+}
+
+bool CallQueue::_select_oldest_source(const Message *p_shared_head, ThreadBuffer *&r_source, uint32_t &r_limit) {
+	while (true) {
+		// Any message with a ticket below this one is either fully stored or
+		// being stored with its buffer locked, so peeking can't miss it.
+		const uint32_t sequence_bound = next_sequence.get();
+
+		// The shared pages are only pushed to with the queue mutex held, which
+		// the flushing thread holds, so their head is always below the bound.
+		bool found = p_shared_head != nullptr;
+		uint32_t oldest = found ? p_shared_head->sequence : 0;
+		bool found_next = false;
+		uint32_t next = 0; // Oldest ticket of the other sources.
+		bool newer_pending = false;
+		r_source = nullptr;
+
+		for (ThreadBuffer *buffer : thread_buffers) {
+			buffer->mutex.lock();
+			Message *head = _peek_thread_buffer(buffer);
+			uint32_t sequence = head ? head->sequence : 0;
+			buffer->mutex.unlock();
+
+			if (!head) {
+				continue;
+			}
+			if (!_sequence_before(sequence, sequence_bound)) {
+				newer_pending = true;
+				continue;
+			}
+			if (!found || _sequence_before(sequence, oldest)) {
+				if (found) {
+					next = oldest;
+					found_next = true;
+				}
+				oldest = sequence;
+				r_source = buffer;
+				found = true;
+			} else if (!found_next || _sequence_before(sequence, next)) {
+				next = sequence;
+				found_next = true;
+			}
+		}
+
+		if (found) {
+			r_limit = found_next ? next : sequence_bound;
+			return true;
+		}
+		if (!newer_pending) {
+			return false;
+		}
+		// Only found messages pushed while looking, look again.
+	}
+}
+
+void CallQueue::_destroy_message(Message *p_message) {
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int k = 0; k < p_message->args; k++) {
+			args[k].~Variant();
+		}
+	}
+
+	p_message->~Message();
+}
+
+void CallQueue::_clear_thread_buffer(ThreadBuffer *p_buffer) {
+	p_buffer->mutex.lock();
+	while (Message *message = _peek_thread_buffer(p_buffer)) {
+		uint32_t advance = sizeof(Message);
+		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+			advance += sizeof(Variant) * message->args;
+		}
+		p_buffer->read_offset += advance;
+		_destroy_message(message);
+	}
+	p_buffer->mutex.unlock();
+}
+
+void CallQueue::_free_thread_buffer(ThreadBuffer *p_buffer) {
+	for (Page *page : p_buffer->pages) {
+		allocator->free(page);
+	}
+	p_buffer->pages.clear();
+	p_buffer->page_bytes.clear();
+	total_pages_used.sub(p_buffer->pages_used);
+	p_buffer->pages_used = 0;
+	if (p_buffer->refcount.unref()) {
+		memdelete(p_buffer);
+	}
+}
+
 Error CallQueue::flush() {
 	LOCK_MUTEX;
 
-	if (pages.size() == 0) {
+	if (pages.size() == 0 && thread_buffers.is_empty()) {
 		// Never allocated
 		UNLOCK_MUTEX;
 		return OK; // Do nothing.
@@ -242,63 +470,99 @@ Error CallQueue::flush() {
 	uint32_t i = 0;
 	uint32_t offset = 0;
 
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
+	while (true) {
+		// Find the source holding the oldest message, then run its messages up
+		// to the oldest one of the other sources before looking at them again.
+		Message *message = _peek_shared_pages(i, offset);
+		ThreadBuffer *source = nullptr;
+		uint32_t limit = 0;
+		bool limited = !thread_buffers.is_empty();
+		if (limited) {
+			if (!_select_oldest_source(message, source, limit)) {
+				break;
+			}
+		} else if (!message) {
+			break;
+		}
 
-		//lock on each iteration, so a call can re-add itself to the message queue
+		while (true) {
+			//lock on each iteration, so a call can re-add itself to the message queue
 
-		Message *message = (Message *)&page->data[offset];
+			if (source) {
+				source->mutex.lock();
+				message = _peek_thread_buffer(source);
+				source->mutex.unlock();
+			} else {
+				message = _peek_shared_pages(i, offset);
+			}
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
-		}
+			if (!message || (limited && !_sequence_before(message->sequence, limit))) {
+				break;
+			}
 
-		//pre-advance so this function is reentrant
-		offset += advance;
+			uint32_t advance = sizeof(Message);
+			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+				advance += sizeof(Variant) * message->args;
+			}
 
-		Object *target = message->callable.get_object();
+			//pre-advance so this function is reentrant
+			if (source) {
+				source->read_offset += advance;
+			} else {
+				offset += advance;
+			}
 
-		UNLOCK_MUTEX;
+			Object *target = message->callable.get_object();
 
-		switch (message->type & FLAG_MASK) {
-			case TYPE_CALL: {
-				if (target || (message->type & FLAG_NULL_IS_OK)) {
-					Variant *args = (Variant *)(message + 1);
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
-				}
-			} break;
-			case TYPE_NOTIFICATION: {
-				if (target) {
-					target->notification(message->notification);
-				}
-			} break;
-			case TYPE_SET: {
-				if (target) {
-					Variant *arg = (Variant *)(message + 1);
-					target->set(message->callable.get_method(), *arg);
-				}
-			} break;
-		}
+			UNLOCK_MUTEX;
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
+			switch (message->type & FLAG_MASK) {
+				case TYPE_CALL: {
+					if (target || (message->type & FLAG_NULL_IS_OK)) {
+						Variant *args = (Variant *)(message + 1);
+						_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+					}
+				} break;
+				case TYPE_NOTIFICATION: {
+					if (target) {
+						target->notification(message->notification);
+					}
+				} break;
+				case TYPE_SET: {
+					if (target) {
+						Variant *arg = (Variant *)(message + 1);
+						target->set(message->callable.get_method(), *arg);
+					}
+				} break;
 			}
-		}
 
-		message->~Message();
+			_destroy_message(message);
 
-		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
-			i++;
-			offset = 0;
+			LOCK_MUTEX;
 		}
 	}
 
-	page_bytes[0] = 0;
-	pages_used = 1;
+	if (!pages.is_empty()) {
+		total_pages_used.sub(pages_used - 1);
+		page_bytes[0] = 0;
+		pages_used = 1;
+	}
+
+	// Let go of the buffers of threads that exited, once drained.
+	for (uint32_t j = 0; j < thread_buffers.size(); j++) {
+		ThreadBuffer *buffer = thread_buffers[j];
+		if (!buffer->orphaned.is_set()) {
+			continue;
+		}
+		buffer->mutex.lock();
+		bool drained = _peek_thread_buffer(buffer) == nullptr;
+		buffer->mutex.unlock();
+		if (drained) {
+			thread_buffers.remove_at_unordered(j);
+			j--;
+			_free_thread_buffer(buffer);
+		}
+	}
 
 	flushing = false;
 	UNLOCK_MUTEX;
@@ -308,6 +572,10 @@ Error CallQueue::flush() {
 void CallQueue::clear() {
 	LOCK_MUTEX;
 
+	for (ThreadBuffer *buffer : thread_buffers) {
+		_clear_thread_buffer(buffer);
+	}
+
 	if (pages.size() == 0) {
 		UNLOCK_MUTEX;
 		return; // Nothing to clear.
@@ -329,17 +597,11 @@ void CallQueue::clear() {
 
 			offset += advance;
 
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
-
-			message->~Message();
+			_destroy_message(message);
 		}
 	}
 
+	total_pages_used.sub(pages_used - 1);
 	pages_used = 1;
 	page_bytes[0] = 0;
 
@@ -446,21 +708,42 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
-	if (pages_used == 0) {
-		return false;
+	if (pages_used > 1 || (pages_used == 1 && page_bytes[0] > 0)) {
+		return true;
 	}
-	if (pages_used == 1 && page_bytes[0] == 0) {
+
+	if (!use_thread_buffers) {
 		return false;
 	}
 
-	return true;
+	bool found = false;
+	mutex.lock();
+	for (ThreadBuffer *buffer : thread_buffers) {
+		buffer->mutex.lock();
+		found = buffer->read_page + 1 < buffer->pages_used || (buffer->read_page < buffer->pages_used && buffer->read_offset < buffer->page_bytes[buffer->read_page]);
+		buffer->mutex.unlock();
+		if (found) {
+			break;
+		}
+	}
+	mutex.unlock();
+
+	return found;
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	int page_count = pages.size();
+	if (use_thread_buffers) {
+		mutex.lock();
+		for (ThreadBuffer *buffer : thread_buffers) {
+			page_count += buffer->pages.size();
+		}
+		mutex.unlock();
+	}
+	return page_count * PAGE_SIZE_BYTES;
 }
 
-CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
+CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text, bool p_use_thread_buffers) {
 	if (p_custom_allocator) {
 		allocator = p_custom_allocator;
 		allocator_is_custom = true;
@@ -470,6 +753,8 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 	}
 	max_pages = p_max_pages;
 	error_text = p_error_text;
+	use_thread_buffers = p_use_thread_buffers;
+	queue_id = last_queue_id.increment();
 }
 
 CallQueue::~CallQueue() {
@@ -478,6 +763,9 @@ CallQueue::~CallQueue() {
 	for (uint32_t i = 0; i < pages.size(); i++) {
 		allocator->free(pages[i]);
 	}
+	for (ThreadBuffer *buffer : thread_buffers) {
+		_free_thread_buffer(buffer);
+	}
 	if (!allocator_is_custom) {
 		memdelete(allocator);
 	}
@@ -506,7 +794,8 @@ void MessageQueue::set_thread_singleton_override(CallQueue *p_thread_singleton)
 MessageQueue::MessageQueue() :
 		CallQueue(nullptr,
 				int(GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "memory/limits/message_queue/max_size_mb", PROPERTY_HINT_RANGE, "1,512,1,or_greater"), 32)) * 1024 * 1024 / PAGE_SIZE_BYTES,
-				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.") {
+				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.",
+				true) {
 	ERR_FAIL_COND_MSG(main_singleton != nullptr, "A MessageQueue singleton already exists.");
 	main_singleton = this;
 }
@@ -35,6 +35,7 @@
 #include "core/os/thread_safe.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
 class Object;
@@ -75,6 +76,8 @@ private:
 	LocalVector<uint32_t> page_bytes;
 	uint32_t max_pages = 0;
 	uint32_t pages_used = 0;
+	uint32_t last_sequence = 0;
+	bool has_last_sequence = false;
 	bool flushing = false;
 
 #ifdef DEV_ENABLED
@@ -88,17 +91,52 @@ private:
 			int16_t notification;
 			int16_t args;
 		};
+		uint32_t sequence; // Push order, used to merge the thread buffers.
 	};
 
-	_FORCE_INLINE_ void _ensure_first_page() {
-		if (unlikely(pages.is_empty())) {
-			pages.push_back(allocator->alloc());
-			page_bytes.push_back(0);
-			pages_used = 1;
-		}
-	}
+	// When enabled, messages pushed from threads other than the main one are
+	// stored in pages owned by the pushing thread, so they don't contend on the
+	// queue mutex. Every message takes a ticket from `next_sequence` while its
+	// buffer is locked, and flushing always runs the message with the lowest
+	// ticket first, so the execution order is the same as the push order.
+	// Consecutive messages of a buffer share a ticket when no other buffer took
+	// one in between, see _take_sequence().
+	struct ThreadBuffer {
+		BinaryMutex mutex;
+		LocalVector<Page *> pages;
+		LocalVector<uint32_t> page_bytes;
+		uint32_t pages_used = 0;
+		uint32_t last_sequence = 0;
+		bool has_last_sequence = false;
+		// Only accessed by the flushing thread.
+		uint32_t read_page = 0;
+		uint32_t read_offset = 0;
+		SafeFlag orphaned; // Set when the owner thread exits.
+		SafeRefCount refcount; // Held by the queue and the owner thread.
+	};
 
-	void _add_page();
+	struct ThreadBufferCache;
+	static thread_local ThreadBufferCache thread_buffer_cache;
+
+	bool use_thread_buffers = false;
+	uint32_t queue_id = 0;
+	SafeNumeric<uint32_t> next_sequence;
+	SafeNumeric<uint32_t> total_pages_used; // In all buffers, limited by `max_pages`.
+	LocalVector<ThreadBuffer *> thread_buffers;
+
+	bool _reserve_page();
+	template <typename T>
+	uint8_t *_allocate_message(T &p_buffer, uint32_t p_room_needed);
+	template <typename T>
+	uint32_t _take_sequence(T &p_buffer);
+
+	ThreadBuffer *_get_thread_buffer();
+	Message *_peek_shared_pages(uint32_t &r_page, uint32_t &r_offset);
+	Message *_peek_thread_buffer(ThreadBuffer *p_buffer);
+	bool _select_oldest_source(const Message *p_shared_head, ThreadBuffer *&r_source, uint32_t &r_limit);
+	void _clear_thread_buffer(ThreadBuffer *p_buffer);
+	void _free_thread_buffer(ThreadBuffer *p_buffer);
+	void _destroy_message(Message *p_message);
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -117,6 +155,7 @@ public:
 	}
 
 	Error push_callablep(const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error = false);
+	Error push_callablep(Callable &&p_callable, const Variant **p_args, int p_argcount, bool p_show_error = false);
 	Error push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value);
 	Error push_notification(ObjectID p_id, int p_notification);
 
@@ -153,7 +192,7 @@ public:
 	bool is_flushing() const;
 	int get_max_buffer_usage() const;
 
-	CallQueue(Allocator *p_custom_allocator = 0, uint32_t p_max_pages = 8192, const String &p_error_text = String());
+	CallQueue(Allocator *p_custom_allocator = 0, uint32_t p_max_pages = 8192, const String &p_error_text = String(), bool p_use_thread_buffers = false);
 	virtual ~CallQueue();
 };
 
@@ -35,6 +35,7 @@
 #include "core/io/resource.h"
 #include "core/object/class_db.h"
 #include "core/object/message_queue.h"
+#include "core/object/object_inline_cache.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
@@ -894,6 +895,93 @@ Variant Object::call_const(const StringName &p_method, const Variant **p_args, i
 	return ret;
 }
 
+Variant Object::callp_cached(ObjectInlineCache &r_cache, const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+	const void *class_key = &get_class_name();
+	const void *script_key = script_instance ? script.operator Object *() : nullptr;
+	if (unlikely(script_instance && !script_key)) {
+		return callp(p_method, p_args, p_argcount, r_error); // Can't be keyed.
+	}
+
+	MethodBind *method = nullptr;
+	if (unlikely(!r_cache.lookup(class_key, script_key, method))) {
+		uint32_t generation = ObjectInlineCache::get_generation();
+		if (p_method != CoreStringName(free_) && !_has_custom_callp() &&
+				(!script_instance || script_instance->defers_to_native(p_method, ObjectInlineCache::ACCESS_CALL))) {
+			method = ClassDB::get_method(get_class_name(), p_method);
+		}
+		r_cache.store(class_key, script_key, method, generation);
+	}
+	if (!method) {
+		return callp(p_method, p_args, p_argcount, r_error);
+	}
+
+	r_error.error = Callable::CallError::CALL_OK;
+	OBJ_DEBUG_LOCK
+	return method->call(this, p_args, p_argcount, r_error);
+}
+
+void Object::set_cached(ObjectInlineCache &r_cache, const StringName &p_name, const Variant &p_value, bool *r_valid) {
+	const void *class_key = &get_class_name();
+	const void *script_key = script_instance ? script.operator Object *() : nullptr;
+	if (unlikely(script_instance && !script_key)) {
+		set(p_name, p_value, r_valid);
+		return;
+	}
+
+	MethodBind *setter = nullptr;
+	if (unlikely(!r_cache.lookup(class_key, script_key, setter))) {
+		uint32_t generation = ObjectInlineCache::get_generation();
+		if (!(_extension && _extension->set) &&
+				(!script_instance || script_instance->defers_to_native(p_name, ObjectInlineCache::ACCESS_SET))) {
+			setter = ClassDB::get_property_setter_bind(get_class_name(), p_name);
+		}
+		r_cache.store(class_key, script_key, setter, generation);
+	}
+	if (!setter) {
+		set(p_name, p_value, r_valid);
+		return;
+	}
+
+#ifdef TOOLS_ENABLED
+	_edited = true;
+#endif
+
+	Callable::CallError ce;
+	const Variant *arg[1] = { &p_value };
+	setter->call(this, arg, 1, ce);
+	if (r_valid) {
+		*r_valid = ce.error == Callable::CallError::CALL_OK;
+	}
+}
+
+Variant Object::get_cached(ObjectInlineCache &r_cache, const StringName &p_name, bool *r_valid) const {
+	const void *class_key = &get_class_name();
+	const void *script_key = script_instance ? script.operator Object *() : nullptr;
+	if (unlikely(script_instance && !script_key)) {
+		return get(p_name, r_valid);
+	}
+
+	MethodBind *getter = nullptr;
+	if (unlikely(!r_cache.lookup(class_key, script_key, getter))) {
+		uint32_t generation = ObjectInlineCache::get_generation();
+		if (!(_extension && _extension->get) &&
+				(!script_instance || script_instance->defers_to_native(p_name, ObjectInlineCache::ACCESS_GET))) {
+			getter = ClassDB::get_property_getter_bind(get_class_name(), p_name);
+		}
+		r_cache.store(class_key, script_key, getter, generation);
+	}
+	if (!getter) {
+		return get(p_name, r_valid);
+	}
+
+	Callable::CallError ce;
+	Variant ret = getter->call(const_cast<Object *>(this), nullptr, 0, ce);
+	if (r_valid) {
+		*r_valid = true;
+	}
+	return ret;
+}
+
 void Object::notification(int p_notification, bool p_reversed) {
 	if (p_reversed) {
 		if (script_instance) {
@@ -1109,6 +1197,7 @@ void Object::_remove_user_signal(const StringName &p_name) {
 	SignalData *s = signal_map.getptr(p_name);
 	ERR_FAIL_NULL_MSG(s, "Provided signal does not exist.");
 	ERR_FAIL_COND_MSG(!s->removable, "Signal is not removable (not added with add_user_signal).");
+	ERR_FAIL_COND_MSG(s->pinned, "Signal is not removable while referenced by a SignalID.");
 	for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
 		Object *target = slot_kv.key.get_object();
 		if (likely(target)) {
@@ -1163,35 +1252,82 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		return ERR_UNAVAILABLE;
 	}
 
+	return _emit_signal_data(s, p_name, p_args, p_argcount);
+}
+
+Object::SignalID Object::get_signal_id(const StringName &p_name) {
+	SignalData *s = signal_map.getptr(p_name);
+	if (!s) {
+		bool signal_is_valid = ClassDB::has_signal(get_class_name(), p_name) ||
+				(!script.is_null() && Ref<Script>(script)->has_script_signal(p_name));
+		ERR_FAIL_COND_V_MSG(!signal_is_valid, SignalID(), "In Object of type '" + String(get_class()) + "': Attempt to get the ID of nonexistent signal '" + p_name + "'.");
+
+		s = &signal_map[p_name];
+	}
+
+	// SignalData entries are not moved by the map, only erased, and pinned ones are kept.
+	s->pinned = true;
+	return SignalID(this, s, p_name);
+}
+
+Error Object::emit_signalp(const SignalID &p_signal, const Variant **p_args, int p_argcount) {
+	ERR_FAIL_COND_V_MSG(p_signal.owner != this, ERR_INVALID_PARAMETER, "Can't emit signal '" + p_signal.name + "' with an ID obtained from another object.");
+
+	if (_block_signals) {
+		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
+	}
+
+	return _emit_signal_data(p_signal.data, p_signal.name, p_args, p_argcount);
+}
+
+Error Object::_emit_signal_data(SignalData *p_data, const StringName &p_name, const Variant **p_args, int p_argcount) {
+	if (unlikely(p_data->targets_dirty)) {
+		// Only emissions following a connection change allocate.
+		Vector<SignalData::Target> targets;
+		targets.resize(p_data->slot_map.size());
+		SignalData::Target *targets_ptrw = targets.ptrw();
+		uint32_t target_count = 0;
+		p_data->has_one_shot = false;
+		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : p_data->slot_map) {
+			targets_ptrw[target_count].callable = slot_kv.value.conn.callable;
+			targets_ptrw[target_count].flags = slot_kv.value.conn.flags;
+			p_data->has_one_shot = p_data->has_one_shot || (slot_kv.value.conn.flags & CONNECT_ONE_SHOT);
+			++target_count;
+		}
+		DEV_ASSERT(target_count == p_data->slot_map.size());
+		p_data->targets = targets;
+		p_data->targets_dirty = false;
+	}
+
+	if (p_data->targets.is_empty()) {
+		return OK;
+	}
+
 	// If this is a ref-counted object, prevent it from being destroyed during signal emission,
 	// which is needed in certain edge cases; e.g., https://github.com/godotengine/godot/issues/73889.
 	Ref<RefCounted> rc = Ref<RefCounted>(Object::cast_to<RefCounted>(this));
 
 	// Ensure that disconnecting the signal or even deleting the object
-	// will not affect the signal calling.
-	Callable *slot_callables = (Callable *)alloca(sizeof(Callable) * s->slot_map.size());
-	uint32_t *slot_flags = (uint32_t *)alloca(sizeof(uint32_t) * s->slot_map.size());
-	uint32_t slot_count = 0;
-
-	for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-		memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-		slot_flags[slot_count] = slot_kv.value.conn.flags;
-		++slot_count;
-	}
-
-	DEV_ASSERT(slot_count == s->slot_map.size());
+	// will not affect the signal calling. Holding a reference is enough, as
+	// the list is replaced rather than modified when connections change.
+	const Vector<SignalData::Target> targets = p_data->targets;
+	const SignalData::Target *slots = targets.ptr();
+	const uint32_t slot_count = targets.size();
 
 	// Disconnect all one-shot connections before emitting to prevent recursion.
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+	// This may erase p_data, which is not used past this point.
+	if (p_data->has_one_shot) {
+		for (uint32_t i = 0; i < slot_count; ++i) {
+			bool disconnect = slots[i].flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-		if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
-			// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
-			disconnect = false;
-		}
+			if (disconnect && (slots[i].flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+				// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
+				disconnect = false;
+			}
 #endif
-		if (disconnect) {
-			_disconnect(p_name, slot_callables[i]);
+			if (disconnect) {
+				_disconnect(p_name, slots[i].callable);
+			}
 		}
 	}
 
@@ -1200,8 +1336,8 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 	Error err = OK;
 
 	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
+		const Callable &callable = slots[i].callable;
+		const uint32_t &flags = slots[i].flags;
 
 		if (!callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
@@ -1237,10 +1373,6 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
-
 	return err;
 }
 
@@ -1454,6 +1586,10 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	// Drop the cached targets right away, so disconnected callables (and their bound
+	// arguments) aren't kept alive until the next emission.
+	s->targets = Vector<SignalData::Target>();
+	s->targets_dirty = true;
 
 	return OK;
 }
@@ -1511,8 +1647,12 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	// Drop the cached targets right away, so disconnected callables (and their bound
+	// arguments) aren't kept alive until the next emission.
+	s->targets = Vector<SignalData::Target>();
+	s->targets_dirty = true;
 
-	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
+	if (s->slot_map.is_empty() && !s->pinned && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
 		signal_map.erase(p_signal);
 	}
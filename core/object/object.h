@@ -574,6 +574,7 @@ public:                                                                 \
                                                                         \
 private:
 
+class ObjectInlineCache;
 class ScriptInstance;
 
 class Object {
@@ -618,9 +619,20 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		// Connections in call order, cleared when they change and rebuilt by the next emission.
+		// Emissions hold a reference to it, so connecting or disconnecting meanwhile doesn't affect them.
+		struct Target {
+			Callable callable;
+			uint32_t flags = 0;
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
+		Vector<Target> targets;
+		bool targets_dirty = true;
+		bool has_one_shot = false;
 		bool removable = false;
+		bool pinned = false; // Referenced by a SignalID, kept even without connections.
 	};
 
 	HashMap<StringName, SignalData> signal_map;
@@ -650,6 +662,7 @@ private:
 	bool _has_user_signal(const StringName &p_name) const;
 	void _remove_user_signal(const StringName &p_name);
 	Error _emit_signal(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	Error _emit_signal_data(SignalData *p_data, const StringName &p_name, const Variant **p_args, int p_argcount);
 	TypedArray<Dictionary> _get_signal_list() const;
 	TypedArray<Dictionary> _get_signal_connection_list(const StringName &p_signal) const;
 	TypedArray<Dictionary> _get_incoming_connections() const;
@@ -752,6 +765,10 @@ protected:
 	Variant _call_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Variant _call_deferred_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
+	// Classes overriding callp() to handle methods that ClassDB doesn't know about
+	// must return true, so callp_cached() never bypasses them.
+	virtual bool _has_custom_callp() const { return false; }
+
 	virtual const StringName *_get_class_namev() const {
 		static StringName _class_name_static;
 		if (unlikely(!_class_name_static)) {
@@ -875,6 +892,12 @@ public:
 	virtual Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	virtual Variant call_const(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
+	// Same as callp(), set() and get(), but the native method is resolved through a
+	// per-call-site cache. A cache must always be used with the same name.
+	Variant callp_cached(ObjectInlineCache &r_cache, const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	void set_cached(ObjectInlineCache &r_cache, const StringName &p_name, const Variant &p_value, bool *r_valid = nullptr);
+	Variant get_cached(ObjectInlineCache &r_cache, const StringName &p_name, bool *r_valid = nullptr) const;
+
 	template <typename... VarArgs>
 	Variant call(const StringName &p_method, VarArgs... p_args) {
 		Variant args[sizeof...(p_args) + 1] = { p_args..., Variant() }; // +1 makes sure zero sized arrays are also supported.
@@ -926,6 +949,25 @@ public:
 
 	void add_user_signal(const MethodInfo &p_signal);
 
+	// A signal of this object resolved once with get_signal_id(), so emitting it skips the lookup
+	// by name. It is only valid with the object it was obtained from, and must not outlive it.
+	class SignalID {
+		friend class Object;
+
+		Object *owner = nullptr;
+		SignalData *data = nullptr;
+		StringName name;
+
+		SignalID(Object *p_owner, SignalData *p_data, const StringName &p_name) :
+				owner(p_owner), data(p_data), name(p_name) {}
+
+	public:
+		_FORCE_INLINE_ bool is_valid() const { return data != nullptr; }
+		_FORCE_INLINE_ const StringName &get_name() const { return name; }
+
+		SignalID() {}
+	};
+
 	template <typename... VarArgs>
 	Error emit_signal(const StringName &p_name, VarArgs... p_args) {
 		Variant args[sizeof...(p_args) + 1] = { p_args..., Variant() }; // +1 makes sure zero sized arrays are also supported.
@@ -936,7 +978,20 @@ public:
 		return emit_signalp(p_name, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
 	}
 
+	template <typename... VarArgs>
+	Error emit_signal(const SignalID &p_signal, VarArgs... p_args) {
+		Variant args[sizeof...(p_args) + 1] = { p_args..., Variant() }; // +1 makes sure zero sized arrays are also supported.
+		const Variant *argptrs[sizeof...(p_args) + 1];
+		for (uint32_t i = 0; i < sizeof...(p_args); i++) {
+			argptrs[i] = &args[i];
+		}
+		return emit_signalp(p_signal, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
+	}
+
+	SignalID get_signal_id(const StringName &p_name);
+
 	MTVIRTUAL Error emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount);
+	MTVIRTUAL Error emit_signalp(const SignalID &p_signal, const Variant **p_args, int p_argcount);
 	MTVIRTUAL bool has_signal(const StringName &p_name) const;
 	MTVIRTUAL void get_signal_list(List<MethodInfo> *p_signals) const;
 	MTVIRTUAL void get_signal_connection_list(const StringName &p_signal, List<Connection> *p_connections) const;
@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  object_inline_cache.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef OBJECT_INLINE_CACHE_H
+#define OBJECT_INLINE_CACHE_H
+
+#include "core/typedefs.h"
+
+#include <atomic>
+
+class MethodBind;
+
+// Per-call-site cache for dynamic calls, property sets and gets on objects.
+// A call site (e.g. a GDScript instruction) keeps one of these and passes it to
+// Object::callp_cached(), set_cached() or get_cached(). The cache remembers the
+// native MethodBind resolved for the last (class, script) pair seen at the
+// site, so monomorphic sites skip the ClassDB hash lookups and script lookups.
+// When the script (or a custom callp(), set() or get()) handles the name
+// instead, the entry remembers that too, so the site goes straight to the
+// generic path without asking the script again.
+//
+// Entries are read and filled concurrently from any thread. Filling is a
+// seqlock: a reader that races with a writer simply misses and takes the slow
+// path. Any change to ClassDB or to a script that could make an entry stale
+// calls invalidate_all(), which drops every entry at once.
+class ObjectInlineCache {
+public:
+	enum Access {
+		ACCESS_CALL,
+		ACCESS_GET,
+		ACCESS_SET,
+	};
+
+private:
+	static std::atomic<uint32_t> generation;
+
+	std::atomic<uint32_t> sequence = { 0 };
+	std::atomic<uint32_t> entry_generation = { 0 };
+	std::atomic<const void *> class_key = { nullptr };
+	std::atomic<const void *> script_key = { nullptr };
+	std::atomic<MethodBind *> method = { nullptr };
+
+public:
+	static void invalidate_all() { generation.fetch_add(1, std::memory_order_acq_rel); }
+	_FORCE_INLINE_ static uint32_t get_generation() { return generation.load(std::memory_order_acquire); }
+
+	// Returns true if there is an entry for the given keys. r_method is set to
+	// the cached method, or to nullptr if the generic path must be taken.
+	_FORCE_INLINE_ bool lookup(const void *p_class_key, const void *p_script_key, MethodBind *&r_method) const {
+		uint32_t seq = sequence.load(std::memory_order_acquire);
+		if (seq & 1) {
+			return false;
+		}
+		MethodBind *ret = method.load(std::memory_order_relaxed);
+		bool hit = class_key.load(std::memory_order_relaxed) == p_class_key &&
+				script_key.load(std::memory_order_relaxed) == p_script_key &&
+				entry_generation.load(std::memory_order_relaxed) == get_generation();
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (!hit || sequence.load(std::memory_order_relaxed) != seq) {
+			return false;
+		}
+		r_method = ret;
+		return true;
+	}
+
+	// p_generation must be read with get_generation() before resolving p_method,
+	// so a result computed before an invalidation is never cached as current.
+	// A null p_method caches the generic path.
+	void store(const void *p_class_key, const void *p_script_key, MethodBind *p_method, uint32_t p_generation) {
+		uint32_t seq = sequence.load(std::memory_order_relaxed);
+		if ((seq & 1) || !sequence.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) {
+			return; // Another thread is filling this entry.
+		}
+		std::atomic_thread_fence(std::memory_order_release);
+		class_key.store(p_class_key, std::memory_order_relaxed);
+		script_key.store(p_script_key, std::memory_order_relaxed);
+		method.store(p_method, std::memory_order_relaxed);
+		entry_generation.store(p_generation, std::memory_order_relaxed);
+		sequence.store(seq + 2, std::memory_order_release);
+	}
+};
+
+#endif // OBJECT_INLINE_CACHE_H
@@ -31,6 +31,7 @@
 #ifndef SCRIPT_INSTANCE_H
 #define SCRIPT_INSTANCE_H
 
+#include "core/object/object_inline_cache.h"
 #include "core/object/ref_counted.h"
 
 class Script;
@@ -57,6 +58,12 @@ public:
 
 	virtual Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) = 0;
 
+	// Returns true if this instance never handles p_name itself for the given
+	// access, so callers can go straight to the native class. Inline caches rely
+	// on the answer only depending on the script, and only changing together with
+	// a call to ObjectInlineCache::invalidate_all().
+	virtual bool defers_to_native(const StringName &p_name, ObjectInlineCache::Access p_access) const { return false; }
+
 	template <typename... VarArgs>
 	Variant call(const StringName &p_method, VarArgs... p_args) {
 		Variant args[sizeof...(p_args) + 1] = { p_args..., Variant() }; // +1 makes sure zero sized arrays are also supported.
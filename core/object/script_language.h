@@ -112,6 +112,7 @@ class Script : public Resource {
 
 protected:
 	virtual bool editor_can_reload_from_file() override { return false; } // this is handled by editor better
+	virtual bool _has_custom_callp() const override { return true; } // Languages dispatch static methods in callp().
 	void _notification(int p_what);
 	static void _bind_methods();
 
@@ -83,7 +83,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 	if (p_task->group) {
 		// Handling a group
-		bool do_post = false;
+		bool do_post = p_task->group->max == 0; // Empty group that was waiting for dependencies.
 
 		while (true) {
 			uint32_t work_index = p_task->group->index.postincrement();
@@ -112,8 +112,11 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		if (do_post) {
-			p_task->group->done_semaphore.post();
+			task_mutex.lock();
 			p_task->group->completed.set_to(true);
+			_release_dependents(p_task->group->dependent_tasks, p_task->group->dependent_groups);
+			task_mutex.unlock();
+			p_task->group->done_semaphore.post();
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
@@ -142,6 +145,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		task_mutex.lock();
 		p_task->completed = true;
 		p_task->pool_thread_index = -1;
+		_release_dependents(p_task->dependent_tasks, p_task->dependent_groups);
 		if (p_task->waiting_user) {
 			p_task->done_semaphore.post(p_task->waiting_user);
 		}
@@ -178,8 +182,9 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Fast path: own queue first, then other threads', without taking the mutex.
+		Task *task_to_process = singleton->_pop_local_task(thread_data);
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 			if (singleton->exit_threads) {
 				return;
@@ -190,8 +195,13 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 				task_to_process = singleton->task_queue.first()->self();
 				singleton->task_queue.remove(singleton->task_queue.first());
 			} else {
-				thread_data->cond_var.wait(lock);
-				DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
+				// Check again with the mutex held. Tasks are pushed to the local queues
+				// with it held as well, so a notification can't be missed in between.
+				task_to_process = singleton->_pop_local_task(thread_data);
+				if (!task_to_process) {
+					thread_data->cond_var.wait(lock);
+					DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
+				}
 			}
 		}
 
@@ -214,6 +224,13 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 		return;
 	}
 
+	_post_tasks(p_tasks, p_count, p_high_priority);
+
+	task_mutex.unlock();
+}
+
+void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority) {
+	// Must be called with task_mutex locked.
 	uint32_t to_process = 0;
 	uint32_t to_promote = 0;
 
@@ -222,7 +239,11 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			// Tasks posted from a pool thread go to its own queue, so they can be taken without
+			// contending on the mutex. If that's full, or this is not a pool thread, use the shared one.
+			if (!caller_pool_thread || !caller_pool_thread->local_queue.push(p_tasks[i])) {
+				task_queue.add_last(&p_tasks[i]->task_elem);
+			}
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -235,8 +256,76 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 	}
 
 	_notify_threads(caller_pool_thread, to_process, to_promote);
+}
 
-	task_mutex.unlock();
+bool WorkerThreadPool::_are_dependencies_valid(const LocalVector<TaskID> &p_dependencies) const {
+	// Must be called with task_mutex locked.
+	for (TaskID dependency_id : p_dependencies) {
+		if (!tasks.has(dependency_id) && !groups.has(dependency_id)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+uint32_t WorkerThreadPool::_register_dependencies(const LocalVector<TaskID> &p_dependencies, Task *p_task, Group *p_group) {
+	// Must be called with task_mutex locked. Exactly one of p_task and p_group is expected.
+	uint32_t pending = 0;
+	for (TaskID dependency_id : p_dependencies) {
+		LocalVector<Task *> *dependent_tasks = nullptr;
+		LocalVector<Group *> *dependent_groups = nullptr;
+
+		Task **taskp = tasks.getptr(dependency_id);
+		if (taskp) {
+			if ((*taskp)->completed) {
+				continue;
+			}
+			dependent_tasks = &(*taskp)->dependent_tasks;
+			dependent_groups = &(*taskp)->dependent_groups;
+		} else {
+			Group **groupp = groups.getptr(dependency_id);
+			DEV_ASSERT(groupp); // Checked by _are_dependencies_valid().
+			if ((*groupp)->completed.is_set()) {
+				continue;
+			}
+			dependent_tasks = &(*groupp)->dependent_tasks;
+			dependent_groups = &(*groupp)->dependent_groups;
+		}
+
+		if (p_task) {
+			dependent_tasks->push_back(p_task);
+		} else {
+			dependent_groups->push_back(p_group);
+		}
+		pending++;
+	}
+
+	if (p_task) {
+		p_task->pending_dependencies = pending;
+	} else {
+		p_group->pending_dependencies = pending;
+	}
+	return pending;
+}
+
+void WorkerThreadPool::_release_dependents(LocalVector<Task *> &p_tasks, LocalVector<Group *> &p_groups) {
+	// Must be called with task_mutex locked.
+	for (Task *task : p_tasks) {
+		DEV_ASSERT(task->pending_dependencies > 0);
+		if (--task->pending_dependencies == 0) {
+			_post_tasks(&task, 1, !task->low_priority);
+		}
+	}
+	p_tasks.clear();
+
+	for (Group *group : p_groups) {
+		DEV_ASSERT(group->pending_dependencies > 0);
+		if (--group->pending_dependencies == 0) {
+			_post_tasks(group->deferred_tasks.ptr(), group->deferred_tasks.size(), !group->low_priority);
+			group->deferred_tasks.clear();
+		}
+	}
+	p_groups.clear();
 }
 
 void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count) {
@@ -303,6 +392,26 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_pop_local_task(ThreadData *p_thread) {
+	Task *task = nullptr;
+	if (p_thread->local_queue.pop(task)) {
+		return task;
+	}
+
+	// Steal from the others, starting at the next one to spread thieves across victims.
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		ThreadData &victim = threads[(p_thread->index + i) % thread_count];
+		while (!victim.local_queue.is_empty()) {
+			if (victim.local_queue.steal(task)) {
+				return task;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -319,8 +428,19 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_with_dependencies(void (*p_func)(void *), void *p_userdata, const LocalVector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const LocalVector<TaskID> &p_dependencies) {
 	task_mutex.lock();
+	if (unlikely(!_are_dependencies_valid(p_dependencies))) {
+		task_mutex.unlock();
+		if (p_template_userdata) {
+			memdelete(p_template_userdata);
+		}
+		ERR_FAIL_V_MSG(INVALID_TASK_ID, "Invalid dependency ID. Dependencies must be tasks or groups that haven't been awaited yet.");
+	}
 	// Get a free task
 	Task *task = task_allocator.alloc();
 	TaskID id = last_task++;
@@ -330,8 +450,15 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->native_func_userdata = p_userdata;
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
+	task->low_priority = !p_high_priority;
 	tasks.insert(id, task);
 
+	if (_register_dependencies(p_dependencies, task, nullptr)) {
+		// Will be posted once the last dependency completes.
+		task_mutex.unlock();
+		return id;
+	}
+
 	_post_tasks_and_unlock(&task, 1, p_high_priority);
 
 	return id;
@@ -341,6 +468,10 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bo
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_task_with_dependencies(const Callable &p_action, const LocalVector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	task_mutex.lock();
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -436,7 +567,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (!exit_threads && was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || !p_caller_pool_thread->local_queue.is_empty()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -458,6 +589,8 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (singleton->task_queue.first()) {
 					task_to_process = task_queue.first()->self();
 					task_queue.remove(task_queue.first());
+				} else {
+					task_to_process = _pop_local_task(p_caller_pool_thread);
 				}
 
 				if (!task_to_process) {
@@ -514,20 +647,30 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	task_mutex.unlock();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const LocalVector<TaskID> &p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
 	}
 
 	task_mutex.lock();
+	if (unlikely(!_are_dependencies_valid(p_dependencies))) {
+		task_mutex.unlock();
+		if (p_template_userdata) {
+			memdelete(p_template_userdata);
+		}
+		ERR_FAIL_V_MSG(INVALID_TASK_ID, "Invalid dependency ID. Dependencies must be tasks or groups that haven't been awaited yet.");
+	}
 	Group *group = group_allocator.alloc();
 	GroupID id = last_task++;
 	group->max = p_elements;
 	group->self = id;
+	group->low_priority = !p_high_priority;
+
+	uint32_t pending_dependencies = _register_dependencies(p_dependencies, nullptr, group);
 
 	Task **tasks_posted = nullptr;
-	if (p_elements == 0) {
+	if (p_elements == 0 && pending_dependencies == 0) {
 		// Should really not call it with zero Elements, but at least it should work.
 		group->completed.set_to(true);
 		group->done_semaphore.post();
@@ -538,6 +681,10 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 		}
 
 	} else {
+		if (p_elements == 0) {
+			// Still needs one task to flag completion once the dependencies are done.
+			p_tasks = 1;
+		}
 		group->tasks_used = p_tasks;
 		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
 		for (int i = 0; i < p_tasks; i++) {
@@ -555,6 +702,16 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	groups[id] = group;
 
+	if (pending_dependencies) {
+		// Will be posted once the last dependency completes.
+		group->deferred_tasks.resize(p_tasks);
+		for (int i = 0; i < p_tasks; i++) {
+			group->deferred_tasks[i] = tasks_posted[i];
+		}
+		task_mutex.unlock();
+		return id;
+	}
+
 	_post_tasks_and_unlock(tasks_posted, p_tasks, p_high_priority);
 
 	return id;
@@ -568,6 +725,14 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task_with_dependencies(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, const LocalVector<TaskID> &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_group_task_with_dependencies(const Callable &p_action, int p_elements, const LocalVector<TaskID> &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	task_mutex.lock();
 	const Group *const *groupp = groups.getptr(p_group);
@@ -595,13 +760,14 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 #ifdef THREADS_ENABLED
 	task_mutex.lock();
 	Group **groupp = groups.getptr(p_group);
-	task_mutex.unlock();
 	if (!groupp) {
+		task_mutex.unlock();
 		ERR_FAIL_MSG("Invalid Group ID.");
 	}
+	Group *group = *groupp;
+	task_mutex.unlock();
 
 	{
-		Group *group = *groupp;
 
 		if (flushing_cmd_queue) {
 			flushing_cmd_queue->unlock();
@@ -611,6 +777,11 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 			flushing_cmd_queue->lock();
 		}
 
+		// Unregister before possibly freeing it, so it can't be found as a dependency anymore.
+		task_mutex.lock(); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
+		groups.erase(p_group);
+		task_mutex.unlock();
+
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
 
@@ -621,10 +792,6 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 			task_mutex.unlock();
 		}
 	}
-
-	task_mutex.lock(); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
-	groups.erase(p_group);
-	task_mutex.unlock();
 #endif
 }
 
@@ -40,6 +40,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
 
 class CommandQueueMT;
 
@@ -71,6 +72,12 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		// Dependency tracking, protected by task_mutex.
+		bool low_priority = false;
+		uint32_t pending_dependencies = 0;
+		LocalVector<Task *> deferred_tasks; // Posted once pending_dependencies reaches zero.
+		LocalVector<Task *> dependent_tasks;
+		LocalVector<Group *> dependent_groups;
 	};
 
 	struct Task {
@@ -90,6 +97,10 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		// Dependency tracking, protected by task_mutex.
+		uint32_t pending_dependencies = 0;
+		LocalVector<Task *> dependent_tasks;
+		LocalVector<Group *> dependent_groups;
 
 		void free_template_userdata();
 		Task() :
@@ -100,6 +111,7 @@ private:
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t LOCAL_QUEUE_SIZE = 256;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -120,6 +132,8 @@ private:
 		Task *current_task = nullptr;
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
+		// Tasks posted by this thread. Popped by itself without locking and stolen by idle threads.
+		WorkStealingDeque<Task *, LOCAL_QUEUE_SIZE> local_queue;
 
 		ThreadData() :
 				ready_for_scripting(false),
@@ -157,16 +171,21 @@ private:
 	void _process_task(Task *task);
 
 	void _post_tasks_and_unlock(Task **p_tasks, uint32_t p_count, bool p_high_priority);
+	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority);
+	bool _are_dependencies_valid(const LocalVector<TaskID> &p_dependencies) const;
+	uint32_t _register_dependencies(const LocalVector<TaskID> &p_dependencies, Task *p_task, Group *p_group);
+	void _release_dependents(LocalVector<Task *> &p_tasks, LocalVector<Group *> &p_groups);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
 	bool _try_promote_low_priority_task();
+	Task *_pop_local_task(ThreadData *p_thread);
 
 	static WorkerThreadPool *singleton;
 
 	static thread_local CommandQueueMT *flushing_cmd_queue;
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const LocalVector<TaskID> &p_dependencies = LocalVector<TaskID>());
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const LocalVector<TaskID> &p_dependencies = LocalVector<TaskID>());
 
 	template <typename C, typename M, typename U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -206,6 +225,20 @@ public:
 	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// Task graphs: the task is only queued once every task or group in p_dependencies has completed.
+	// Dependencies must not have been awaited yet, and every ID must still be awaited as usual.
+	template <typename C, typename M, typename U>
+	TaskID add_template_task_with_dependencies(C *p_instance, M p_method, U p_userdata, const LocalVector<TaskID> &p_dependencies, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, p_dependencies);
+	}
+	TaskID add_native_task_with_dependencies(void (*p_func)(void *), void *p_userdata, const LocalVector<TaskID> &p_dependencies, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_task_with_dependencies(const Callable &p_action, const LocalVector<TaskID> &p_dependencies, bool p_high_priority = false, const String &p_description = String());
+
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
 
@@ -223,6 +256,19 @@ public:
 	}
 	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+
+	template <typename C, typename M, typename U>
+	GroupID add_template_group_task_with_dependencies(C *p_instance, M p_method, U p_userdata, int p_elements, const LocalVector<TaskID> &p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+		typedef GroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+	}
+	GroupID add_native_group_task_with_dependencies(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, const LocalVector<TaskID> &p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_group_task_with_dependencies(const Callable &p_action, int p_elements, const LocalVector<TaskID> &p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
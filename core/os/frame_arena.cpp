@@ -0,0 +1,249 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+thread_local FrameArena::ThreadArenaOwner FrameArena::thread_arena_owner;
+
+SafeNumeric<uint64_t> FrameArena::frame_number;
+SafeNumeric<uint64_t> FrameArena::frame_allocations;
+SafeNumeric<uint64_t> FrameArena::frame_bytes;
+SafeNumeric<uint64_t> FrameArena::last_frame_allocations;
+SafeNumeric<uint64_t> FrameArena::last_frame_bytes;
+
+void FrameArena::ThreadArena::rewind() {
+	// Chunks up to the current one were used since the last rewind, the ones past it weren't.
+	const uint64_t frame = frame_number.get();
+	bool used = current != nullptr;
+	Chunk *prev = nullptr;
+	Chunk *chunk = first;
+	while (chunk) {
+		Chunk *next = chunk->next;
+		if (used) {
+			chunk->last_used_frame = frame;
+			used = chunk != current;
+		} else if (frame - chunk->last_used_frame > CHUNK_IDLE_FRAMES) {
+			if (prev) {
+				prev->next = next;
+			} else {
+				first = next;
+			}
+			Memory::free_static(chunk);
+			chunk = next;
+			continue;
+		}
+		prev = chunk;
+		chunk = next;
+	}
+
+	current = first;
+	offset = 0;
+	last_allocation = nullptr;
+}
+
+FrameArena::ThreadArena::~ThreadArena() {
+	Chunk *chunk = first;
+	while (chunk) {
+		Chunk *next = chunk->next;
+		Memory::free_static(chunk);
+		chunk = next;
+	}
+}
+
+FrameArena::ThreadArenaOwner::~ThreadArenaOwner() {
+	if (arena) {
+		_unreference(arena);
+	}
+}
+
+FrameArena::ThreadArena *FrameArena::_get_thread_arena() {
+	ThreadArena *arena = thread_arena_owner.arena;
+	if (unlikely(!arena)) {
+		arena = memnew(ThreadArena);
+		arena->references.set(1);
+		thread_arena_owner.arena = arena;
+	}
+	return arena;
+}
+
+void FrameArena::_unreference(ThreadArena *p_arena) {
+	if (p_arena->references.decrement() == 0) {
+		memdelete(p_arena);
+	}
+}
+
+uint8_t *FrameArena::_bump(ThreadArena *p_arena, size_t p_bytes) {
+	if (p_arena->current && p_arena->offset + p_bytes <= p_arena->current->size) {
+		uint8_t *mem = (uint8_t *)p_arena->current + CHUNK_HEADER_SIZE + p_arena->offset;
+		p_arena->offset += p_bytes;
+		return mem;
+	}
+
+	// Move on to the next chunk big enough, allocating a new one at the end if there's none.
+	Chunk *prev = p_arena->current;
+	Chunk *chunk = prev ? prev->next : p_arena->first;
+	while (chunk && chunk->size < p_bytes) {
+		prev = chunk;
+		chunk = chunk->next;
+	}
+
+	if (!chunk) {
+		size_t size = MAX(CHUNK_SIZE, p_bytes);
+		chunk = (Chunk *)Memory::alloc_static(CHUNK_HEADER_SIZE + size);
+		ERR_FAIL_NULL_V(chunk, nullptr);
+		chunk->next = nullptr;
+		chunk->size = size;
+		chunk->last_used_frame = frame_number.get();
+		if (prev) {
+			prev->next = chunk;
+		} else {
+			p_arena->first = chunk;
+		}
+	}
+
+	p_arena->current = chunk;
+	p_arena->offset = p_bytes;
+	return (uint8_t *)chunk + CHUNK_HEADER_SIZE;
+}
+
+void *FrameArena::alloc(size_t p_bytes) {
+	size_t bytes = _get_allocation_size(p_bytes);
+
+	if (unlikely(bytes > MAX_ALLOCATION_SIZE)) {
+		uint8_t *mem = (uint8_t *)Memory::alloc_static(bytes);
+		ERR_FAIL_NULL_V(mem, nullptr);
+		AllocationHeader *header = (AllocationHeader *)mem;
+		header->arena = nullptr;
+		header->size = p_bytes;
+		return mem + HEADER_SIZE;
+	}
+
+	ThreadArena *arena = _get_thread_arena();
+	if (arena->references.get() == 1) {
+		// Nothing alive anymore, start over.
+		arena->rewind();
+	}
+
+	uint8_t *mem = _bump(arena, bytes);
+	ERR_FAIL_NULL_V(mem, nullptr);
+
+	AllocationHeader *header = (AllocationHeader *)mem;
+	header->arena = arena;
+	header->size = p_bytes;
+	arena->references.increment();
+	arena->last_allocation = mem;
+
+	frame_allocations.increment();
+	frame_bytes.add(p_bytes);
+
+	return mem + HEADER_SIZE;
+}
+
+void *FrameArena::realloc(void *p_memory, size_t p_bytes) {
+	if (!p_memory) {
+		return alloc(p_bytes);
+	}
+	if (p_bytes == 0) {
+		free(p_memory);
+		return nullptr;
+	}
+
+	AllocationHeader *header = _get_header(p_memory);
+	if (p_bytes <= header->size) {
+		return p_memory;
+	}
+
+	// Grow in place if it's the last allocation made by this thread, which is the common case
+	// for a vector being filled.
+	ThreadArena *arena = thread_arena_owner.arena;
+	if (header->arena && header->arena == arena && arena->last_allocation == (uint8_t *)header) {
+		size_t start = (uint8_t *)header - ((uint8_t *)arena->current + CHUNK_HEADER_SIZE);
+		size_t bytes = _get_allocation_size(p_bytes);
+		if (start + bytes <= arena->current->size) {
+			arena->offset = start + bytes;
+			frame_bytes.add(p_bytes - header->size);
+			header->size = p_bytes;
+			return p_memory;
+		}
+	}
+
+	void *new_memory = alloc(p_bytes);
+	ERR_FAIL_NULL_V(new_memory, nullptr);
+	memcpy(new_memory, p_memory, header->size);
+	free(p_memory);
+	return new_memory;
+}
+
+void FrameArena::free(void *p_memory) {
+	if (!p_memory) {
+		return;
+	}
+
+	AllocationHeader *header = _get_header(p_memory);
+	ThreadArena *arena = header->arena;
+	if (!arena) {
+		Memory::free_static(header);
+		return;
+	}
+
+	if (arena == thread_arena_owner.arena && arena->last_allocation == (uint8_t *)header) {
+		// Freed in reverse order, give the space back right away.
+		arena->offset = (uint8_t *)header - ((uint8_t *)arena->current + CHUNK_HEADER_SIZE);
+		arena->last_allocation = nullptr;
+	}
+
+	_unreference(arena);
+}
+
+void FrameArena::end_frame() {
+	frame_number.increment();
+
+	uint64_t allocations = frame_allocations.get();
+	frame_allocations.sub(allocations);
+	last_frame_allocations.set(allocations);
+
+	uint64_t bytes = frame_bytes.get();
+	frame_bytes.sub(bytes);
+	last_frame_bytes.set(bytes);
+}
+
+uint32_t FrameArena::get_thread_live_allocation_count() {
+	const ThreadArena *arena = thread_arena_owner.arena;
+	return arena ? arena->references.get() - 1 : 0;
+}
+
+size_t FrameArena::get_thread_reserved_bytes() {
+	const ThreadArena *arena = thread_arena_owner.arena;
+	size_t bytes = 0;
+	for (const Chunk *chunk = arena ? arena->first : nullptr; chunk; chunk = chunk->next) {
+		bytes += chunk->size;
+	}
+	return bytes;
+}
@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include "core/os/memory.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// Thread-local bump allocator for short-lived, per-frame temporaries.
+//
+// Each thread owns a list of chunks that are kept around once allocated, so
+// after warming up, allocating is just bumping an offset. Chunks are rewound
+// as soon as every allocation made from them has been freed, which in practice
+// happens once per scope using them, and at worst once per frame. Chunks that
+// weren't needed for CHUNK_IDLE_FRAMES frames are released on the next rewind,
+// so a single burst doesn't keep its memory reserved for the thread's lifetime.
+//
+// Memory can be freed from any thread, but it's meant for temporaries that die
+// within the frame they are created in; long-lived allocations keep the arena
+// of their thread from rewinding.
+
+class FrameArena {
+	struct Chunk {
+		Chunk *next = nullptr;
+		size_t size = 0;
+		uint64_t last_used_frame = 0;
+	};
+
+	struct ThreadArena {
+		Chunk *first = nullptr;
+		Chunk *current = nullptr;
+		size_t offset = 0;
+		uint8_t *last_allocation = nullptr;
+		// One per live allocation, plus one held by the owner thread while it's alive,
+		// so memory freed after its thread exited can still be accounted for.
+		SafeNumeric<uint32_t> references;
+
+		void rewind();
+		~ThreadArena();
+	};
+
+	struct ThreadArenaOwner {
+		ThreadArena *arena = nullptr;
+		~ThreadArenaOwner();
+	};
+
+	struct AllocationHeader {
+		ThreadArena *arena = nullptr; // Null if the allocation fell back to the heap.
+		size_t size = 0;
+	};
+
+	static constexpr size_t CHUNK_SIZE = 64 * 1024;
+	static constexpr size_t MAX_ALLOCATION_SIZE = 16 * 1024 * 1024; // Bigger ones go straight to the heap.
+	static constexpr size_t HEADER_SIZE = ((sizeof(AllocationHeader) + alignof(max_align_t) - 1) / alignof(max_align_t)) * alignof(max_align_t);
+	static constexpr size_t CHUNK_HEADER_SIZE = ((sizeof(Chunk) + alignof(max_align_t) - 1) / alignof(max_align_t)) * alignof(max_align_t);
+
+	static thread_local ThreadArenaOwner thread_arena_owner;
+
+	static SafeNumeric<uint64_t> frame_number;
+	static SafeNumeric<uint64_t> frame_allocations;
+	static SafeNumeric<uint64_t> frame_bytes;
+	static SafeNumeric<uint64_t> last_frame_allocations;
+	static SafeNumeric<uint64_t> last_frame_bytes;
+
+	_FORCE_INLINE_ static AllocationHeader *_get_header(void *p_memory) {
+		return (AllocationHeader *)((uint8_t *)p_memory - HEADER_SIZE);
+	}
+
+	_FORCE_INLINE_ static size_t _get_allocation_size(size_t p_bytes) {
+		return HEADER_SIZE + ((p_bytes + alignof(max_align_t) - 1) / alignof(max_align_t)) * alignof(max_align_t);
+	}
+
+	static ThreadArena *_get_thread_arena();
+	static void _unreference(ThreadArena *p_arena);
+	static uint8_t *_bump(ThreadArena *p_arena, size_t p_bytes);
+
+public:
+	static constexpr uint64_t CHUNK_IDLE_FRAMES = 60;
+
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	static void free(void *p_memory);
+
+	// Called by the main loop once per frame to roll the statistics.
+	static void end_frame();
+
+	// Allocations (and their bytes) served by arenas instead of the heap in the last frame.
+	static uint64_t get_last_frame_allocation_count() { return last_frame_allocations.get(); }
+	static uint64_t get_last_frame_allocated_bytes() { return last_frame_bytes.get(); }
+
+	// State of the calling thread's arena: allocations not freed yet, and bytes reserved in chunks.
+	static uint32_t get_thread_live_allocation_count();
+	static size_t get_thread_reserved_bytes();
+};
+
+class FrameAllocator {
+public:
+	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return FrameArena::alloc(p_memory); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_memory) { return FrameArena::realloc(p_ptr, p_memory); }
+	_FORCE_INLINE_ static void free(void *p_ptr) { FrameArena::free(p_ptr); }
+};
+
+template <typename T>
+class FrameTypedAllocator {
+public:
+	template <typename... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_placement(FrameArena::alloc(sizeof(T)), T(p_args...)); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			p_allocation->~T();
+		}
+		FrameArena::free(p_allocation);
+	}
+};
+
+template <typename T, typename U = uint32_t, bool force_trivial = false>
+using FrameLocalVector = LocalVector<T, U, force_trivial, false, FrameAllocator>;
+
+// Only the elements come from the arena, the (rarely resized) index tables still live on the heap.
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+using FrameHashMap = HashMap<TKey, TValue, Hasher, Comparator, FrameTypedAllocator<HashMapElement<TKey, TValue>>>;
+
+#endif // FRAME_ARENA_H
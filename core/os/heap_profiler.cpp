@@ -0,0 +1,424 @@
+/**************************************************************************/
+/*  heap_profiler.cpp                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "heap_profiler.h"
+
+#include "core/io/file_access.h"
+#include "core/os/mutex.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+namespace {
+
+// All bookkeeping below uses malloc() directly: the hooks run inside Memory, and must not recurse into it.
+
+struct Tag {
+	const char *name = nullptr;
+	SafeNumeric<uint64_t> alloc_count;
+	SafeNumeric<uint64_t> alloc_bytes;
+	uint64_t live_bytes = 0; // Guarded by table_mutex.
+};
+
+struct Site {
+	uint32_t hash = 0;
+	uint32_t tag = 0;
+	int frame_count = -1; // -1 means empty.
+	void *frames[HeapProfiler::MAX_FRAMES];
+	uint64_t live_bytes = 0;
+	uint64_t alloc_bytes = 0;
+};
+
+struct Sample {
+	void *ptr = nullptr; // nullptr means empty.
+	uint64_t weight = 0;
+	uint32_t tag = 0;
+	uint32_t site = 0;
+};
+
+constexpr uint32_t SAMPLE_CAPACITY = 1 << 15;
+constexpr uint32_t SITE_CAPACITY = 1 << 12;
+// Extra slot past the hash table collecting samples once it is full.
+constexpr uint32_t OVERFLOW_SITE = SITE_CAPACITY;
+constexpr uint32_t FILTER_SIZE = 1 << 16;
+// Frames belonging to the profiler and Memory itself.
+constexpr int SKIP_FRAMES = 3;
+
+Tag tags[HeapProfiler::MAX_TAGS];
+SafeNumeric<uint32_t> tag_count;
+BinaryMutex tag_mutex;
+
+BinaryMutex table_mutex;
+Sample *samples = nullptr;
+Site *sites = nullptr;
+uint32_t sample_count = 0;
+uint32_t site_count = 0;
+uint64_t dropped_samples = 0;
+
+// Counting filter over sampled pointers, lets frees of unsampled memory skip the table lock.
+std::atomic<uint16_t> sample_filter[FILTER_SIZE];
+
+uint64_t sample_period = HeapProfiler::DEFAULT_SAMPLE_PERIOD;
+std::chrono::steady_clock::time_point start_time;
+
+thread_local bool in_profiler = false;
+thread_local int64_t bytes_until_sample = 0;
+thread_local uint64_t rng_state = 0;
+
+_FORCE_INLINE_ uint32_t hash_ptr(const void *p_ptr) {
+	return uint32_t((uint64_t(uintptr_t(p_ptr)) * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+_FORCE_INLINE_ uint32_t filter_slot(const void *p_ptr) {
+	return hash_ptr(p_ptr) & (FILTER_SIZE - 1);
+}
+
+int64_t next_sample_interval() {
+	if (sample_period <= 1) {
+		return 0;
+	}
+	if (rng_state == 0) {
+		rng_state = uint64_t(uintptr_t(&rng_state)) | 1;
+	}
+	// Exponentially distributed gaps avoid aliasing with periodic allocation patterns.
+	rng_state ^= rng_state << 13;
+	rng_state ^= rng_state >> 7;
+	rng_state ^= rng_state << 17;
+	double u = (double(rng_state >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+	return int64_t(-log(u) * double(sample_period));
+}
+
+uint32_t find_or_add_site(uint32_t p_tag, void **p_frames, int p_frame_count) {
+	uint32_t hash = p_tag * 0x9E3779B9u;
+	for (int i = 0; i < p_frame_count; i++) {
+		hash = (hash ^ hash_ptr(p_frames[i])) * 16777619u;
+	}
+
+	uint32_t pos = hash & (SITE_CAPACITY - 1);
+	for (uint32_t i = 0; i < SITE_CAPACITY; i++) {
+		Site &s = sites[pos];
+		if (s.frame_count < 0) {
+			if (site_count >= SITE_CAPACITY / 2) {
+				break;
+			}
+			s.hash = hash;
+			s.tag = p_tag;
+			s.frame_count = p_frame_count;
+			memcpy(s.frames, p_frames, sizeof(void *) * p_frame_count);
+			site_count++;
+			return pos;
+		}
+		if (s.hash == hash && s.tag == p_tag && s.frame_count == p_frame_count && memcmp(s.frames, p_frames, sizeof(void *) * p_frame_count) == 0) {
+			return pos;
+		}
+		pos = (pos + 1) & (SITE_CAPACITY - 1);
+	}
+
+	sites[OVERFLOW_SITE].frame_count = 0;
+	sites[OVERFLOW_SITE].tag = p_tag;
+	return OVERFLOW_SITE;
+}
+
+void remove_sample(uint32_t p_pos) {
+	// Backward shift deletion keeps linear probing chains intact without tombstones.
+	uint32_t hole = p_pos;
+	uint32_t pos = (hole + 1) & (SAMPLE_CAPACITY - 1);
+	while (samples[pos].ptr) {
+		uint32_t ideal = hash_ptr(samples[pos].ptr) & (SAMPLE_CAPACITY - 1);
+		if (((pos - ideal) & (SAMPLE_CAPACITY - 1)) >= ((pos - hole) & (SAMPLE_CAPACITY - 1))) {
+			samples[hole] = samples[pos];
+			hole = pos;
+		}
+		pos = (pos + 1) & (SAMPLE_CAPACITY - 1);
+	}
+	samples[hole] = Sample();
+	sample_count--;
+}
+
+void default_symbolize(void *p_address, char *r_buffer, int p_buffer_size) {
+	snprintf(r_buffer, p_buffer_size, "%p", p_address);
+}
+
+} // namespace
+
+SafeFlag HeapProfiler::active;
+thread_local uint32_t HeapProfiler::current_tag = 0;
+HeapProfiler::BacktraceFunc HeapProfiler::backtrace_func = nullptr;
+HeapProfiler::SymbolizeFunc HeapProfiler::symbolize_func = default_symbolize;
+
+void HeapProfiler::_record_alloc(void *p_ptr, size_t p_bytes) {
+	if (in_profiler || !p_ptr) {
+		return;
+	}
+
+	uint32_t tag = current_tag;
+	tags[tag].alloc_count.increment();
+	tags[tag].alloc_bytes.add(p_bytes);
+
+	bytes_until_sample -= p_bytes;
+	if (bytes_until_sample > 0) {
+		return;
+	}
+
+	in_profiler = true;
+	bytes_until_sample = next_sample_interval();
+
+	// Each sample stands for the bytes it was drawn from, so sums over samples are unbiased.
+	uint64_t weight = p_bytes;
+	if (sample_period > 1) {
+		double p = 1.0 - exp(-double(p_bytes) / double(sample_period));
+		weight = p > 0.0 ? uint64_t(double(p_bytes) / p) : sample_period;
+	}
+
+	void *frames[MAX_FRAMES + SKIP_FRAMES];
+	int frame_count = 0;
+	if (backtrace_func) {
+		frame_count = MAX(backtrace_func(frames, MAX_FRAMES + SKIP_FRAMES) - SKIP_FRAMES, 0);
+	}
+
+	{
+		MutexLock lock(table_mutex);
+
+		if (samples && sample_count < SAMPLE_CAPACITY / 2) {
+			uint32_t site = find_or_add_site(tag, frames + SKIP_FRAMES, frame_count);
+			sites[site].live_bytes += weight;
+			sites[site].alloc_bytes += weight;
+			tags[tag].live_bytes += weight;
+
+			uint32_t pos = hash_ptr(p_ptr) & (SAMPLE_CAPACITY - 1);
+			while (samples[pos].ptr) {
+				pos = (pos + 1) & (SAMPLE_CAPACITY - 1);
+			}
+			samples[pos].ptr = p_ptr;
+			samples[pos].weight = weight;
+			samples[pos].tag = tag;
+			samples[pos].site = site;
+			sample_count++;
+			sample_filter[filter_slot(p_ptr)].fetch_add(1, std::memory_order_relaxed);
+		} else {
+			dropped_samples++;
+		}
+	}
+
+	in_profiler = false;
+}
+
+void HeapProfiler::_record_free(void *p_ptr) {
+	if (in_profiler || !p_ptr) {
+		return;
+	}
+	if (sample_filter[filter_slot(p_ptr)].load(std::memory_order_relaxed) == 0) {
+		return;
+	}
+
+	MutexLock lock(table_mutex);
+
+	uint32_t pos = hash_ptr(p_ptr) & (SAMPLE_CAPACITY - 1);
+	while (samples[pos].ptr) {
+		if (samples[pos].ptr == p_ptr) {
+			const Sample &s = samples[pos];
+			sites[s.site].live_bytes -= s.weight;
+			tags[s.tag].live_bytes -= s.weight;
+			sample_filter[filter_slot(p_ptr)].fetch_sub(1, std::memory_order_relaxed);
+			remove_sample(pos);
+			return;
+		}
+		pos = (pos + 1) & (SAMPLE_CAPACITY - 1);
+	}
+}
+
+void HeapProfiler::symbolize(void *p_address, char *r_buffer, int p_buffer_size) {
+	symbolize_func(p_address, r_buffer, p_buffer_size);
+}
+
+uint32_t HeapProfiler::register_tag(const char *p_name) {
+	MutexLock lock(tag_mutex);
+
+	if (tag_count.get() == 0) {
+		tags[0].name = "Untagged";
+		tag_count.set(1);
+	}
+
+	uint32_t count = tag_count.get();
+	for (uint32_t i = 0; i < count; i++) {
+		if (strcmp(tags[i].name, p_name) == 0) {
+			return i;
+		}
+	}
+
+	ERR_FAIL_COND_V_MSG(count >= MAX_TAGS, 0, vformat("Too many heap profiler tags, allocations tagged \"%s\" will be reported as untagged.", p_name));
+	tags[count].name = p_name;
+	tag_count.set(count + 1);
+	return count;
+}
+
+void HeapProfiler::start(uint64_t p_sample_period) {
+	register_tag("Untagged");
+
+	MutexLock lock(table_mutex);
+
+	// The tables are never freed: hooks on other threads may still be about to use them.
+	if (!samples) {
+		samples = (Sample *)malloc(sizeof(Sample) * SAMPLE_CAPACITY);
+		sites = (Site *)malloc(sizeof(Site) * (SITE_CAPACITY + 1));
+		ERR_FAIL_COND(!samples || !sites);
+	}
+	for (uint32_t i = 0; i < SAMPLE_CAPACITY; i++) {
+		samples[i] = Sample();
+	}
+	for (uint32_t i = 0; i <= SITE_CAPACITY; i++) {
+		sites[i].frame_count = -1;
+		sites[i].live_bytes = 0;
+		sites[i].alloc_bytes = 0;
+	}
+	for (uint32_t i = 0; i < FILTER_SIZE; i++) {
+		sample_filter[i].store(0, std::memory_order_relaxed);
+	}
+	for (uint32_t i = 0; i < MAX_TAGS; i++) {
+		tags[i].alloc_count.set(0);
+		tags[i].alloc_bytes.set(0);
+		tags[i].live_bytes = 0;
+	}
+	sample_count = 0;
+	site_count = 0;
+	dropped_samples = 0;
+
+	sample_period = p_sample_period;
+	start_time = std::chrono::steady_clock::now();
+	active.set();
+}
+
+void HeapProfiler::stop() {
+	// Statistics are kept until the next start(), so they can still be dumped.
+	active.clear();
+}
+
+uint64_t HeapProfiler::get_sample_period() {
+	return sample_period;
+}
+
+double HeapProfiler::get_elapsed_time() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+int HeapProfiler::get_tag_stats(TagStats *r_stats, int p_max_tags) {
+	MutexLock lock(table_mutex);
+
+	int count = MIN((int)tag_count.get(), p_max_tags);
+	for (int i = 0; i < count; i++) {
+		r_stats[i].name = tags[i].name;
+		r_stats[i].alloc_count = tags[i].alloc_count.get();
+		r_stats[i].alloc_bytes = tags[i].alloc_bytes.get();
+		r_stats[i].live_bytes = tags[i].live_bytes;
+	}
+	return count;
+}
+
+int HeapProfiler::get_top_sites(SiteStats *r_sites, int p_max_sites) {
+	if (!sites || p_max_sites <= 0) {
+		return 0;
+	}
+
+	MutexLock lock(table_mutex);
+
+	// Keep the p_max_sites biggest in r_sites, sorted by insertion.
+	int count = 0;
+	for (uint32_t i = 0; i <= SITE_CAPACITY; i++) {
+		const Site &s = sites[i];
+		if (s.frame_count < 0 || s.live_bytes == 0) {
+			continue;
+		}
+		if (count == p_max_sites && r_sites[count - 1].live_bytes >= s.live_bytes) {
+			continue;
+		}
+
+		int pos = MIN(count, p_max_sites - 1);
+		while (pos > 0 && r_sites[pos - 1].live_bytes < s.live_bytes) {
+			r_sites[pos] = r_sites[pos - 1];
+			pos--;
+		}
+		SiteStats &dst = r_sites[pos];
+		dst.tag = s.tag;
+		dst.live_bytes = s.live_bytes;
+		dst.alloc_bytes = s.alloc_bytes;
+		dst.frame_count = s.frame_count;
+		memcpy(dst.frames, s.frames, sizeof(void *) * s.frame_count);
+		count = MIN(count + 1, p_max_sites);
+	}
+	return count;
+}
+
+Error HeapProfiler::dump(const String &p_path) {
+	// Snapshot first, writing the file allocates too.
+	TagStats tag_stats[MAX_TAGS];
+	int tag_stats_count = get_tag_stats(tag_stats, MAX_TAGS);
+
+	const int max_sites = 64;
+	SiteStats *site_stats = (SiteStats *)malloc(sizeof(SiteStats) * max_sites);
+	ERR_FAIL_NULL_V(site_stats, ERR_OUT_OF_MEMORY);
+	int site_stats_count = get_top_sites(site_stats, max_sites);
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	if (f.is_null()) {
+		free(site_stats);
+		ERR_FAIL_V_MSG(err, vformat("Can't open heap profile file \"%s\".", p_path));
+	}
+
+	double elapsed = MAX(get_elapsed_time(), 0.001);
+	f->store_line("# Godot heap profile");
+	f->store_line(vformat("# Sample period: %d bytes, duration: %.3f s, dropped samples: %d", sample_period, elapsed, dropped_samples));
+	f->store_line("# Live bytes are estimated from sampled allocations.");
+	f->store_line("");
+	f->store_line("[tags]");
+	f->store_line("live_bytes\talloc_count\talloc_bytes\tallocs_per_second\tbytes_per_second\tname");
+	for (int i = 0; i < tag_stats_count; i++) {
+		const TagStats &t = tag_stats[i];
+		f->store_line(vformat("%d\t%d\t%d\t%.1f\t%.1f\t%s", t.live_bytes, t.alloc_count, t.alloc_bytes, t.alloc_count / elapsed, t.alloc_bytes / elapsed, t.name));
+	}
+
+	f->store_line("");
+	f->store_line("[sites]");
+	char symbol[512];
+	for (int i = 0; i < site_stats_count; i++) {
+		const SiteStats &s = site_stats[i];
+		f->store_line(vformat("live_bytes=%d alloc_bytes=%d tag=%s", s.live_bytes, s.alloc_bytes, tags[s.tag].name));
+		for (int j = 0; j < s.frame_count; j++) {
+			symbolize(s.frames[j], symbol, sizeof(symbol));
+			f->store_line(vformat("\t#%d %s", j, symbol));
+		}
+	}
+
+	free(site_stats);
+	return OK;
+}
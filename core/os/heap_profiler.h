@@ -0,0 +1,131 @@
+/**************************************************************************/
+/*  heap_profiler.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef HEAP_PROFILER_H
+#define HEAP_PROFILER_H
+
+#include "core/string/ustring.h"
+#include "core/templates/safe_refcount.h"
+
+// Sampling heap profiler fed by Memory::alloc_static/realloc_static/free_static.
+//
+// While active, every allocation is counted against the tag of the calling thread (see
+// HEAP_PROFILE_TAG), and allocations are sampled on average once every `sample_period` bytes.
+// Sampled allocations keep their backtrace until freed, which gives an unbiased estimate of live
+// bytes per tag and per call site. When inactive, each hook costs a single flag check.
+class HeapProfiler {
+public:
+	enum {
+		MAX_TAGS = 64,
+		MAX_FRAMES = 16,
+		DEFAULT_SAMPLE_PERIOD = 512 * 1024,
+	};
+
+	typedef int (*BacktraceFunc)(void **r_frames, int p_max_frames);
+	typedef void (*SymbolizeFunc)(void *p_address, char *r_buffer, int p_buffer_size);
+
+	struct TagStats {
+		const char *name = nullptr;
+		uint64_t alloc_count = 0;
+		uint64_t alloc_bytes = 0;
+		uint64_t live_bytes = 0; // Estimated from samples.
+	};
+
+	struct SiteStats {
+		uint32_t tag = 0;
+		uint64_t live_bytes = 0; // Estimated from samples.
+		uint64_t alloc_bytes = 0; // Estimated from samples.
+		int frame_count = 0;
+		void *frames[MAX_FRAMES] = {};
+	};
+
+	class TagScope {
+		uint32_t previous;
+
+	public:
+		_FORCE_INLINE_ explicit TagScope(uint32_t p_tag) {
+			previous = current_tag;
+			current_tag = p_tag;
+		}
+		_FORCE_INLINE_ ~TagScope() {
+			current_tag = previous;
+		}
+	};
+
+private:
+	static SafeFlag active;
+	static thread_local uint32_t current_tag;
+
+	static BacktraceFunc backtrace_func;
+	static SymbolizeFunc symbolize_func;
+
+	static void _record_alloc(void *p_ptr, size_t p_bytes);
+	static void _record_free(void *p_ptr);
+
+public:
+	_FORCE_INLINE_ static void on_alloc(void *p_ptr, size_t p_bytes) {
+		if (unlikely(active.is_set())) {
+			_record_alloc(p_ptr, p_bytes);
+		}
+	}
+	_FORCE_INLINE_ static void on_free(void *p_ptr) {
+		if (unlikely(active.is_set())) {
+			_record_free(p_ptr);
+		}
+	}
+
+	// Platforms that can walk the stack provide these, otherwise samples carry no call site.
+	static void set_backtrace_func(BacktraceFunc p_func) { backtrace_func = p_func; }
+	static void set_symbolize_func(SymbolizeFunc p_func) { symbolize_func = p_func; }
+	static void symbolize(void *p_address, char *r_buffer, int p_buffer_size);
+
+	// Returns the id of the tag with the given name, registering it on first use.
+	// p_name must outlive the profiler (string literals do).
+	static uint32_t register_tag(const char *p_name);
+
+	static void start(uint64_t p_sample_period = DEFAULT_SAMPLE_PERIOD);
+	static void stop();
+	_FORCE_INLINE_ static bool is_active() { return active.is_set(); }
+	static uint64_t get_sample_period();
+	static double get_elapsed_time();
+
+	static int get_tag_stats(TagStats *r_stats, int p_max_tags);
+	// Call sites with the most live bytes first.
+	static int get_top_sites(SiteStats *r_sites, int p_max_sites);
+
+	static Error dump(const String &p_path);
+};
+
+// Attributes allocations made by the current thread until the end of the enclosing scope to m_name.
+#define HEAP_PROFILE_TAG(m_name)                                                     \
+	static const uint32_t _heap_profile_tag_id = HeapProfiler::register_tag(m_name); \
+	HeapProfiler::TagScope _heap_profile_tag_scope(_heap_profile_tag_id)
+
+#endif // HEAP_PROFILER_H
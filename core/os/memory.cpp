@@ -31,6 +31,7 @@
 #include "memory.h"
 
 #include "core/error/error_macros.h"
+#include "core/os/heap_profiler.h"
 #include "core/templates/safe_refcount.h"
 
 #include <stdio.h>
@@ -88,8 +89,10 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 		uint64_t new_mem_usage = mem_usage.add(p_bytes);
 		max_usage.exchange_if_greater(new_mem_usage);
 #endif
+		HeapProfiler::on_alloc(s8 + DATA_OFFSET, p_bytes);
 		return s8 + DATA_OFFSET;
 	} else {
+		HeapProfiler::on_alloc(mem, p_bytes);
 		return mem;
 	}
 }
@@ -107,6 +110,9 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
+	// The profiler sees a reallocation as a free followed by a new allocation.
+	HeapProfiler::on_free(p_memory);
+
 	if (prepad) {
 		mem -= DATA_OFFSET;
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
@@ -133,6 +139,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 			*s = p_bytes;
 
+			HeapProfiler::on_alloc(mem + DATA_OFFSET, p_bytes);
 			return mem + DATA_OFFSET;
 		}
 	} else {
@@ -140,6 +147,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
 
+		HeapProfiler::on_alloc(mem, p_bytes);
 		return mem;
 	}
 }
@@ -157,6 +165,8 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	alloc_count.decrement();
 
+	HeapProfiler::on_free(p_ptr);
+
 	if (prepad) {
 		mem -= DATA_OFFSET;
 
@@ -0,0 +1,377 @@
+/**************************************************************************/
+/*  compact_string.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "compact_string.h"
+
+bool CompactString::_fits_latin1(const char32_t *p_data, int p_length, bool &r_ascii) {
+	char32_t bits = 0;
+	for (int i = 0; i < p_length; i++) {
+		if (p_data[i] > 0xFF) {
+			return false;
+		}
+		bits |= p_data[i];
+	}
+	r_ascii = bits < 0x80;
+	return true;
+}
+
+void CompactString::_set_latin1(const uint8_t *p_data, int p_length) {
+	_wide = String();
+	_ascii = true;
+	if (p_length == 0) {
+		_latin1 = CharString();
+		return;
+	}
+
+	_latin1.resize(p_length + 1);
+	char *dst = _latin1.ptrw();
+	memcpy(dst, p_data, p_length);
+	dst[p_length] = 0;
+
+	uint8_t bits = 0;
+	for (int i = 0; i < p_length; i++) {
+		bits |= p_data[i];
+	}
+	_ascii = bits < 0x80;
+}
+
+String CompactString::to_string() const {
+	if (!is_compact()) {
+		return _wide;
+	}
+
+	const int len = _latin1.length();
+	if (len == 0) {
+		return String();
+	}
+
+	String s;
+	s.resize(len + 1);
+	const uint8_t *src = (const uint8_t *)_latin1.ptr();
+	char32_t *dst = s.ptrw();
+	for (int i = 0; i <= len; i++) {
+		dst[i] = src[i];
+	}
+	return s;
+}
+
+CharString CompactString::utf8() const {
+	if (is_compact() && _ascii) {
+		return _latin1;
+	}
+	return to_string().utf8();
+}
+
+CompactString CompactString::from_utf8(const char *p_utf8, int p_len) {
+	CompactString ret;
+	if (!p_utf8) {
+		return ret;
+	}
+	if (p_len < 0) {
+		p_len = strlen(p_utf8);
+	}
+
+	bool ascii = true;
+	for (int i = 0; i < p_len && ascii; i++) {
+		uint8_t c = p_utf8[i];
+		ascii = c != 0 && c < 0x80;
+	}
+
+	if (ascii) {
+		// ASCII is valid UTF-8 and Latin-1 alike, keep the bytes as they are.
+		ret._set_latin1((const uint8_t *)p_utf8, p_len);
+		return ret;
+	}
+
+	String s;
+	s.parse_utf8(p_utf8, p_len);
+	return CompactString(s);
+}
+
+uint32_t CompactString::hash() const {
+	if (!is_compact()) {
+		return _wide.hash();
+	}
+
+	// Same djb2 as String::hash(), so both agree on equal contents.
+	const uint8_t *chr = (const uint8_t *)_latin1.get_data();
+	uint32_t hashv = 5381;
+	uint32_t c = *chr++;
+
+	while (c) {
+		hashv = ((hashv << 5) + hashv) + c; /* hash * 33 + c */
+		c = *chr++;
+	}
+
+	return hashv;
+}
+
+bool CompactString::operator==(const CompactString &p_str) const {
+	if (is_compact() != p_str.is_compact()) {
+		// Wide strings always hold some character outside Latin-1.
+		return false;
+	}
+	if (!is_compact()) {
+		return _wide == p_str._wide;
+	}
+
+	const int len = _latin1.length();
+	if (len != p_str._latin1.length()) {
+		return false;
+	}
+	return len == 0 || memcmp(_latin1.ptr(), p_str._latin1.ptr(), len) == 0;
+}
+
+bool CompactString::operator==(const String &p_str) const {
+	if (!is_compact()) {
+		return _wide == p_str;
+	}
+
+	const int len = _latin1.length();
+	if (len != p_str.length()) {
+		return false;
+	}
+
+	const uint8_t *a = (const uint8_t *)_latin1.ptr();
+	const char32_t *b = p_str.ptr();
+	for (int i = 0; i < len; i++) {
+		if (a[i] != b[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool CompactString::operator==(const char *p_latin1) const {
+	if (!is_compact()) {
+		return _wide == p_latin1;
+	}
+	return strcmp(_latin1.get_data(), p_latin1 ? p_latin1 : "") == 0;
+}
+
+bool CompactString::operator<(const CompactString &p_str) const {
+	if (is_compact() && p_str.is_compact()) {
+		// strcmp() compares as unsigned char, which is Latin-1 code point order.
+		return strcmp(_latin1.get_data(), p_str._latin1.get_data()) < 0;
+	}
+	return to_string() < p_str.to_string();
+}
+
+CompactString CompactString::operator+(const CompactString &p_str) const {
+	if (p_str.is_empty()) {
+		return *this;
+	}
+	if (is_empty()) {
+		return p_str;
+	}
+
+	CompactString ret;
+	if (!is_compact() || !p_str.is_compact()) {
+		ret._wide = to_string() + p_str.to_string();
+		return ret;
+	}
+
+	const int len = _latin1.length();
+	const int other_len = p_str._latin1.length();
+	ret._latin1.resize(len + other_len + 1);
+	char *dst = ret._latin1.ptrw();
+	memcpy(dst, _latin1.ptr(), len);
+	memcpy(dst + len, p_str._latin1.ptr(), other_len + 1);
+	ret._ascii = _ascii && p_str._ascii;
+	return ret;
+}
+
+CompactString &CompactString::operator+=(const CompactString &p_str) {
+	*this = *this + p_str;
+	return *this;
+}
+
+int CompactString::find(const CompactString &p_str, int p_from) const {
+	if (p_from < 0) {
+		return -1;
+	}
+	if (!is_compact()) {
+		return _wide.find(p_str.to_string(), p_from);
+	}
+	if (!p_str.is_compact()) {
+		return -1; // Has characters this string can't contain.
+	}
+
+	const int src_len = p_str._latin1.length();
+	const int len = _latin1.length();
+	if (src_len == 0 || len == 0 || p_from + src_len > len) {
+		return -1;
+	}
+
+	const char *str = _latin1.ptr();
+	const char *src = p_str._latin1.ptr();
+	const char *last = str + len - src_len;
+	const char *at = str + p_from;
+	while (at <= last) {
+		at = (const char *)memchr(at, src[0], last - at + 1);
+		if (!at) {
+			return -1;
+		}
+		if (memcmp(at, src, src_len) == 0) {
+			return at - str;
+		}
+		at++;
+	}
+	return -1;
+}
+
+int CompactString::find_char(char32_t p_char, int p_from) const {
+	if (!is_compact()) {
+		return _wide.find_char(p_char, p_from);
+	}
+
+	const int len = _latin1.length();
+	if (p_from < 0 || p_from >= len || p_char == 0 || p_char > 0xFF) {
+		return -1;
+	}
+
+	const char *str = _latin1.ptr();
+	const char *at = (const char *)memchr(str + p_from, (int)p_char, len - p_from);
+	return at ? at - str : -1;
+}
+
+bool CompactString::begins_with(const CompactString &p_str) const {
+	if (!is_compact()) {
+		return _wide.begins_with(p_str.to_string());
+	}
+	if (!p_str.is_compact()) {
+		return false;
+	}
+
+	const int len = p_str._latin1.length();
+	return len <= _latin1.length() && (len == 0 || memcmp(_latin1.ptr(), p_str._latin1.ptr(), len) == 0);
+}
+
+CompactString CompactString::substr(int p_from, int p_chars) const {
+	if (!is_compact()) {
+		return CompactString(_wide.substr(p_from, p_chars));
+	}
+
+	const int len = _latin1.length();
+	if (p_chars == -1) {
+		p_chars = len - p_from;
+	}
+	if (len == 0 || p_from < 0 || p_from >= len || p_chars <= 0) {
+		return CompactString();
+	}
+	if (p_from + p_chars > len) {
+		p_chars = len - p_from;
+	}
+	if (p_from == 0 && p_chars == len) {
+		return *this;
+	}
+
+	CompactString ret;
+	ret._set_latin1((const uint8_t *)_latin1.ptr() + p_from, p_chars);
+	return ret;
+}
+
+Vector<CompactString> CompactString::split(const CompactString &p_splitter, bool p_allow_empty, int p_maxsplit) const {
+	Vector<CompactString> ret;
+
+	if (!is_compact()) {
+		Vector<String> parts = _wide.split(p_splitter.to_string(), p_allow_empty, p_maxsplit);
+		ret.resize(parts.size());
+		for (int i = 0; i < parts.size(); i++) {
+			ret.write[i] = CompactString(parts[i]);
+		}
+		return ret;
+	}
+
+	if (is_empty()) {
+		if (p_allow_empty) {
+			ret.push_back(CompactString());
+		}
+		return ret;
+	}
+
+	int from = 0;
+	const int len = length();
+
+	while (true) {
+		int end;
+		if (p_splitter.is_empty()) {
+			end = from + 1;
+		} else {
+			end = find(p_splitter, from);
+			if (end < 0) {
+				end = len;
+			}
+		}
+		if (p_allow_empty || (end > from)) {
+			if (p_maxsplit > 0 && p_maxsplit == ret.size()) {
+				// Put rest of the string and leave cycle.
+				ret.push_back(substr(from, len));
+				break;
+			}
+			ret.push_back(substr(from, end - from));
+		}
+
+		if (end == len) {
+			break;
+		}
+
+		from = end + p_splitter.length();
+	}
+
+	return ret;
+}
+
+CompactString::CompactString(const String &p_str) {
+	const int len = p_str.length();
+	if (len == 0) {
+		return;
+	}
+
+	const char32_t *src = p_str.ptr();
+	bool ascii = true;
+	if (!_fits_latin1(src, len, ascii)) {
+		_wide = p_str;
+		return;
+	}
+
+	_latin1.resize(len + 1);
+	char *dst = _latin1.ptrw();
+	for (int i = 0; i <= len; i++) {
+		dst[i] = (char)(uint8_t)src[i];
+	}
+	_ascii = ascii;
+}
+
+CompactString::CompactString(const char *p_latin1) {
+	if (p_latin1) {
+		_set_latin1((const uint8_t *)p_latin1, strlen(p_latin1));
+	}
+}
@@ -0,0 +1,113 @@
+/**************************************************************************/
+/*  compact_string.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef COMPACT_STRING_H
+#define COMPACT_STRING_H
+
+#include "core/string/ustring.h"
+
+// Immutable string that stores one byte per character when all of its characters fit in Latin-1.
+//
+// Meant for long-lived, mostly ASCII text such as JSON payloads, node names, translation keys or
+// log lines, where String spends four bytes per character. Text with characters outside Latin-1
+// is kept as a regular String, so every operation is valid for any content and only the compact
+// form takes the byte-wise fast paths. Indices are in characters, and hashes and comparisons match
+// the equivalent String, which is only built (widened) when explicitly converted.
+class CompactString {
+	CharString _latin1; // Latin-1 bytes including the terminating zero, unused when wide.
+	String _wide;
+	bool _ascii = true; // Only meaningful for the compact form.
+
+	void _set_latin1(const uint8_t *p_data, int p_length);
+	static bool _fits_latin1(const char32_t *p_data, int p_length, bool &r_ascii);
+
+public:
+	enum {
+		npos = -1
+	};
+
+	_FORCE_INLINE_ bool is_compact() const { return _wide.is_empty(); }
+	_FORCE_INLINE_ int length() const { return is_compact() ? _latin1.length() : _wide.length(); }
+	_FORCE_INLINE_ bool is_empty() const { return length() == 0; }
+	// Bytes used for the characters, not counting the terminating zero or the shared header.
+	_FORCE_INLINE_ int get_storage_size() const { return is_compact() ? _latin1.length() : _wide.length() * (int)sizeof(char32_t); }
+
+	_FORCE_INLINE_ char32_t operator[](int p_index) const {
+		if (is_compact()) {
+			return p_index == _latin1.size() ? 0 : (uint8_t)_latin1.get(p_index);
+		}
+		return _wide[p_index];
+	}
+
+	String to_string() const;
+	_FORCE_INLINE_ operator String() const { return to_string(); }
+
+	// ASCII text is handed out without transcoding.
+	CharString utf8() const;
+	static CompactString from_utf8(const char *p_utf8, int p_len = -1);
+
+	uint32_t hash() const;
+
+	bool operator==(const CompactString &p_str) const;
+	bool operator!=(const CompactString &p_str) const { return !(*this == p_str); }
+	bool operator==(const String &p_str) const;
+	bool operator!=(const String &p_str) const { return !(*this == p_str); }
+	bool operator==(const char *p_latin1) const;
+	bool operator!=(const char *p_latin1) const { return !(*this == p_latin1); }
+	bool operator<(const CompactString &p_str) const;
+
+	CompactString operator+(const CompactString &p_str) const;
+	CompactString &operator+=(const CompactString &p_str);
+
+	int find(const CompactString &p_str, int p_from = 0) const; ///< return <0 if failed
+	int find_char(char32_t p_char, int p_from = 0) const; ///< return <0 if failed
+	bool begins_with(const CompactString &p_str) const;
+	CompactString substr(int p_from, int p_chars = -1) const;
+	Vector<CompactString> split(const CompactString &p_splitter, bool p_allow_empty = true, int p_maxsplit = 0) const;
+
+	CompactString() {}
+	CompactString(const String &p_str);
+	CompactString(const char *p_latin1);
+};
+
+_FORCE_INLINE_ bool operator==(const String &p_a, const CompactString &p_b) {
+	return p_b == p_a;
+}
+
+_FORCE_INLINE_ bool operator!=(const String &p_a, const CompactString &p_b) {
+	return p_b != p_a;
+}
+
+// Hashes like the equivalent String, for HashMap<CompactString, T, CompactStringHasher>.
+struct CompactStringHasher {
+	static _FORCE_INLINE_ uint32_t hash(const CompactString &p_string) { return p_string.hash(); }
+};
+
+#endif // COMPACT_STRING_H
@@ -39,7 +39,56 @@ StaticCString StaticCString::create(const char *p_ptr) {
 	return scs;
 }
 
-StringName::_Data *StringName::_table[STRING_TABLE_LEN];
+struct StringName::_Table {
+	uint32_t mask = 0;
+	std::atomic<_Data *> *buckets = nullptr;
+	_Table *retired_next = nullptr;
+};
+
+// Lookups announce themselves in a reader slot picked per thread, so lookups from many
+// threads don't all contend on the same cache line. Reclaiming has to check every slot.
+static constexpr uint32_t STRINGNAME_READER_SLOTS = 64;
+
+struct alignas(64) StringNameReaderSlot {
+	std::atomic<uint32_t> readers[2] = {};
+};
+
+static StringNameReaderSlot stringname_reader_slots[STRINGNAME_READER_SLOTS];
+static std::atomic<uint32_t> stringname_reader_slot_next = { 0 };
+
+static _FORCE_INLINE_ StringNameReaderSlot &_get_reader_slot() {
+	static thread_local uint32_t index = stringname_reader_slot_next.fetch_add(1, std::memory_order_relaxed) % STRINGNAME_READER_SLOTS;
+	return stringname_reader_slots[index];
+}
+
+// Registers a lookup in the current epoch, so nothing it can reach is freed until it ends.
+struct StringName::_ReadGuard {
+	std::atomic<uint32_t> *readers = nullptr;
+
+	_ReadGuard() {
+		StringNameReaderSlot &slot = _get_reader_slot();
+		while (true) {
+			uint32_t current = epoch.load();
+			readers = &slot.readers[current & 1];
+			readers->fetch_add(1);
+			if (epoch.load() == current) {
+				break;
+			}
+			// The epoch moved on before we were counted, register again.
+			readers->fetch_sub(1);
+		}
+	}
+
+	~_ReadGuard() {
+		readers->fetch_sub(1);
+	}
+};
+
+std::atomic<StringName::_Table *> StringName::table = { nullptr };
+uint32_t StringName::entry_count = 0;
+std::atomic<uint32_t> StringName::epoch = { 0 };
+StringName::_Data *StringName::retired_data[3] = {};
+StringName::_Table *StringName::retired_tables[3] = {};
 
 StringName _scs_create(const char *p_chr, bool p_static) {
 	return (p_chr[0] ? StringName(StaticCString::create(p_chr), p_static) : StringName());
@@ -52,25 +101,191 @@ Mutex StringName::mutex;
 bool StringName::debug_stringname = false;
 #endif
 
+StringName::_Table *StringName::_create_table(uint32_t p_bits) {
+	_Table *t = memnew(_Table);
+	t->mask = (1u << p_bits) - 1;
+	t->buckets = memnew_arr(std::atomic<_Data *>, t->mask + 1);
+	for (uint32_t i = 0; i <= t->mask; i++) {
+		t->buckets[i].store(nullptr, std::memory_order_relaxed);
+	}
+	return t;
+}
+
+void StringName::_grow_table() {
+	_Table *old_table = table.load(std::memory_order_relaxed);
+	uint32_t bits = 0;
+	while ((1u << bits) <= old_table->mask) {
+		bits++;
+	}
+	_Table *new_table = _create_table(bits + 1);
+
+	// Lookups still walking the old buckets may be led into a new chain and miss an entry.
+	// That is fine, a miss is always retried with the lock held.
+	for (uint32_t i = 0; i <= old_table->mask; i++) {
+		_Data *d = old_table->buckets[i].load(std::memory_order_relaxed);
+		while (d) {
+			_Data *next = d->next.load(std::memory_order_relaxed);
+			uint32_t idx = d->hash & new_table->mask;
+			_Data *head = new_table->buckets[idx].load(std::memory_order_relaxed);
+			d->prev = nullptr;
+			d->next.store(head, std::memory_order_release);
+			if (head) {
+				head->prev = d;
+			}
+			new_table->buckets[idx].store(d, std::memory_order_relaxed);
+			d = next;
+		}
+	}
+
+	table.store(new_table, std::memory_order_release);
+
+	uint32_t slot = epoch.load() % 3;
+	old_table->retired_next = retired_tables[slot];
+	retired_tables[slot] = old_table;
+}
+
+void StringName::_retire(_Data *p_data) {
+	uint32_t slot = epoch.load() % 3;
+	p_data->retired_next = retired_data[slot];
+	retired_data[slot] = p_data;
+	_reclaim();
+}
+
+void StringName::_reclaim() {
+	// Moving to the next epoch requires every lookup from the previous one to be over. Lookups
+	// still running then started after anything retired two epochs ago was unlinked, so it can go.
+	uint32_t current = epoch.load();
+	for (const StringNameReaderSlot &reader_slot : stringname_reader_slots) {
+		if (reader_slot.readers[(current + 1) & 1].load() != 0) {
+			return;
+		}
+	}
+
+	uint32_t slot = (current + 1) % 3;
+	while (retired_data[slot]) {
+		_Data *d = retired_data[slot];
+		retired_data[slot] = d->retired_next;
+		memdelete(d);
+	}
+	while (retired_tables[slot]) {
+		_Table *t = retired_tables[slot];
+		retired_tables[slot] = t->retired_next;
+		memdelete_arr(t->buckets);
+		memdelete(t);
+	}
+
+	epoch.store(current + 1);
+}
+
+bool StringName::_lookup_needs_lock() {
+#ifdef DEBUG_ENABLED
+	// The reference ranking is counted with the lock held.
+	return debug_stringname;
+#else
+	return false;
+#endif
+}
+
+template <typename T>
+StringName::_Data *StringName::_find_and_ref(uint32_t p_hash, const T &p_name) {
+	_ReadGuard guard;
+
+	const _Table *t = table.load(std::memory_order_acquire);
+	_Data *d = t->buckets[p_hash & t->mask].load(std::memory_order_acquire);
+	while (d) {
+		// Compare hash first. Entries being released can't be referenced anymore, skip them.
+		if (d->hash == p_hash && d->get_name() == p_name && d->refcount.ref()) {
+			return d;
+		}
+		d = d->next.load(std::memory_order_acquire);
+	}
+
+	return nullptr;
+}
+
+template <typename T>
+StringName::_Data *StringName::_intern(uint32_t p_hash, const T &p_name, const char *p_cname, bool p_static) {
+	_Data *data = _lookup_needs_lock() ? nullptr : _find_and_ref(p_hash, p_name);
+	if (data) {
+		// exists
+		if (p_static) {
+			data->static_count.increment();
+		}
+		return data;
+	}
+
+	MutexLock lock(mutex);
+
+	data = _find_and_ref(p_hash, p_name);
+	if (data) {
+		// exists
+		if (p_static) {
+			data->static_count.increment();
+		}
+#ifdef DEBUG_ENABLED
+		if (unlikely(debug_stringname)) {
+			data->debug_references++;
+		}
+#endif
+		return data;
+	}
+
+	data = memnew(_Data);
+	if (p_cname) {
+		data->cname = p_cname;
+	} else {
+		data->name = p_name;
+	}
+	data->refcount.init();
+	data->static_count.set(p_static ? 1 : 0);
+	data->hash = p_hash;
+
+#ifdef DEBUG_ENABLED
+	if (unlikely(debug_stringname)) {
+		// Keep in memory, force static.
+		data->refcount.ref();
+		data->static_count.increment();
+	}
+#endif
+
+	if (entry_count > table.load(std::memory_order_relaxed)->mask) {
+		_grow_table();
+	}
+
+	_Table *t = table.load(std::memory_order_relaxed);
+	uint32_t idx = p_hash & t->mask;
+	_Data *head = t->buckets[idx].load(std::memory_order_relaxed);
+	data->next.store(head, std::memory_order_relaxed);
+	if (head) {
+		head->prev = data;
+	}
+	// Publishes the fully built entry to lookups.
+	t->buckets[idx].store(data, std::memory_order_release);
+	entry_count++;
+
+	return data;
+}
+
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		_table[i] = nullptr;
-	}
+	table.store(_create_table(STRING_TABLE_MIN_BITS));
+	entry_count = 0;
 	configured = true;
 }
 
 void StringName::cleanup() {
 	MutexLock lock(mutex);
 
+	_Table *t = table.load();
+
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
-		for (int i = 0; i < STRING_TABLE_LEN; i++) {
-			_Data *d = _table[i];
+		for (uint32_t i = 0; i <= t->mask; i++) {
+			_Data *d = t->buckets[i].load();
 			while (d) {
 				data.push_back(d);
-				d = d->next;
+				d = d->next.load();
 			}
 		}
 
@@ -93,9 +308,9 @@ void StringName::cleanup() {
 	}
 #endif
 	int lost_strings = 0;
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		while (_table[i]) {
-			_Data *d = _table[i];
+	for (uint32_t i = 0; i <= t->mask; i++) {
+		_Data *d = t->buckets[i].load();
+		while (d) {
 			if (d->static_count.get() != d->refcount.get()) {
 				lost_strings++;
 
@@ -106,13 +321,35 @@ void StringName::cleanup() {
 				}
 			}
 
-			_table[i] = _table[i]->next;
+			_Data *next = d->next.load();
 			memdelete(d);
+			d = next;
 		}
 	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
+
+	memdelete_arr(t->buckets);
+	memdelete(t);
+	table.store(nullptr);
+	entry_count = 0;
+
+	// Nothing can be looking up anymore, release everything still waiting for its epoch.
+	for (int slot = 0; slot < 3; slot++) {
+		while (retired_data[slot]) {
+			_Data *d = retired_data[slot];
+			retired_data[slot] = d->retired_next;
+			memdelete(d);
+		}
+		while (retired_tables[slot]) {
+			_Table *retired = retired_tables[slot];
+			retired_tables[slot] = retired->retired_next;
+			memdelete_arr(retired->buckets);
+			memdelete(retired);
+		}
+	}
+
 	configured = false;
 }
 
@@ -129,19 +366,26 @@ void StringName::unref() {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->name));
 			}
 		}
+
+		_Data *next = _data->next.load(std::memory_order_relaxed);
 		if (_data->prev) {
-			_data->prev->next = _data->next;
+			_data->prev->next.store(next, std::memory_order_release);
 		} else {
-			if (_table[_data->idx] != _data) {
+			_Table *t = table.load(std::memory_order_relaxed);
+			uint32_t idx = _data->hash & t->mask;
+			if (t->buckets[idx].load(std::memory_order_relaxed) != _data) {
 				ERR_PRINT("BUG!");
 			}
-			_table[_data->idx] = _data->next;
+			t->buckets[idx].store(next, std::memory_order_release);
 		}
 
-		if (_data->next) {
-			_data->next->prev = _data->prev;
+		if (next) {
+			next->prev = _data->prev;
 		}
-		memdelete(_data);
+		entry_count--;
+
+		// Lookups may still be reading it, it's freed once they are done.
+		_retire(_data);
 	}
 
 	_data = nullptr;
@@ -189,6 +433,18 @@ void StringName::operator=(const StringName &p_name) {
 	}
 }
 
+void StringName::operator=(StringName &&p_name) {
+	if (this == &p_name) {
+		return;
+	}
+
+	if (_data) {
+		unref();
+	}
+	_data = p_name._data;
+	p_name._data = nullptr;
+}
+
 StringName::StringName(const StringName &p_name) {
 	_data = nullptr;
 
@@ -216,56 +472,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_data = _intern(String::hash(p_name), p_name, nullptr, p_static);
 }
 
 StringName::StringName(const StaticCString &p_static_string, bool p_static) {
@@ -275,55 +482,7 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_static_string.ptr);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_static_string.ptr) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = memnew(_Data);
-
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_data = _intern(String::hash(p_static_string.ptr), p_static_string.ptr, p_static_string.ptr, p_static);
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -335,54 +494,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = p_name.hash();
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_data = _intern(p_name.hash(), p_name, nullptr, p_static);
 }
 
 StringName StringName::search(const char *p_name) {
@@ -393,29 +505,25 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
-	uint32_t idx = hash & STRING_TABLE_MASK;
 
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
+	if (likely(!_lookup_needs_lock())) {
+		_Data *data = _find_and_ref(hash, p_name);
+		if (data) {
+			return StringName(data);
 		}
-		_data = _data->next;
 	}
 
-	if (_data && _data->refcount.ref()) {
+	MutexLock lock(mutex);
+
+	_Data *data = _find_and_ref(hash, p_name);
+	if (data) {
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
+			data->debug_references++;
 		}
 #endif
-
-		return StringName(_data);
+		return StringName(data);
 	}
 
 	return StringName(); //does not exist
@@ -429,24 +537,20 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
+	if (likely(!_lookup_needs_lock())) {
+		_Data *data = _find_and_ref(hash, p_name);
+		if (data) {
+			return StringName(data);
 		}
-		_data = _data->next;
 	}
 
-	if (_data && _data->refcount.ref()) {
-		return StringName(_data);
+	MutexLock lock(mutex);
+
+	_Data *data = _find_and_ref(hash, p_name);
+	if (data) {
+		return StringName(data);
 	}
 
 	return StringName(); //does not exist
@@ -455,29 +559,25 @@ StringName StringName::search(const char32_t *p_name) {
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name.is_empty(), StringName());
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && p_name == _data->get_name()) {
-			break;
+	if (likely(!_lookup_needs_lock())) {
+		_Data *data = _find_and_ref(hash, p_name);
+		if (data) {
+			return StringName(data);
 		}
-		_data = _data->next;
 	}
 
-	if (_data && _data->refcount.ref()) {
+	MutexLock lock(mutex);
+
+	_Data *data = _find_and_ref(hash, p_name);
+	if (data) {
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
+			data->debug_references++;
 		}
 #endif
-		return StringName(_data);
+		return StringName(data);
 	}
 
 	return StringName(); //does not exist
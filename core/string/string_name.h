@@ -46,9 +46,7 @@ struct StaticCString {
 
 class StringName {
 	enum {
-		STRING_TABLE_BITS = 16,
-		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MIN_BITS = 12,
 	};
 
 	struct _Data {
@@ -60,14 +58,33 @@ class StringName {
 		uint32_t debug_references = 0;
 #endif
 		String get_name() const { return cname ? String(cname) : name; }
-		int idx = 0;
 		uint32_t hash = 0;
-		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		std::atomic<_Data *> next = { nullptr }; // Followed by lookups without the lock.
+		_Data *prev = nullptr; // Only used with the lock held.
+		_Data *retired_next = nullptr;
 		_Data() {}
 	};
 
-	static _Data *_table[STRING_TABLE_LEN];
+	// Lookups walk the table without locking. Links only change with the mutex held, and unlinked
+	// entries and replaced bucket arrays are kept until no lookup that could still see them runs.
+	struct _Table;
+	struct _ReadGuard;
+
+	static std::atomic<_Table *> table;
+	static uint32_t entry_count;
+	static std::atomic<uint32_t> epoch;
+	static _Data *retired_data[3];
+	static _Table *retired_tables[3];
+
+	static _Table *_create_table(uint32_t p_bits);
+	static void _grow_table();
+	static void _retire(_Data *p_data);
+	static void _reclaim();
+	template <typename T>
+	static _Data *_find_and_ref(uint32_t p_hash, const T &p_name);
+	template <typename T>
+	static _Data *_intern(uint32_t p_hash, const T &p_name, const char *p_cname, bool p_static);
+	static bool _lookup_needs_lock();
 
 	_Data *_data = nullptr;
 
@@ -176,8 +193,13 @@ public:
 	};
 
 	void operator=(const StringName &p_name);
+	void operator=(StringName &&p_name);
 	StringName(const char *p_name, bool p_static = false);
 	StringName(const StringName &p_name);
+	_FORCE_INLINE_ StringName(StringName &&p_name) {
+		_data = p_name._data;
+		p_name._data = nullptr;
+	}
 	StringName(const String &p_name, bool p_static = false);
 	StringName(const StaticCString &p_static_string, bool p_static = false);
 	StringName() {}
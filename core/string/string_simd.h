@@ -0,0 +1,301 @@
+/**************************************************************************/
+/*  string_simd.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef STRING_SIMD_H
+#define STRING_SIMD_H
+
+#include "core/string/char_utils.h"
+#include "core/typedefs.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STRING_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define STRING_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+/**
+ * Character scanning kernels for String.
+ *
+ * Each kernel checks four UTF-32 characters (or sixteen bytes) per step with
+ * SSE2 or NEON, which every x86_64 and arm64 CPU has, and finishes with the
+ * scalar loop. On other targets only the scalar loop remains. A step that
+ * contains a hit stops the vector loop, and the scalar loop finds the exact
+ * position, so vector and scalar paths always agree.
+ */
+
+#if defined(STRING_SIMD_SSE2)
+
+typedef __m128i StringSIMDChars;
+
+static _FORCE_INLINE_ StringSIMDChars _string_simd_load(const char32_t *p_str) {
+	return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_str));
+}
+
+static _FORCE_INLINE_ StringSIMDChars _string_simd_eq(StringSIMDChars p_chars, char32_t p_char) {
+	return _mm_cmpeq_epi32(p_chars, _mm_set1_epi32((int)p_char));
+}
+
+// Lanes in [p_min, p_max]. Both bounds must be below 0x7fffffff; larger lanes never match.
+static _FORCE_INLINE_ StringSIMDChars _string_simd_in_range(StringSIMDChars p_chars, char32_t p_min, char32_t p_max) {
+	return _mm_and_si128(_mm_cmpgt_epi32(p_chars, _mm_set1_epi32((int)p_min - 1)), _mm_cmplt_epi32(p_chars, _mm_set1_epi32((int)p_max + 1)));
+}
+
+static _FORCE_INLINE_ StringSIMDChars _string_simd_or(StringSIMDChars p_a, StringSIMDChars p_b) {
+	return _mm_or_si128(p_a, p_b);
+}
+
+static _FORCE_INLINE_ bool _string_simd_any(StringSIMDChars p_mask) {
+	return _mm_movemask_epi8(p_mask) != 0;
+}
+
+static _FORCE_INLINE_ bool _string_simd_all(StringSIMDChars p_mask) {
+	return _mm_movemask_epi8(p_mask) == 0xFFFF;
+}
+
+#elif defined(STRING_SIMD_NEON)
+
+typedef uint32x4_t StringSIMDChars;
+
+static _FORCE_INLINE_ StringSIMDChars _string_simd_load(const char32_t *p_str) {
+	return vld1q_u32(reinterpret_cast<const uint32_t *>(p_str));
+}
+
+static _FORCE_INLINE_ StringSIMDChars _string_simd_eq(StringSIMDChars p_chars, char32_t p_char) {
+	return vceqq_u32(p_chars, vdupq_n_u32(p_char));
+}
+
+static _FORCE_INLINE_ StringSIMDChars _string_simd_in_range(StringSIMDChars p_chars, char32_t p_min, char32_t p_max) {
+	return vandq_u32(vcgeq_u32(p_chars, vdupq_n_u32(p_min)), vcleq_u32(p_chars, vdupq_n_u32(p_max)));
+}
+
+static _FORCE_INLINE_ StringSIMDChars _string_simd_or(StringSIMDChars p_a, StringSIMDChars p_b) {
+	return vorrq_u32(p_a, p_b);
+}
+
+static _FORCE_INLINE_ bool _string_simd_any(StringSIMDChars p_mask) {
+	return vmaxvq_u32(p_mask) != 0;
+}
+
+static _FORCE_INLINE_ bool _string_simd_all(StringSIMDChars p_mask) {
+	return vminvq_u32(p_mask) != 0;
+}
+
+#endif
+
+#if defined(STRING_SIMD_SSE2) || defined(STRING_SIMD_NEON)
+#define STRING_SIMD_ENABLED
+#endif
+
+// Position of the first p_char in [p_from, p_to), or -1.
+static _FORCE_INLINE_ int string_simd_find_char(const char32_t *p_str, int p_from, int p_to, char32_t p_char) {
+	int i = p_from;
+#ifdef STRING_SIMD_ENABLED
+	for (; i + 4 <= p_to; i += 4) {
+		if (_string_simd_any(_string_simd_eq(_string_simd_load(p_str + i), p_char))) {
+			break;
+		}
+	}
+#endif
+	for (; i < p_to; i++) {
+		if (p_str[i] == p_char) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Position of the first character in [p_from, p_to) that is p_lower, p_upper or non-ASCII, or -1.
+// Used to find where a case-insensitive match of an ASCII character can start, since a few
+// non-ASCII characters lowercase to ASCII letters.
+static _FORCE_INLINE_ int string_simd_find_nocase_start(const char32_t *p_str, int p_from, int p_to, char32_t p_lower, char32_t p_upper) {
+	int i = p_from;
+#ifdef STRING_SIMD_ENABLED
+	for (; i + 4 <= p_to; i += 4) {
+		const StringSIMDChars chars = _string_simd_load(p_str + i);
+		if (!_string_simd_all(_string_simd_in_range(chars, 0, 0x7F)) || _string_simd_any(_string_simd_or(_string_simd_eq(chars, p_lower), _string_simd_eq(chars, p_upper)))) {
+			break;
+		}
+	}
+#endif
+	for (; i < p_to; i++) {
+		const char32_t c = p_str[i];
+		if (c == p_lower || c == p_upper || c > 0x7F) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Position of the first character in [p_from, p_to) within [p_min, p_max], or -1.
+static _FORCE_INLINE_ int string_simd_find_in_range(const char32_t *p_str, int p_from, int p_to, char32_t p_min, char32_t p_max) {
+	int i = p_from;
+#ifdef STRING_SIMD_ENABLED
+	for (; i + 4 <= p_to; i += 4) {
+		if (_string_simd_any(_string_simd_in_range(_string_simd_load(p_str + i), p_min, p_max))) {
+			break;
+		}
+	}
+#endif
+	for (; i < p_to; i++) {
+		if (p_str[i] >= p_min && p_str[i] <= p_max) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Number of leading ASCII characters.
+static _FORCE_INLINE_ int string_simd_ascii_prefix(const char32_t *p_str, int p_len) {
+	int i = 0;
+#ifdef STRING_SIMD_ENABLED
+	for (; i + 4 <= p_len; i += 4) {
+		if (!_string_simd_all(_string_simd_in_range(_string_simd_load(p_str + i), 0, 0x7F))) {
+			break;
+		}
+	}
+#endif
+	while (i < p_len && p_str[i] <= 0x7F) {
+		i++;
+	}
+	return i;
+}
+
+// Number of leading characters that are ASCII letters, digits or underscores.
+static _FORCE_INLINE_ int string_simd_ascii_identifier_prefix(const char32_t *p_str, int p_len) {
+	int i = 0;
+#ifdef STRING_SIMD_ENABLED
+	for (; i + 4 <= p_len; i += 4) {
+		const StringSIMDChars chars = _string_simd_load(p_str + i);
+		const StringSIMDChars letters = _string_simd_or(_string_simd_in_range(chars, 'a', 'z'), _string_simd_in_range(chars, 'A', 'Z'));
+		if (!_string_simd_all(_string_simd_or(_string_simd_or(letters, _string_simd_in_range(chars, '0', '9')), _string_simd_eq(chars, '_')))) {
+			break;
+		}
+	}
+#endif
+	while (i < p_len && is_ascii_identifier_char(p_str[i])) {
+		i++;
+	}
+	return i;
+}
+
+// Converts ASCII uppercase letters to lowercase in place, leaving everything else untouched.
+static _FORCE_INLINE_ void string_simd_ascii_to_lower(char32_t *p_str, int p_len) {
+	int i = 0;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i case_bit = _mm_set1_epi32(0x20);
+	for (; i + 4 <= p_len; i += 4) {
+		const __m128i chars = _string_simd_load(p_str + i);
+		const __m128i upper = _string_simd_in_range(chars, 'A', 'Z');
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(p_str + i), _mm_or_si128(chars, _mm_and_si128(upper, case_bit)));
+	}
+#elif defined(STRING_SIMD_NEON)
+	const uint32x4_t case_bit = vdupq_n_u32(0x20);
+	for (; i + 4 <= p_len; i += 4) {
+		const uint32x4_t chars = _string_simd_load(p_str + i);
+		const uint32x4_t upper = _string_simd_in_range(chars, 'A', 'Z');
+		vst1q_u32(reinterpret_cast<uint32_t *>(p_str + i), vorrq_u32(chars, vandq_u32(upper, case_bit)));
+	}
+#endif
+	for (; i < p_len; i++) {
+		if (p_str[i] >= 'A' && p_str[i] <= 'Z') {
+			p_str[i] += 0x20;
+		}
+	}
+}
+
+// Stores p_len ASCII characters as bytes.
+static _FORCE_INLINE_ void string_simd_narrow_ascii(const char32_t *p_src, int p_len, uint8_t *r_dst) {
+	int i = 0;
+#if defined(STRING_SIMD_SSE2)
+	for (; i + 8 <= p_len; i += 8) {
+		const __m128i words = _mm_packs_epi32(_string_simd_load(p_src + i), _string_simd_load(p_src + i + 4));
+		_mm_storel_epi64(reinterpret_cast<__m128i *>(r_dst + i), _mm_packus_epi16(words, words));
+	}
+#elif defined(STRING_SIMD_NEON)
+	for (; i + 8 <= p_len; i += 8) {
+		const uint16x8_t words = vcombine_u16(vmovn_u32(_string_simd_load(p_src + i)), vmovn_u32(_string_simd_load(p_src + i + 4)));
+		vst1_u8(r_dst + i, vmovn_u16(words));
+	}
+#endif
+	for (; i < p_len; i++) {
+		r_dst[i] = (uint8_t)p_src[i];
+	}
+}
+
+// Widens p_len bytes to characters.
+static _FORCE_INLINE_ void string_simd_widen_ascii(const uint8_t *p_src, int p_len, char32_t *r_dst) {
+	int i = 0;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 8 <= p_len; i += 8) {
+		const __m128i words = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p_src + i)), zero);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(r_dst + i), _mm_unpacklo_epi16(words, zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(r_dst + i + 4), _mm_unpackhi_epi16(words, zero));
+	}
+#elif defined(STRING_SIMD_NEON)
+	for (; i + 8 <= p_len; i += 8) {
+		const uint16x8_t words = vmovl_u8(vld1_u8(p_src + i));
+		vst1q_u32(reinterpret_cast<uint32_t *>(r_dst + i), vmovl_u16(vget_low_u16(words)));
+		vst1q_u32(reinterpret_cast<uint32_t *>(r_dst + i + 4), vmovl_u16(vget_high_u16(words)));
+	}
+#endif
+	for (; i < p_len; i++) {
+		r_dst[i] = p_src[i];
+	}
+}
+
+// Number of leading bytes that are ASCII and not zero.
+static _FORCE_INLINE_ int string_simd_ascii_prefix_bytes(const uint8_t *p_src, int p_len) {
+	int i = 0;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_src + i));
+		if ((_mm_movemask_epi8(bytes) | _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero))) != 0) {
+			break;
+		}
+	}
+#elif defined(STRING_SIMD_NEON)
+	for (; i + 16 <= p_len; i += 16) {
+		const uint8x16_t bytes = vld1q_u8(p_src + i);
+		if (vmaxvq_u8(bytes) > 0x7F || vminvq_u8(bytes) == 0) {
+			break;
+		}
+	}
+#endif
+	while (i < p_len && p_src[i] != 0 && p_src[i] <= 0x7F) {
+		i++;
+	}
+	return i;
+}
+
+#endif // STRING_SIMD_H
@@ -36,6 +36,7 @@
 #include "core/os/memory.h"
 #include "core/string/print_string.h"
 #include "core/string/string_name.h"
+#include "core/string/string_simd.h"
 #include "core/string/translation.h"
 #include "core/string/ucaps.h"
 #include "core/variant/variant.h"
@@ -1672,6 +1673,19 @@ String String::to_upper() const {
 }
 
 String String::to_lower() const {
+	const int len = length();
+	const char32_t *src = get_data();
+	if (string_simd_ascii_prefix(src, len) == len) {
+		// ASCII only, the common case.
+		const int first_upper = string_simd_find_in_range(src, 0, len, 'A', 'Z');
+		if (first_upper < 0) {
+			return *this;
+		}
+		String lower = *this;
+		string_simd_ascii_to_lower(lower.ptrw() + first_upper, len - first_upper);
+		return lower;
+	}
+
 	String lower = *this;
 
 	for (int i = 0; i < lower.size(); i++) {
@@ -2018,6 +2032,22 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 		}
 	}
 
+	{
+		// Pure ASCII needs no decoding, widen it in bulk.
+		const int len = p_len >= 0 ? p_len : strlen(p_utf8);
+		if (string_simd_ascii_prefix_bytes((const uint8_t *)p_utf8, len) == len && !(p_skip_cr && memchr(p_utf8, '\r', len))) {
+			if (len == 0) {
+				clear();
+				return OK;
+			}
+			resize(len + 1);
+			char32_t *dst = ptrw();
+			string_simd_widen_ascii((const uint8_t *)p_utf8, len, dst);
+			dst[len] = 0;
+			return OK;
+		}
+	}
+
 	bool decode_error = false;
 	bool decode_failed = false;
 	{
@@ -2183,8 +2213,10 @@ CharString String::utf8() const {
 	}
 
 	const char32_t *d = &operator[](0);
-	int fl = 0;
-	for (int i = 0; i < l; i++) {
+	// The ASCII prefix, usually the whole string, is copied in bulk.
+	const int ascii = string_simd_ascii_prefix(d, l);
+	int fl = ascii;
+	for (int i = ascii; i < l; i++) {
 		uint32_t c = d[i];
 		if (c <= 0x7f) { // 7 bits.
 			fl += 1;
@@ -2214,9 +2246,12 @@ CharString String::utf8() const {
 	utf8s.resize(fl + 1);
 	uint8_t *cdst = (uint8_t *)utf8s.get_data();
 
+	string_simd_narrow_ascii(d, ascii, cdst);
+	cdst += ascii;
+
 #define APPEND_CHAR(m_c) *(cdst++) = m_c
 
-	for (int i = 0; i < l; i++) {
+	for (int i = ascii; i < l; i++) {
 		uint32_t c = d[i];
 
 		if (c <= 0x7f) { // 7 bits.
@@ -3061,12 +3096,18 @@ uint32_t String::hash() const {
 	/* simple djb2 hashing */
 
 	const char32_t *chr = get_data();
+	const int len = length();
 	uint32_t hashv = 5381;
-	uint32_t c = *chr++;
 
-	while (c) {
-		hashv = ((hashv << 5) + hashv) + c; /* hash * 33 + c */
-		c = *chr++;
+	// Four characters per step: hash * 33^4 + (c0 * 33^3 + c1 * 33^2 + c2 * 33 + c3).
+	// The character terms don't depend on the running hash, which shortens the dependency chain.
+	int i = 0;
+	for (; i + 4 <= len; i += 4) {
+		const uint32_t chars = ((uint32_t(chr[i]) * 33 + uint32_t(chr[i + 1])) * 33 + uint32_t(chr[i + 2])) * 33 + uint32_t(chr[i + 3]);
+		hashv = hashv * (33 * 33 * 33 * 33) + chars;
+	}
+	for (; i < len; i++) {
+		hashv = ((hashv << 5) + hashv) + chr[i]; /* hash * 33 + c */
 	}
 
 	return hashv;
@@ -3213,24 +3254,16 @@ int String::find(const String &p_str, int p_from) const {
 
 	const char32_t *src = get_data();
 	const char32_t *str = p_str.get_data();
+	const int last = len - src_len;
 
-	for (int i = p_from; i <= (len - src_len); i++) {
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-			int read_pos = i + j;
-
-			if (read_pos >= len) {
-				ERR_PRINT("read_pos>=len");
-				return -1;
-			}
-
-			if (src[read_pos] != str[j]) {
-				found = false;
-				break;
-			}
+	for (int i = p_from; i <= last; i++) {
+		// Jump to the next occurrence of the first character, then compare the rest.
+		i = string_simd_find_char(src, i, last + 1, str[0]);
+		if (i < 0) {
+			return -1;
 		}
 
-		if (found) {
+		if (memcmp(src + i + 1, str + 1, (src_len - 1) * sizeof(char32_t)) == 0) {
 			return i;
 		}
 	}
@@ -3254,34 +3287,27 @@ int String::find(const char *p_str, int p_from) const {
 	const char32_t *src = get_data();
 
 	if (src_len == 1) {
-		const char32_t needle = p_str[0];
+		return string_simd_find_char(src, p_from, len, (char32_t)p_str[0]);
+	}
 
-		for (int i = p_from; i < len; i++) {
-			if (src[i] == needle) {
-				return i;
-			}
+	const int last = len - src_len;
+	for (int i = p_from; i <= last; i++) {
+		// Jump to the next occurrence of the first character, then compare the rest.
+		i = string_simd_find_char(src, i, last + 1, (char32_t)p_str[0]);
+		if (i < 0) {
+			return -1;
 		}
 
-	} else {
-		for (int i = p_from; i <= (len - src_len); i++) {
-			bool found = true;
-			for (int j = 0; j < src_len; j++) {
-				int read_pos = i + j;
-
-				if (read_pos >= len) {
-					ERR_PRINT("read_pos>=len");
-					return -1;
-				}
-
-				if (src[read_pos] != (char32_t)p_str[j]) {
-					found = false;
-					break;
-				}
+		bool found = true;
+		for (int j = 1; j < src_len; j++) {
+			if (src[i + j] != (char32_t)p_str[j]) {
+				found = false;
+				break;
 			}
+		}
 
-			if (found) {
-				return i;
-			}
+		if (found) {
+			return i;
 		}
 	}
 
@@ -3289,7 +3315,11 @@ int String::find(const char *p_str, int p_from) const {
 }
 
 int String::find_char(const char32_t &p_char, int p_from) const {
-	return _cowdata.find(p_char, p_from);
+	if (p_from < 0) {
+		return -1;
+	}
+	// Searches the terminating zero too, like CowData::find().
+	return string_simd_find_char(get_data(), p_from, size(), p_char);
 }
 
 int String::findmk(const Vector<String> &p_keys, int p_from, int *r_key) const {
@@ -3359,17 +3389,26 @@ int String::findn(const String &p_str, int p_from) const {
 	}
 
 	const char32_t *srcd = get_data();
+	const int last = length() - src_len;
+
+	// Matches of an ASCII first character can only start at either of its cases, or at a
+	// non-ASCII character that lowercases to it, so skip ahead to those.
+	const char32_t first = _find_lower(p_str[0]);
+	const bool skip_ahead = first <= 0x7F;
+	const char32_t first_upper = is_ascii_lower_case(first) ? first - ('a' - 'A') : first;
+
+	for (int i = p_from; i <= last; i++) {
+		if (skip_ahead) {
+			i = string_simd_find_nocase_start(srcd, i, last + 1, first, first_upper);
+			if (i < 0) {
+				return -1;
+			}
+		}
 
-	for (int i = p_from; i <= (length() - src_len); i++) {
 		bool found = true;
 		for (int j = 0; j < src_len; j++) {
 			int read_pos = i + j;
 
-			if (read_pos >= length()) {
-				ERR_PRINT("read_pos>=length()");
-				return -1;
-			}
-
 			char32_t src = _find_lower(srcd[read_pos]);
 			char32_t dst = _find_lower(p_str[j]);
 
@@ -3399,17 +3438,26 @@ int String::findn(const char *p_str, int p_from) const {
 	}
 
 	const char32_t *srcd = get_data();
+	const int last = length() - src_len;
+
+	// Matches of an ASCII first character can only start at either of its cases, or at a
+	// non-ASCII character that lowercases to it, so skip ahead to those.
+	const char32_t first = _find_lower(p_str[0]);
+	const bool skip_ahead = first <= 0x7F;
+	const char32_t first_upper = is_ascii_lower_case(first) ? first - ('a' - 'A') : first;
+
+	for (int i = p_from; i <= last; i++) {
+		if (skip_ahead) {
+			i = string_simd_find_nocase_start(srcd, i, last + 1, first, first_upper);
+			if (i < 0) {
+				return -1;
+			}
+		}
 
-	for (int i = p_from; i <= (length() - src_len); i++) {
 		bool found = true;
 		for (int j = 0; j < src_len; j++) {
 			int read_pos = i + j;
 
-			if (read_pos >= length()) {
-				ERR_PRINT("read_pos>=length()");
-				return -1;
-			}
-
 			char32_t src = _find_lower(srcd[read_pos]);
 			char32_t dst = _find_lower(p_str[j]);
 
@@ -4500,15 +4548,7 @@ bool String::is_valid_identifier() const {
 		return false;
 	}
 
-	const char32_t *str = &operator[](0);
-
-	for (int i = 0; i < len; i++) {
-		if (!is_ascii_identifier_char(str[i])) {
-			return false;
-		}
-	}
-
-	return true;
+	return string_simd_ascii_identifier_prefix(get_data(), len) == len;
 }
 
 bool String::is_valid_string() const {
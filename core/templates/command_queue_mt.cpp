@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/os/os.h"
+#include "core/templates/safe_refcount.h"
 
 void CommandQueueMT::lock() {
 	mutex.lock();
@@ -41,9 +42,170 @@ void CommandQueueMT::unlock() {
 	mutex.unlock();
 }
 
-CommandQueueMT::CommandQueueMT() {
-	command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
+// Lock-free mode allocates commands from per-thread chunks. A chunk starts
+// with a large bias on its refcount; the consumer decrements it once per
+// destroyed command and the producer removes the bias minus the number of
+// commands it carved out when it retires the chunk. Whoever brings it to zero
+// frees it, so producers don't touch any shared counter per command.
+struct CommandQueueMT::LockFreeChunk {
+	static const uint32_t REFCOUNT_BIAS = 1 << 30;
+	static const uint32_t DEFAULT_SIZE = 16 * 1024;
+
+	SafeNumeric<uint32_t> refcount;
+	uint32_t size = 0;
+	uint32_t used = 0;
+	uint32_t allocations = 0;
+};
+
+// Releases the chunk the thread is currently allocating from when it exits.
+struct CommandQueueMT::LockFreeChunkOwner {
+	LockFreeChunk *chunk = nullptr;
+	~LockFreeChunkOwner() {
+		if (chunk) {
+			_retire_lock_free_chunk(chunk);
+		}
+	}
+};
+
+thread_local CommandQueueMT::LockFreeChunkOwner CommandQueueMT::lock_free_chunk_owner;
+
+void CommandQueueMT::_retire_lock_free_chunk(LockFreeChunk *p_chunk) {
+	if (p_chunk->refcount.sub(LockFreeChunk::REFCOUNT_BIAS - p_chunk->allocations) == 0) {
+		p_chunk->~LockFreeChunk();
+		memfree(p_chunk);
+	}
+}
+
+uint8_t *CommandQueueMT::_allocate_lock_free_mem(uint32_t p_size, LockFreeChunk *&r_chunk) {
+	const uint32_t header_size = ((sizeof(LockFreeChunk) + 8 - 1) & ~(8 - 1));
+	LockFreeChunk *chunk = lock_free_chunk_owner.chunk;
+	if (unlikely(!chunk || chunk->used + p_size > chunk->size)) {
+		if (chunk) {
+			_retire_lock_free_chunk(chunk);
+		}
+		uint32_t size = MAX(LockFreeChunk::DEFAULT_SIZE, p_size);
+		chunk = memnew_placement(memalloc(header_size + size), LockFreeChunk);
+		chunk->refcount.set(LockFreeChunk::REFCOUNT_BIAS);
+		chunk->size = size;
+		lock_free_chunk_owner.chunk = chunk;
+	}
+
+	uint8_t *mem = reinterpret_cast<uint8_t *>(chunk) + header_size + chunk->used;
+	chunk->used += p_size;
+	chunk->allocations++;
+	r_chunk = chunk;
+	return mem;
+}
+
+void CommandQueueMT::_release_lock_free_chunk(LockFreeChunk *p_chunk) {
+	if (p_chunk->refcount.decrement() == 0) {
+		p_chunk->~LockFreeChunk();
+		memfree(p_chunk);
+	}
+}
+
+void CommandQueueMT::_push_lock_free_and_wait(LockFreeNode *p_node) {
+	bool done = false;
+	p_node->sync_done = &done;
+	_push_lock_free(p_node);
+
+	MutexLock mlock(mutex);
+	while (!done) {
+		sync_cond_var.wait(mlock);
+	}
+}
+
+CommandQueueMT::LockFreeNode *CommandQueueMT::_pop_lock_free() {
+	// A producer that swapped the tail but didn't link its node yet is only a
+	// couple of instructions away from doing so, so wait for it instead of
+	// reporting the queue as empty. This guarantees a flush only finishes when
+	// the stub is the tail again, which producers rely on to wake the pump.
+	auto wait_for_next = [](LockFreeNode *p_node) {
+		LockFreeNode *next = p_node->next.load(std::memory_order_acquire);
+		for (uint32_t spins = 0; !next; spins++) {
+			if (spins >= 64) {
+				OS::get_singleton()->delay_usec(1);
+			}
+			next = p_node->next.load(std::memory_order_acquire);
+		}
+		return next;
+	};
+
+	LockFreeNode *head = lock_free_head;
+	LockFreeNode *next = head->next.load(std::memory_order_acquire);
+
+	if (head == &lock_free_stub) {
+		if (!next) {
+			if (lock_free_tail.load(std::memory_order_acquire) == head) {
+				return nullptr; // Empty.
+			}
+			next = wait_for_next(head);
+		}
+		lock_free_head = next;
+		head = next;
+		next = next->next.load(std::memory_order_acquire);
+	}
+
+	if (!next) {
+		if (lock_free_tail.load(std::memory_order_acquire) == head) {
+			// Last node, put the stub back behind it so it can be detached.
+			lock_free_stub.next.store(nullptr, std::memory_order_relaxed);
+			LockFreeNode *prev = lock_free_tail.exchange(&lock_free_stub, std::memory_order_acq_rel);
+			prev->next.store(&lock_free_stub, std::memory_order_release);
+		}
+		next = wait_for_next(head);
+	}
+
+	lock_free_head = next;
+	return head;
+}
+
+void CommandQueueMT::_flush_lock_free() {
+	if (unlikely(lock_free_flushing)) {
+		// Re-entrant call.
+		return;
+	}
+	lock_free_flushing = true;
+
+	while (LockFreeNode *node = _pop_lock_free()) {
+		CommandBase *cmd = reinterpret_cast<CommandBase *>(reinterpret_cast<uint8_t *>(node) + LOCK_FREE_NODE_SIZE);
+		cmd->call();
+		cmd->~CommandBase();
+
+		bool *sync_done = node->sync_done;
+		LockFreeChunk *chunk = node->chunk;
+		node->~LockFreeNode();
+		_release_lock_free_chunk(chunk);
+
+		if (unlikely(sync_done)) {
+			mutex.lock();
+			*sync_done = true;
+			mutex.unlock();
+			sync_cond_var.notify_all();
+		}
+	}
+
+	lock_free_flushing = false;
+}
+
+CommandQueueMT::CommandQueueMT(ProducerMode p_producer_mode) :
+		producer_mode(p_producer_mode) {
+	if (producer_mode == PRODUCER_MODE_LOCK_FREE) {
+		lock_free_tail.store(&lock_free_stub, std::memory_order_relaxed);
+		lock_free_head = &lock_free_stub;
+	} else {
+		command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
+	}
 }
 
 CommandQueueMT::~CommandQueueMT() {
+	if (producer_mode == PRODUCER_MODE_LOCK_FREE) {
+		// Commands never flushed still hold references to their chunks.
+		while (LockFreeNode *node = _pop_lock_free()) {
+			reinterpret_cast<CommandBase *>(reinterpret_cast<uint8_t *>(node) + LOCK_FREE_NODE_SIZE)->~CommandBase();
+			LockFreeChunk *chunk = node->chunk;
+			node->~LockFreeNode();
+			_release_lock_free_chunk(chunk);
+		}
+	}
 }
@@ -40,6 +40,9 @@
 #include "core/templates/simple_type.h"
 #include "core/typedefs.h"
 
+#include <atomic>
+#include <utility>
+
 #define COMMA(N) _COMMA_##N
 #define _COMMA_0
 #define _COMMA_1 ,
@@ -246,11 +249,21 @@
 
 #define TYPE_ARG(N) P##N
 #define CMD_TYPE(N) Command##N<T, M COMMA(N) COMMA_SEP_LIST(TYPE_ARG, N)>
-#define CMD_ASSIGN_PARAM(N) cmd->p##N = p##N
+// Parameters are taken by value, so they can be handed over to the command.
+#define CMD_ASSIGN_PARAM(N) cmd->p##N = std::move(p##N)
 
 #define DECL_PUSH(N)                                                            \
 	template <typename T, typename M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>    \
 	void push(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) {    \
+		if (producer_mode == PRODUCER_MODE_LOCK_FREE) {                         \
+			LockFreeNode *node = nullptr;                                       \
+			CMD_TYPE(N) *cmd = _allocate_lock_free<CMD_TYPE(N)>(node);          \
+			cmd->instance = p_instance;                                         \
+			cmd->method = p_method;                                             \
+			SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                \
+			_push_lock_free(node);                                              \
+			return;                                                             \
+		}                                                                       \
 		MutexLock mlock(mutex);                                                 \
 		CMD_TYPE(N) *cmd = allocate<CMD_TYPE(N)>();                             \
 		cmd->instance = p_instance;                                             \
@@ -266,6 +279,16 @@
 #define DECL_PUSH_AND_RET(N)                                                                   \
 	template <typename T, typename M, COMMA_SEP_LIST(TYPE_PARAM, N) COMMA(N) typename R>       \
 	void push_and_ret(T *p_instance, M p_method, COMMA_SEP_LIST(PARAM, N) COMMA(N) R *r_ret) { \
+		if (producer_mode == PRODUCER_MODE_LOCK_FREE) {                                        \
+			LockFreeNode *node = nullptr;                                                      \
+			CMD_RET_TYPE(N) *cmd = _allocate_lock_free<CMD_RET_TYPE(N)>(node);                 \
+			cmd->instance = p_instance;                                                        \
+			cmd->method = p_method;                                                            \
+			SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                               \
+			cmd->ret = r_ret;                                                                  \
+			_push_lock_free_and_wait(node);                                                    \
+			return;                                                                            \
+		}                                                                                      \
 		MutexLock mlock(mutex);                                                                \
 		CMD_RET_TYPE(N) *cmd = allocate<CMD_RET_TYPE(N)>();                                    \
 		cmd->instance = p_instance;                                                            \
@@ -284,6 +307,15 @@
 #define DECL_PUSH_AND_SYNC(N)                                                         \
 	template <typename T, typename M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>          \
 	void push_and_sync(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
+		if (producer_mode == PRODUCER_MODE_LOCK_FREE) {                               \
+			LockFreeNode *node = nullptr;                                             \
+			CMD_SYNC_TYPE(N) *cmd = _allocate_lock_free<CMD_SYNC_TYPE(N)>(node);      \
+			cmd->instance = p_instance;                                               \
+			cmd->method = p_method;                                                   \
+			SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                      \
+			_push_lock_free_and_wait(node);                                           \
+			return;                                                                   \
+		}                                                                             \
 		MutexLock mlock(mutex);                                                       \
 		CMD_SYNC_TYPE(N) *cmd = allocate<CMD_SYNC_TYPE(N)>();                         \
 		cmd->instance = p_instance;                                                   \
@@ -299,6 +331,17 @@
 #define MAX_CMD_PARAMS 15
 
 class CommandQueueMT {
+public:
+	enum ProducerMode {
+		// Producers serialize on a mutex and commands are stored contiguously.
+		PRODUCER_MODE_LOCKED,
+		// Producers publish commands to a lock-free multi-producer single-consumer
+		// list and never take the mutex unless they wait for a sync command.
+		// Only one thread may flush the queue at a time.
+		PRODUCER_MODE_LOCK_FREE,
+	};
+
+private:
 	struct CommandBase {
 		bool sync = false;
 		virtual void call() = 0;
@@ -333,7 +376,7 @@ class CommandQueueMT {
 	uint32_t sync_head = 0;
 	uint32_t sync_tail = 0;
 	uint32_t sync_awaiters = 0;
-	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	std::atomic<WorkerThreadPool::TaskID> pump_task_id = { WorkerThreadPool::INVALID_TASK_ID }; // Also read by lock-free producers.
 	uint64_t flush_read_ptr = 0;
 
 	template <typename T>
@@ -357,6 +400,11 @@ class CommandQueueMT {
 	}
 
 	void _flush() {
+		if (producer_mode == PRODUCER_MODE_LOCK_FREE) {
+			_flush_lock_free();
+			return;
+		}
+
 		if (unlikely(flush_read_ptr)) {
 			// Re-entrant call.
 			return;
@@ -403,6 +451,60 @@ class CommandQueueMT {
 		_prevent_sync_wraparound();
 	}
 
+	/***** LOCK-FREE *******/
+
+	// In PRODUCER_MODE_LOCK_FREE every command is prefixed by a node of an
+	// intrusive MPSC list (Vyukov). Producers carve commands out of a
+	// thread-local chunk, so the only shared write is the exchange on the tail.
+	struct LockFreeChunk;
+	struct LockFreeChunkOwner;
+	static thread_local LockFreeChunkOwner lock_free_chunk_owner;
+
+	struct LockFreeNode {
+		std::atomic<LockFreeNode *> next = nullptr;
+		LockFreeChunk *chunk = nullptr;
+		bool *sync_done = nullptr;
+	};
+
+	static const uint32_t LOCK_FREE_NODE_SIZE = ((sizeof(LockFreeNode) + 8 - 1) & ~(8 - 1));
+
+	ProducerMode producer_mode = PRODUCER_MODE_LOCKED;
+	std::atomic<LockFreeNode *> lock_free_tail;
+	LockFreeNode *lock_free_head = nullptr; // Only touched by the flushing thread.
+	LockFreeNode lock_free_stub;
+	bool lock_free_flushing = false;
+
+	static uint8_t *_allocate_lock_free_mem(uint32_t p_size, LockFreeChunk *&r_chunk);
+	static void _retire_lock_free_chunk(LockFreeChunk *p_chunk);
+	static void _release_lock_free_chunk(LockFreeChunk *p_chunk);
+
+	template <typename T>
+	T *_allocate_lock_free(LockFreeNode *&r_node) {
+		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1));
+		LockFreeChunk *chunk = nullptr;
+		uint8_t *mem = _allocate_lock_free_mem(LOCK_FREE_NODE_SIZE + alloc_size, chunk);
+		r_node = memnew_placement(mem, LockFreeNode);
+		r_node->chunk = chunk;
+		return memnew_placement(mem + LOCK_FREE_NODE_SIZE, T);
+	}
+
+	_FORCE_INLINE_ void _push_lock_free(LockFreeNode *p_node) {
+		LockFreeNode *prev = lock_free_tail.exchange(p_node, std::memory_order_acq_rel);
+		prev->next.store(p_node, std::memory_order_release);
+		// The stub is only the tail once the consumer has drained everything, so
+		// the pump only needs waking up by the first command after that.
+		if (prev == &lock_free_stub) {
+			WorkerThreadPool::TaskID task_id = pump_task_id.load(std::memory_order_acquire);
+			if (task_id != WorkerThreadPool::INVALID_TASK_ID) {
+				WorkerThreadPool::get_singleton()->notify_yield_over(task_id);
+			}
+		}
+	}
+
+	void _push_lock_free_and_wait(LockFreeNode *p_node);
+	LockFreeNode *_pop_lock_free();
+	void _flush_lock_free();
+
 	void _no_op() {}
 
 public:
@@ -422,6 +524,12 @@ public:
 	SPACE_SEP_LIST(DECL_PUSH_AND_SYNC, 15)
 
 	_FORCE_INLINE_ void flush_if_pending() {
+		if (producer_mode == PRODUCER_MODE_LOCK_FREE) {
+			if (unlikely(lock_free_head != &lock_free_stub || lock_free_tail.load(std::memory_order_acquire) != &lock_free_stub)) {
+				_flush_lock_free();
+			}
+			return;
+		}
 		if (unlikely(command_mem.size() > 0)) {
 			_flush();
 		}
@@ -443,11 +551,13 @@ public:
 
 	void set_pump_task_id(WorkerThreadPool::TaskID p_task_id) {
 		lock();
-		pump_task_id = p_task_id;
+		pump_task_id.store(p_task_id, std::memory_order_release);
 		unlock();
 	}
 
-	CommandQueueMT();
+	ProducerMode get_producer_mode() const { return producer_mode; }
+
+	CommandQueueMT(ProducerMode p_producer_mode = PRODUCER_MODE_LOCKED);
 	~CommandQueueMT();
 };
 
@@ -37,6 +37,7 @@
 
 #include <string.h>
 #include <type_traits>
+#include <utility>
 
 template <typename T>
 class Vector;
@@ -239,6 +240,20 @@ public:
 	_FORCE_INLINE_ CowData() {}
 	_FORCE_INLINE_ ~CowData();
 	_FORCE_INLINE_ CowData(CowData<T> &p_from) { _ref(p_from); };
+	_FORCE_INLINE_ CowData(CowData<T> &&p_from) {
+		_ptr = p_from._ptr;
+		p_from._ptr = nullptr;
+	}
+	void operator=(CowData<T> &&p_from) {
+		if (this == &p_from) {
+			return;
+		}
+		// Release the old buffer last, its elements may own the source.
+		CowData<T> previous;
+		previous._ptr = _ptr;
+		_ptr = p_from._ptr;
+		p_from._ptr = nullptr;
+	}
 };
 
 template <typename T>
@@ -249,6 +264,9 @@ void CowData<T>::_unref(void *p_data) {
 
 	SafeNumeric<USize> *refc = _get_refcount();
 
+#ifdef DEV_ENABLED
+	SafeRefCountStats::operations++;
+#endif
 	if (refc->decrement() > 0) {
 		return; // still in use
 	}
@@ -467,6 +485,9 @@ void CowData<T>::_ref(const CowData &p_from) {
 		return; //nothing to do
 	}
 
+#ifdef DEV_ENABLED
+	SafeRefCountStats::operations++;
+#endif
 	if (p_from._get_refcount()->conditional_increment() > 0) { // could reference
 		_ptr = p_from._ptr;
 	}
@@ -0,0 +1,98 @@
+/**************************************************************************/
+/*  hash_probe.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef HASH_PROBE_H
+#define HASH_PROBE_H
+
+#include "core/typedefs.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HASH_PROBE_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define HASH_PROBE_NEON
+#include <arm_neon.h>
+#endif
+
+/**
+ * Group matching for the open addressing tables (HashMap, HashSet).
+ *
+ * Both tables keep one 32-bit hash per slot. Instead of comparing one slot at a
+ * time, a probe loads HASH_PROBE_GROUP_SIZE consecutive hashes and compares them
+ * against both the searched hash and the empty marker at once, yielding one bit
+ * per slot. The caller only compares keys for slots whose full hash matched, so
+ * false positives are practically nonexistent.
+ *
+ * The group must not wrap around the end of the table; callers fall back to the
+ * scalar probe near the end, since table capacities are primes.
+ */
+
+static constexpr uint32_t HASH_PROBE_GROUP_SIZE = 4;
+
+// Returns the bitmask of slots holding `p_hash`, and stores the bitmask of
+// slots holding `p_empty_hash` in `r_empty_mask`.
+static _FORCE_INLINE_ uint32_t hash_probe_group_match(const uint32_t *p_hashes, const uint32_t p_hash, const uint32_t p_empty_hash, uint32_t &r_empty_mask) {
+#if defined(HASH_PROBE_SSE2)
+	const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_hashes));
+	r_empty_mask = (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(group, _mm_set1_epi32((int)p_empty_hash))));
+	return (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(group, _mm_set1_epi32((int)p_hash))));
+#elif defined(HASH_PROBE_NEON)
+	static const uint32_t lane_bits_array[4] = { 1, 2, 4, 8 };
+	const uint32x4_t lane_bits = vld1q_u32(lane_bits_array);
+	const uint32x4_t group = vld1q_u32(p_hashes);
+	r_empty_mask = vaddvq_u32(vandq_u32(vceqq_u32(group, vdupq_n_u32(p_empty_hash)), lane_bits));
+	return vaddvq_u32(vandq_u32(vceqq_u32(group, vdupq_n_u32(p_hash)), lane_bits));
+#else
+	uint32_t match_mask = 0;
+	r_empty_mask = 0;
+	for (uint32_t i = 0; i < HASH_PROBE_GROUP_SIZE; i++) {
+		match_mask |= uint32_t(p_hashes[i] == p_hash) << i;
+		r_empty_mask |= uint32_t(p_hashes[i] == p_empty_hash) << i;
+	}
+	return match_mask;
+#endif
+}
+
+// Index of the lowest set bit of a non-zero group mask.
+static _FORCE_INLINE_ uint32_t hash_probe_first_slot(const uint32_t p_mask) {
+	static constexpr uint8_t first_bit[16] = { 0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0 };
+	return first_bit[p_mask & 0xF];
+}
+
+// Clears the bits of `p_mask` at and after the first empty slot, since a probe
+// sequence never continues past an empty slot.
+static _FORCE_INLINE_ uint32_t hash_probe_mask_before_empty(const uint32_t p_mask, const uint32_t p_empty_mask) {
+	if (p_empty_mask == 0) {
+		return p_mask;
+	}
+	return p_mask & ((p_empty_mask & (0u - p_empty_mask)) - 1);
+}
+
+#endif // HASH_PROBE_H
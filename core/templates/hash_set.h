@@ -34,6 +34,7 @@
 #include "core/math/math_funcs.h"
 #include "core/os/memory.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/hash_probe.h"
 #include "core/templates/hashfuncs.h"
 #include "core/templates/paged_allocator.h"
 
@@ -91,6 +92,38 @@ private:
 		uint32_t distance = 0;
 
 		while (true) {
+			if (likely(pos + HASH_PROBE_GROUP_SIZE <= capacity)) {
+				// Match a whole group of slots at once. Keys are only compared
+				// for slots whose full hash matched.
+				uint32_t empty_mask;
+				uint32_t match_mask = hash_probe_group_match(&hashes[pos], hash, EMPTY_HASH, empty_mask);
+				match_mask = hash_probe_mask_before_empty(match_mask, empty_mask);
+
+				while (match_mask) {
+					const uint32_t slot = pos + hash_probe_first_slot(match_mask);
+					if (Comparator::compare(keys[hash_to_key[slot]], p_key)) {
+						r_pos = hash_to_key[slot];
+						return true;
+					}
+					match_mask &= match_mask - 1;
+				}
+
+				if (empty_mask) {
+					return false;
+				}
+
+				// Robin Hood early exit, checked once per group on its last slot.
+				pos += HASH_PROBE_GROUP_SIZE - 1;
+				distance += HASH_PROBE_GROUP_SIZE - 1;
+				if (distance > _get_probe_length(pos, hashes[pos], capacity, capacity_inv)) {
+					return false;
+				}
+
+				pos = fastmod(pos + 1, capacity_inv, capacity);
+				distance++;
+				continue;
+			}
+
 			if (hashes[pos] == EMPTY_HASH) {
 				return false;
 			}
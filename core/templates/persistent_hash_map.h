@@ -0,0 +1,353 @@
+/**************************************************************************/
+/*  persistent_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef PERSISTENT_HASH_MAP_H
+#define PERSISTENT_HASH_MAP_H
+
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// Hash map with structural sharing, stored as a hash array mapped trie (HAMT).
+// Each node consumes 5 bits of the hash and keeps its pairs and children in
+// dense arrays indexed through bitmaps. Copies are O(1) and share every node.
+// Modifying a copy only duplicates the nodes on the path to the changed pair,
+// so the other copies are never affected. Nodes only referenced by one map are
+// modified in place. Iteration order is unspecified. It follows the hashes, but
+// keys with identical hashes keep their insertion order, so equal maps can differ.
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class PersistentHashMap {
+public:
+	struct Pair {
+		TKey key;
+		TValue value;
+		uint32_t hash = 0;
+	};
+
+private:
+	static constexpr uint32_t BITS = 5;
+	static constexpr uint32_t MASK = (1 << BITS) - 1;
+	static constexpr uint32_t MAX_DEPTH = 8; // 32 hash bits, plus one level for full collisions.
+
+	struct Node {
+		SafeRefCount refcount;
+		uint32_t pair_map = 0;
+		uint32_t child_map = 0;
+		LocalVector<Pair> pairs; // Below MAX_DEPTH levels, all pairs share the same hash and the maps are unused.
+		LocalVector<Node *> children;
+
+		Node() { refcount.init(); }
+	};
+
+	Node *root = nullptr;
+	uint32_t count = 0;
+
+	static _FORCE_INLINE_ uint32_t _popcount(uint32_t p_value) {
+#if defined(__GNUC__)
+		return __builtin_popcount(p_value);
+#else
+		p_value = p_value - ((p_value >> 1) & 0x55555555);
+		p_value = (p_value & 0x33333333) + ((p_value >> 2) & 0x33333333);
+		return (((p_value + (p_value >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+#endif
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_index(uint32_t p_map, uint32_t p_bit) {
+		return _popcount(p_map & (p_bit - 1));
+	}
+
+	static _FORCE_INLINE_ bool _is_collision_level(uint32_t p_shift) {
+		return p_shift >= 32;
+	}
+
+	static void _unref(Node *p_node) {
+		if (!p_node->refcount.unref()) {
+			return;
+		}
+		for (Node *child : p_node->children) {
+			_unref(child);
+		}
+		memdelete(p_node);
+	}
+
+	// Returns a node only referenced by this map, copying `p_node` if shared.
+	// Takes over the reference the caller held.
+	static Node *_own(Node *p_node) {
+		if (p_node->refcount.get() == 1) {
+			return p_node;
+		}
+		Node *copy = memnew(Node);
+		copy->pair_map = p_node->pair_map;
+		copy->child_map = p_node->child_map;
+		copy->pairs = p_node->pairs;
+		copy->children = p_node->children;
+		for (Node *child : copy->children) {
+			child->refcount.ref();
+		}
+		_unref(p_node);
+		return copy;
+	}
+
+	const Pair *_lookup(const TKey &p_key, uint32_t p_hash) const {
+		const Node *node = root;
+		uint32_t shift = 0;
+		while (node) {
+			if (_is_collision_level(shift)) {
+				for (const Pair &pair : node->pairs) {
+					if (Comparator::compare(pair.key, p_key)) {
+						return &pair;
+					}
+				}
+				return nullptr;
+			}
+			uint32_t bit = 1u << ((p_hash >> shift) & MASK);
+			if (node->pair_map & bit) {
+				const Pair &pair = node->pairs[_get_index(node->pair_map, bit)];
+				return pair.hash == p_hash && Comparator::compare(pair.key, p_key) ? &pair : nullptr;
+			}
+			if (!(node->child_map & bit)) {
+				return nullptr;
+			}
+			node = node->children[_get_index(node->child_map, bit)];
+			shift += BITS;
+		}
+		return nullptr;
+	}
+
+	// Returns true if the key was not in the map.
+	static bool _insert(Node *&r_node, uint32_t p_shift, const Pair &p_pair) {
+		r_node = r_node ? _own(r_node) : memnew(Node);
+		Node *node = r_node;
+		if (_is_collision_level(p_shift)) {
+			for (Pair &pair : node->pairs) {
+				if (Comparator::compare(pair.key, p_pair.key)) {
+					pair.value = p_pair.value;
+					return false;
+				}
+			}
+			node->pairs.push_back(p_pair);
+			return true;
+		}
+
+		uint32_t bit = 1u << ((p_pair.hash >> p_shift) & MASK);
+		if (node->child_map & bit) {
+			return _insert(node->children[_get_index(node->child_map, bit)], p_shift + BITS, p_pair);
+		}
+		if (node->pair_map & bit) {
+			uint32_t index = _get_index(node->pair_map, bit);
+			Pair &pair = node->pairs[index];
+			if (pair.hash == p_pair.hash && Comparator::compare(pair.key, p_pair.key)) {
+				pair.value = p_pair.value;
+				return false;
+			}
+			// Two keys share this slot, move both to a new child.
+			Node *child = nullptr;
+			_insert(child, p_shift + BITS, pair);
+			_insert(child, p_shift + BITS, p_pair);
+			node->pairs.remove_at(index);
+			node->pair_map &= ~bit;
+			node->children.insert(_get_index(node->child_map, bit), child);
+			node->child_map |= bit;
+			return true;
+		}
+		node->pairs.insert(_get_index(node->pair_map, bit), p_pair);
+		node->pair_map |= bit;
+		return true;
+	}
+
+	// The key must be in the map. Sets `r_node` to null if it becomes empty.
+	static void _erase(Node *&r_node, uint32_t p_shift, const TKey &p_key, uint32_t p_hash) {
+		r_node = _own(r_node);
+		Node *node = r_node;
+		if (_is_collision_level(p_shift)) {
+			for (uint32_t i = 0; i < node->pairs.size(); i++) {
+				if (Comparator::compare(node->pairs[i].key, p_key)) {
+					node->pairs.remove_at(i);
+					break;
+				}
+			}
+		} else {
+			uint32_t bit = 1u << ((p_hash >> p_shift) & MASK);
+			if (node->pair_map & bit) {
+				node->pairs.remove_at(_get_index(node->pair_map, bit));
+				node->pair_map &= ~bit;
+			} else {
+				uint32_t index = _get_index(node->child_map, bit);
+				_erase(node->children[index], p_shift + BITS, p_key, p_hash);
+				Node *child = node->children[index];
+				// Pull up children left with a single pair, so the trie stays as shallow as possible.
+				if (child->children.is_empty() && child->pairs.size() == 1) {
+					Pair pair = child->pairs[0];
+					_unref(child);
+					node->children.remove_at(index);
+					node->child_map &= ~bit;
+					node->pairs.insert(_get_index(node->pair_map, bit), pair);
+					node->pair_map |= bit;
+				}
+			}
+		}
+		if (node->pairs.is_empty() && node->children.is_empty()) {
+			_unref(node);
+			r_node = nullptr;
+		}
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t size() const { return count; }
+	_FORCE_INLINE_ bool is_empty() const { return count == 0; }
+
+	const TValue *getptr(const TKey &p_key) const {
+		const Pair *pair = _lookup(p_key, Hasher::hash(p_key));
+		return pair ? &pair->value : nullptr;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		const TValue *value = getptr(p_key);
+		CRASH_COND_MSG(!value, "PersistentHashMap key not found.");
+		return *value;
+	}
+
+	bool has(const TKey &p_key) const {
+		return getptr(p_key) != nullptr;
+	}
+
+	void insert(const TKey &p_key, const TValue &p_value) {
+		Pair pair;
+		pair.key = p_key;
+		pair.value = p_value;
+		pair.hash = Hasher::hash(p_key);
+		if (_insert(root, 0, pair)) {
+			count++;
+		}
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t hash = Hasher::hash(p_key);
+		if (!_lookup(p_key, hash)) {
+			return false;
+		}
+		_erase(root, 0, p_key, hash);
+		count--;
+		return true;
+	}
+
+	void clear() {
+		if (root) {
+			_unref(root);
+			root = nullptr;
+		}
+		count = 0;
+	}
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const Pair &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ const Pair *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			_advance();
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &p_other) const { return pair == p_other.pair; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &p_other) const { return pair != p_other.pair; }
+
+		ConstIterator(const Node *p_root) {
+			if (p_root) {
+				stack[0] = { p_root, 0, 0 };
+				depth = 0;
+				_advance();
+			}
+		}
+
+	private:
+		struct Frame {
+			const Node *node = nullptr;
+			uint32_t pair = 0;
+			uint32_t child = 0;
+		};
+
+		Frame stack[MAX_DEPTH];
+		int depth = -1;
+		const Pair *pair = nullptr;
+
+		void _advance() {
+			while (depth >= 0) {
+				Frame &frame = stack[depth];
+				if (frame.pair < frame.node->pairs.size()) {
+					pair = &frame.node->pairs[frame.pair++];
+					return;
+				}
+				if (frame.child < frame.node->children.size()) {
+					stack[++depth] = { frame.node->children[frame.child++], 0, 0 };
+					continue;
+				}
+				depth--;
+			}
+			pair = nullptr;
+		}
+	};
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(root);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(nullptr);
+	}
+
+	void operator=(const PersistentHashMap &p_from) {
+		if (this == &p_from) {
+			return;
+		}
+		clear();
+		root = p_from.root;
+		count = p_from.count;
+		if (root) {
+			root->refcount.ref();
+		}
+	}
+
+	PersistentHashMap() {}
+	PersistentHashMap(const PersistentHashMap &p_from) {
+		root = p_from.root;
+		count = p_from.count;
+		if (root) {
+			root->refcount.ref();
+		}
+	}
+	~PersistentHashMap() { clear(); }
+};
+
+#endif // PERSISTENT_HASH_MAP_H
@@ -0,0 +1,334 @@
+/**************************************************************************/
+/*  persistent_vector.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef PERSISTENT_VECTOR_H
+#define PERSISTENT_VECTOR_H
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/templates/safe_refcount.h"
+
+// Vector with structural sharing, stored as a 32-way trie of fixed-size leaves
+// plus a separate tail leaf for fast appends. Copies are O(1) and share every
+// node. Modifying a copy only duplicates the nodes on the path to the changed
+// element (O(log32 n)), so the other copies are never affected. Nodes only
+// referenced by one vector are modified in place.
+template <typename T>
+class PersistentVector {
+	static constexpr uint32_t BITS = 5;
+	static constexpr uint32_t WIDTH = 1 << BITS;
+	static constexpr uint32_t MASK = WIDTH - 1;
+
+	struct Node {
+		SafeRefCount refcount;
+
+		Node() { refcount.init(); }
+	};
+
+	struct Branch : public Node {
+		Node *children[WIDTH] = {};
+	};
+
+	struct Leaf : public Node {
+		T values[WIDTH];
+	};
+
+	uint32_t count = 0;
+	uint32_t shift = BITS; // Shift of the root, whose children are leaves if equal to BITS.
+	Branch *root = nullptr;
+	Leaf *tail = nullptr;
+
+	_FORCE_INLINE_ uint32_t _get_tail_offset() const {
+		return count < WIDTH ? 0 : ((count - 1) >> BITS) << BITS;
+	}
+
+	static void _unref(Node *p_node, uint32_t p_shift) {
+		if (!p_node->refcount.unref()) {
+			return;
+		}
+		if (p_shift == 0) {
+			memdelete(static_cast<Leaf *>(p_node));
+			return;
+		}
+		Branch *branch = static_cast<Branch *>(p_node);
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			if (branch->children[i]) {
+				_unref(branch->children[i], p_shift - BITS);
+			}
+		}
+		memdelete(branch);
+	}
+
+	// Return a node only referenced by this vector, copying `p_node` if shared.
+	// They take over the reference the caller held.
+	static Branch *_own_branch(Branch *p_branch, uint32_t p_shift) {
+		if (p_branch->refcount.get() == 1) {
+			return p_branch;
+		}
+		Branch *copy = memnew(Branch);
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			if (p_branch->children[i]) {
+				p_branch->children[i]->refcount.ref();
+				copy->children[i] = p_branch->children[i];
+			}
+		}
+		_unref(p_branch, p_shift);
+		return copy;
+	}
+
+	static Leaf *_own_leaf(Leaf *p_leaf) {
+		if (p_leaf->refcount.get() == 1) {
+			return p_leaf;
+		}
+		Leaf *copy = memnew(Leaf);
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			copy->values[i] = p_leaf->values[i];
+		}
+		_unref(p_leaf, 0);
+		return copy;
+	}
+
+	Leaf *_get_leaf(uint32_t p_index) const {
+		if (p_index >= _get_tail_offset()) {
+			return tail;
+		}
+		Node *node = root;
+		for (uint32_t level = shift; level > 0; level -= BITS) {
+			node = static_cast<Branch *>(node)->children[(p_index >> level) & MASK];
+		}
+		return static_cast<Leaf *>(node);
+	}
+
+	// Makes the path to `p_index`, which must be in the trie, unique and returns its leaf.
+	Leaf *_own_path(uint32_t p_index) {
+		root = _own_branch(root, shift);
+		Branch *branch = root;
+		for (uint32_t level = shift; level > BITS; level -= BITS) {
+			Node *&child = branch->children[(p_index >> level) & MASK];
+			child = _own_branch(static_cast<Branch *>(child), level - BITS);
+			branch = static_cast<Branch *>(child);
+		}
+		Node *&leaf = branch->children[(p_index >> BITS) & MASK];
+		leaf = _own_leaf(static_cast<Leaf *>(leaf));
+		return static_cast<Leaf *>(leaf);
+	}
+
+	// Adds the full tail below `p_branch`, which must be owned.
+	void _push_tail(Branch *p_branch, uint32_t p_shift, Leaf *p_leaf) {
+		uint32_t index = ((count - 1) >> p_shift) & MASK;
+		if (p_shift == BITS) {
+			p_branch->children[index] = p_leaf;
+			return;
+		}
+		Node *&child = p_branch->children[index];
+		child = child ? _own_branch(static_cast<Branch *>(child), p_shift - BITS) : memnew(Branch);
+		_push_tail(static_cast<Branch *>(child), p_shift - BITS, p_leaf);
+	}
+
+	// Removes the last leaf below `p_branch`, taking over the caller's reference.
+	// Returns the replacement of `p_branch`, or null if nothing is left below it.
+	Branch *_pop_tail(Branch *p_branch, uint32_t p_shift) {
+		uint32_t index = ((count - 2) >> p_shift) & MASK;
+		if (index == 0 && p_shift == BITS) {
+			_unref(p_branch, p_shift);
+			return nullptr;
+		}
+		p_branch = _own_branch(p_branch, p_shift);
+		Node *&child = p_branch->children[index];
+		if (p_shift > BITS) {
+			child = _pop_tail(static_cast<Branch *>(child), p_shift - BITS);
+		} else {
+			_unref(child, 0);
+			child = nullptr;
+		}
+		if (!child && index == 0) {
+			_unref(p_branch, p_shift);
+			return nullptr;
+		}
+		return p_branch;
+	}
+
+	void _ref(const PersistentVector &p_from) {
+		count = p_from.count;
+		shift = p_from.shift;
+		root = p_from.root;
+		tail = p_from.tail;
+		if (root) {
+			root->refcount.ref();
+		}
+		if (tail) {
+			tail->refcount.ref();
+		}
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t size() const { return count; }
+	_FORCE_INLINE_ bool is_empty() const { return count == 0; }
+
+	const T &operator[](uint32_t p_index) const {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, count);
+		return _get_leaf(p_index)->values[p_index & MASK];
+	}
+
+	const T &get(uint32_t p_index) const {
+		return operator[](p_index);
+	}
+
+	void set(uint32_t p_index, const T &p_value) {
+		ERR_FAIL_UNSIGNED_INDEX(p_index, count);
+		Leaf *leaf;
+		if (p_index >= _get_tail_offset()) {
+			tail = _own_leaf(tail);
+			leaf = tail;
+		} else {
+			leaf = _own_path(p_index);
+		}
+		leaf->values[p_index & MASK] = p_value;
+	}
+
+	void push_back(const T &p_value) {
+		if (!tail) {
+			tail = memnew(Leaf);
+		} else if (count - _get_tail_offset() < WIDTH) {
+			tail = _own_leaf(tail);
+		} else {
+			// The tail is full, move it to the trie.
+			if (!root) {
+				root = memnew(Branch);
+			} else if ((count >> BITS) > (1u << shift)) {
+				Branch *new_root = memnew(Branch);
+				new_root->children[0] = root;
+				root = new_root;
+				shift += BITS;
+			} else {
+				root = _own_branch(root, shift);
+			}
+			_push_tail(root, shift, tail);
+			tail = memnew(Leaf);
+		}
+		tail->values[count & MASK] = p_value;
+		count++;
+	}
+
+	void pop_back() {
+		ERR_FAIL_COND(count == 0);
+		if (count == 1) {
+			clear();
+			return;
+		}
+		uint32_t tail_size = count - _get_tail_offset();
+		if (tail_size > 1) {
+			tail = _own_leaf(tail);
+			tail->values[tail_size - 1] = T();
+			count--;
+			return;
+		}
+		// The last leaf of the trie becomes the tail.
+		Leaf *new_tail = _get_leaf(count - 2);
+		new_tail->refcount.ref();
+		_unref(tail, 0);
+		tail = new_tail;
+		root = _pop_tail(root, shift);
+		if (root && shift > BITS && !root->children[1]) {
+			Branch *child = static_cast<Branch *>(root->children[0]);
+			child->refcount.ref();
+			_unref(root, shift);
+			root = child;
+			shift -= BITS;
+		}
+		count--;
+	}
+
+	void clear() {
+		if (root) {
+			_unref(root, shift);
+			root = nullptr;
+		}
+		if (tail) {
+			_unref(tail, 0);
+			tail = nullptr;
+		}
+		count = 0;
+		shift = BITS;
+	}
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const T &operator*() const {
+			return values[index & MASK];
+		}
+		_FORCE_INLINE_ const T *operator->() const {
+			return &values[index & MASK];
+		}
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			index++;
+			if ((index & MASK) == 0 && index < vector->count) {
+				values = vector->_get_leaf(index)->values;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &p_other) const { return index == p_other.index; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &p_other) const { return index != p_other.index; }
+
+		ConstIterator(const PersistentVector *p_vector, uint32_t p_index) :
+				vector(p_vector),
+				index(p_index) {
+			if (index < vector->count) {
+				values = vector->_get_leaf(index)->values;
+			}
+		}
+
+	private:
+		const PersistentVector *vector = nullptr;
+		const T *values = nullptr;
+		uint32_t index = 0;
+	};
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(this, 0);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(this, count);
+	}
+
+	void operator=(const PersistentVector &p_from) {
+		if (this == &p_from) {
+			return;
+		}
+		clear();
+		_ref(p_from);
+	}
+
+	PersistentVector() {}
+	PersistentVector(const PersistentVector &p_from) { _ref(p_from); }
+	~PersistentVector() { clear(); }
+};
+
+#endif // PERSISTENT_VECTOR_H
@@ -178,6 +178,15 @@ public:
 	}
 };
 
+#ifdef DEV_ENABLED
+// Number of reference count changes made by the calling thread through
+// SafeRefCount and CowData, so tests can measure how many atomic operations
+// a code path performs.
+struct SafeRefCountStats {
+	static inline thread_local uint64_t operations = 0;
+};
+#endif
+
 class SafeRefCount {
 	SafeNumeric<uint32_t> count;
 
@@ -193,15 +202,22 @@ class SafeRefCount {
 
 public:
 	_ALWAYS_INLINE_ bool ref() { // true on success
+#ifdef DEV_ENABLED
+		SafeRefCountStats::operations++;
+#endif
 		return count.conditional_increment() != 0;
 	}
 
 	_ALWAYS_INLINE_ uint32_t refval() { // none-zero on success
+#ifdef DEV_ENABLED
+		SafeRefCountStats::operations++;
+#endif
 		return count.conditional_increment();
 	}
 
 	_ALWAYS_INLINE_ bool unref() { // true if must be disposed of
 #ifdef DEV_ENABLED
+		SafeRefCountStats::operations++;
 		_check_unref_safety();
 #endif
 		return count.decrement() == 0;
@@ -209,6 +225,7 @@ public:
 
 	_ALWAYS_INLINE_ uint32_t unrefval() { // 0 if must be disposed of
 #ifdef DEV_ENABLED
+		SafeRefCountStats::operations++;
 		_check_unref_safety();
 #endif
 		return count.decrement();
@@ -0,0 +1,329 @@
+/**************************************************************************/
+/*  small_vector.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/sort_array.h"
+#include "core/templates/vector.h"
+
+#include <initializer_list>
+#include <type_traits>
+
+// A LocalVector that keeps up to N elements inline, only allocating once it grows past that.
+// Meant for the many short lists (contacts, pairs, children...) that are almost always tiny.
+// Like LocalVector, elements are relocated bitwise when the storage moves.
+template <typename T, uint32_t N, typename U = uint32_t, bool force_trivial = false, typename A = DefaultAllocator>
+class SmallVector {
+	static_assert(N > 0, "Use LocalVector if no inline storage is wanted.");
+
+private:
+	U count = 0;
+	U capacity = N;
+	T *heap_data = nullptr; // Null while the inline storage is in use.
+	alignas(T) uint8_t inline_data[sizeof(T) * N];
+
+	_FORCE_INLINE_ T *_get_data() { return heap_data ? heap_data : reinterpret_cast<T *>(inline_data); }
+	_FORCE_INLINE_ const T *_get_data() const { return heap_data ? heap_data : reinterpret_cast<const T *>(inline_data); }
+
+	void _grow(U p_capacity) {
+		if (p_capacity <= capacity) {
+			return;
+		}
+		if (heap_data) {
+			heap_data = (T *)A::realloc(heap_data, p_capacity * sizeof(T));
+			CRASH_COND_MSG(!heap_data, "Out of memory");
+		} else {
+			heap_data = (T *)A::alloc(p_capacity * sizeof(T));
+			CRASH_COND_MSG(!heap_data, "Out of memory");
+			memcpy((void *)heap_data, inline_data, count * sizeof(T));
+		}
+		capacity = p_capacity;
+	}
+
+public:
+	typedef typename LocalVector<T, U>::Iterator Iterator;
+	typedef typename LocalVector<T, U>::ConstIterator ConstIterator;
+
+	T *ptr() {
+		return _get_data();
+	}
+
+	const T *ptr() const {
+		return _get_data();
+	}
+
+	_FORCE_INLINE_ bool is_inline() const { return heap_data == nullptr; }
+
+	_FORCE_INLINE_ void push_back(T p_elem) {
+		if (unlikely(count == capacity)) {
+			_grow(capacity << 1);
+		}
+
+		T *data = _get_data();
+		if constexpr (!std::is_trivially_constructible_v<T> && !force_trivial) {
+			memnew_placement(&data[count++], T(p_elem));
+		} else {
+			data[count++] = p_elem;
+		}
+	}
+
+	void remove_at(U p_index) {
+		ERR_FAIL_UNSIGNED_INDEX(p_index, count);
+		T *data = _get_data();
+		count--;
+		for (U i = p_index; i < count; i++) {
+			data[i] = data[i + 1];
+		}
+		if constexpr (!std::is_trivially_destructible_v<T> && !force_trivial) {
+			data[count].~T();
+		}
+	}
+
+	/// Removes the item copying the last value into the position of the one to
+	/// remove. It's generally faster than `remove_at`.
+	void remove_at_unordered(U p_index) {
+		ERR_FAIL_INDEX(p_index, count);
+		T *data = _get_data();
+		count--;
+		if (count > p_index) {
+			data[p_index] = data[count];
+		}
+		if constexpr (!std::is_trivially_destructible_v<T> && !force_trivial) {
+			data[count].~T();
+		}
+	}
+
+	_FORCE_INLINE_ bool erase(const T &p_val) {
+		int64_t idx = find(p_val);
+		if (idx >= 0) {
+			remove_at(idx);
+			return true;
+		}
+		return false;
+	}
+
+	U erase_multiple_unordered(const T &p_val) {
+		U from = 0;
+		U occurrences = 0;
+		while (true) {
+			int64_t idx = find(p_val, from);
+
+			if (idx == -1) {
+				break;
+			}
+			remove_at_unordered(idx);
+			from = idx;
+			occurrences++;
+		}
+		return occurrences;
+	}
+
+	void invert() {
+		T *data = _get_data();
+		for (U i = 0; i < count / 2; i++) {
+			SWAP(data[i], data[count - i - 1]);
+		}
+	}
+
+	_FORCE_INLINE_ void clear() { resize(0); }
+	// Also gives back the heap storage, if any.
+	_FORCE_INLINE_ void reset() {
+		clear();
+		if (heap_data) {
+			A::free(heap_data);
+			heap_data = nullptr;
+			capacity = N;
+		}
+	}
+	_FORCE_INLINE_ bool is_empty() const { return count == 0; }
+	_FORCE_INLINE_ U get_capacity() const { return capacity; }
+	_FORCE_INLINE_ void reserve(U p_size) {
+		if (p_size > capacity) {
+			_grow(nearest_power_of_2_templated(p_size));
+		}
+	}
+
+	_FORCE_INLINE_ U size() const { return count; }
+	void resize(U p_size) {
+		if (p_size < count) {
+			if constexpr (!std::is_trivially_destructible_v<T> && !force_trivial) {
+				T *data = _get_data();
+				for (U i = p_size; i < count; i++) {
+					data[i].~T();
+				}
+			}
+			count = p_size;
+		} else if (p_size > count) {
+			if (unlikely(p_size > capacity)) {
+				_grow(nearest_power_of_2_templated(p_size));
+			}
+			if constexpr (!std::is_trivially_constructible_v<T> && !force_trivial) {
+				T *data = _get_data();
+				for (U i = count; i < p_size; i++) {
+					memnew_placement(&data[i], T);
+				}
+			}
+			count = p_size;
+		}
+	}
+	_FORCE_INLINE_ const T &operator[](U p_index) const {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, count);
+		return _get_data()[p_index];
+	}
+	_FORCE_INLINE_ T &operator[](U p_index) {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, count);
+		return _get_data()[p_index];
+	}
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(_get_data());
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(_get_data() + size());
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(ptr());
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(ptr() + size());
+	}
+
+	void insert(U p_pos, T p_val) {
+		ERR_FAIL_UNSIGNED_INDEX(p_pos, count + 1);
+		if (p_pos == count) {
+			push_back(p_val);
+		} else {
+			resize(count + 1);
+			T *data = _get_data();
+			for (U i = count - 1; i > p_pos; i--) {
+				data[i] = data[i - 1];
+			}
+			data[p_pos] = p_val;
+		}
+	}
+
+	int64_t find(const T &p_val, U p_from = 0) const {
+		const T *data = _get_data();
+		for (U i = p_from; i < count; i++) {
+			if (data[i] == p_val) {
+				return int64_t(i);
+			}
+		}
+		return -1;
+	}
+
+	bool has(const T &p_val) const {
+		return find(p_val) != -1;
+	}
+
+	template <typename C>
+	void sort_custom() {
+		U len = count;
+		if (len == 0) {
+			return;
+		}
+
+		SortArray<T, C> sorter;
+		sorter.sort(_get_data(), len);
+	}
+
+	void sort() {
+		sort_custom<_DefaultComparator<T>>();
+	}
+
+	void ordered_insert(T p_val) {
+		const T *data = _get_data();
+		U i;
+		for (i = 0; i < count; i++) {
+			if (p_val < data[i]) {
+				break;
+			}
+		}
+		insert(i, p_val);
+	}
+
+	operator Vector<T>() const {
+		Vector<T> ret;
+		ret.resize(size());
+		T *w = ret.ptrw();
+		memcpy(w, _get_data(), sizeof(T) * count);
+		return ret;
+	}
+
+	Vector<uint8_t> to_byte_array() const { //useful to pass stuff to gpu or variant
+		Vector<uint8_t> ret;
+		ret.resize(count * sizeof(T));
+		uint8_t *w = ret.ptrw();
+		memcpy(w, _get_data(), sizeof(T) * count);
+		return ret;
+	}
+
+	_FORCE_INLINE_ SmallVector() {}
+	_FORCE_INLINE_ SmallVector(std::initializer_list<T> p_init) {
+		reserve(p_init.size());
+		for (const T &element : p_init) {
+			push_back(element);
+		}
+	}
+	_FORCE_INLINE_ SmallVector(const SmallVector &p_from) {
+		resize(p_from.size());
+		T *data = _get_data();
+		const T *from_data = p_from._get_data();
+		for (U i = 0; i < p_from.count; i++) {
+			data[i] = from_data[i];
+		}
+	}
+	inline void operator=(const SmallVector &p_from) {
+		resize(p_from.size());
+		T *data = _get_data();
+		const T *from_data = p_from._get_data();
+		for (U i = 0; i < p_from.count; i++) {
+			data[i] = from_data[i];
+		}
+	}
+	inline void operator=(const Vector<T> &p_from) {
+		resize(p_from.size());
+		T *data = _get_data();
+		for (U i = 0; i < count; i++) {
+			data[i] = p_from[i];
+		}
+	}
+
+	_FORCE_INLINE_ ~SmallVector() {
+		reset();
+	}
+};
+
+#endif // SMALL_VECTOR_H
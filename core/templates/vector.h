@@ -44,6 +44,7 @@
 
 #include <climits>
 #include <initializer_list>
+#include <utility>
 
 template <typename T>
 class VectorWriteProxy {
@@ -144,6 +145,7 @@ public:
 		insert(i, p_val);
 	}
 
+	_FORCE_INLINE_ void operator=(Vector &&p_from) { _cowdata = std::move(p_from._cowdata); }
 	inline void operator=(const Vector &p_from) {
 		_cowdata._ref(p_from._cowdata);
 	}
@@ -287,6 +289,8 @@ public:
 		}
 	}
 	_FORCE_INLINE_ Vector(const Vector &p_from) { _cowdata._ref(p_from._cowdata); }
+	_FORCE_INLINE_ Vector(Vector &&p_from) :
+			_cowdata(std::move(p_from._cowdata)) {}
 
 	_FORCE_INLINE_ ~Vector() {}
 };
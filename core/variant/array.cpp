@@ -214,6 +214,14 @@ void Array::operator=(const Array &p_array) {
 	_ref(p_array);
 }
 
+void Array::operator=(Array &&p_array) {
+	if (this == &p_array) {
+		return;
+	}
+	// The source releases our previous storage when it goes away.
+	SWAP(_p, p_array._p);
+}
+
 void Array::assign(const Array &p_array) {
 	const ContainerTypeValidate &typed = _p->typed;
 	const ContainerTypeValidate &source_typed = p_array._p->typed;
@@ -830,6 +838,12 @@ Array::Array(const Array &p_from) {
 	_ref(p_from);
 }
 
+Array::Array(Array &&p_from) {
+	_p = p_from._p;
+	p_from._p = memnew(ArrayPrivate);
+	p_from._p->refcount.init();
+}
+
 Array::Array() {
 	_p = memnew(ArrayPrivate);
 	_p->refcount.init();
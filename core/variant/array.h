@@ -129,6 +129,8 @@ public:
 	uint32_t hash() const;
 	uint32_t recursive_hash(int recursion_count) const;
 	void operator=(const Array &p_array);
+	// Swaps storage, the moved-from array is left with the previous contents.
+	void operator=(Array &&p_array);
 
 	void assign(const Array &p_array);
 	void push_back(const Variant &p_value);
@@ -195,6 +197,8 @@ public:
 
 	Array(const Array &p_base, uint32_t p_type, const StringName &p_class_name, const Variant &p_script);
 	Array(const Array &p_from);
+	// The moved-from array is left empty.
+	Array(Array &&p_from);
 	Array();
 	~Array();
 };
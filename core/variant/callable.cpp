@@ -342,6 +342,17 @@ void Callable::operator=(const Callable &p_callable) {
 	}
 }
 
+void Callable::operator=(Callable &&p_callable) {
+	if (this == &p_callable) {
+		return;
+	}
+	// Release the old target last, it may own the source.
+	Callable previous(std::move(*this));
+	method = std::move(p_callable.method);
+	object = p_callable.object;
+	p_callable.object = 0;
+}
+
 Callable::operator String() const {
 	if (is_custom()) {
 		return custom->get_as_text();
@@ -425,6 +436,13 @@ Callable::Callable(const Callable &p_callable) {
 	}
 }
 
+Callable::Callable(Callable &&p_callable) :
+		method(std::move(p_callable.method)) {
+	// The union carries either the object ID or the custom callable.
+	object = p_callable.object;
+	p_callable.object = 0;
+}
+
 Callable::~Callable() {
 	if (is_custom()) {
 		if (custom->ref_count.unref()) {
@@ -123,6 +123,7 @@ public:
 	bool operator<(const Callable &p_callable) const;
 
 	void operator=(const Callable &p_callable);
+	void operator=(Callable &&p_callable);
 
 	operator String() const;
 
@@ -132,6 +133,7 @@ public:
 	Callable(ObjectID p_object, const StringName &p_method);
 	Callable(CallableCustom *p_custom);
 	Callable(const Callable &p_callable);
+	Callable(Callable &&p_callable);
 	Callable() {}
 	~Callable();
 };
@@ -394,6 +394,14 @@ void Dictionary::operator=(const Dictionary &p_dictionary) {
 	_ref(p_dictionary);
 }
 
+void Dictionary::operator=(Dictionary &&p_dictionary) {
+	if (this == &p_dictionary) {
+		return;
+	}
+	// The source releases our previous storage when it goes away.
+	SWAP(_p, p_dictionary._p);
+}
+
 const void *Dictionary::id() const {
 	return _p;
 }
@@ -403,6 +411,12 @@ Dictionary::Dictionary(const Dictionary &p_from) {
 	_ref(p_from);
 }
 
+Dictionary::Dictionary(Dictionary &&p_from) {
+	_p = p_from._p;
+	p_from._p = memnew(DictionaryPrivate);
+	p_from._p->refcount.init();
+}
+
 Dictionary::Dictionary() {
 	_p = memnew(DictionaryPrivate);
 	_p->refcount.init();
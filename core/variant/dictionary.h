@@ -79,6 +79,8 @@ public:
 	uint32_t hash() const;
 	uint32_t recursive_hash(int recursion_count) const;
 	void operator=(const Dictionary &p_dictionary);
+	// Swaps storage, the moved-from dictionary is left with the previous contents.
+	void operator=(Dictionary &&p_dictionary);
 
 	const Variant *next(const Variant *p_key = nullptr) const;
 
@@ -94,6 +96,8 @@ public:
 	const void *id() const;
 
 	Dictionary(const Dictionary &p_from);
+	// The moved-from dictionary is left empty.
+	Dictionary(Dictionary &&p_from);
 	Dictionary();
 	~Dictionary();
 };
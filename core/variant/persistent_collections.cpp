@@ -0,0 +1,201 @@
+/**************************************************************************/
+/*  persistent_collections.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "persistent_collections.h"
+
+Ref<PersistentArray> PersistentArray::from_array(const Array &p_array) {
+	Ref<PersistentArray> array;
+	array.instantiate();
+	for (int i = 0; i < p_array.size(); i++) {
+		array->data.push_back(p_array[i]);
+	}
+	return array;
+}
+
+Ref<PersistentArray> PersistentArray::from_data(const Data &p_data) {
+	Ref<PersistentArray> array;
+	array.instantiate();
+	array->data = p_data;
+	return array;
+}
+
+int PersistentArray::size() const {
+	return data.size();
+}
+
+bool PersistentArray::is_empty() const {
+	return data.is_empty();
+}
+
+Variant PersistentArray::get_at(int p_index) const {
+	if (p_index < 0) {
+		p_index += data.size();
+	}
+	ERR_FAIL_INDEX_V(p_index, (int)data.size(), Variant());
+	return data[p_index];
+}
+
+Ref<PersistentArray> PersistentArray::set_at(int p_index, const Variant &p_value) const {
+	if (p_index < 0) {
+		p_index += data.size();
+	}
+	ERR_FAIL_INDEX_V(p_index, (int)data.size(), Ref<PersistentArray>());
+	Data result = data;
+	result.set(p_index, p_value);
+	return from_data(result);
+}
+
+Ref<PersistentArray> PersistentArray::push_back(const Variant &p_value) const {
+	Data result = data;
+	result.push_back(p_value);
+	return from_data(result);
+}
+
+Ref<PersistentArray> PersistentArray::pop_back() const {
+	ERR_FAIL_COND_V_MSG(data.is_empty(), Ref<PersistentArray>(), "Can't pop from an empty PersistentArray.");
+	Data result = data;
+	result.pop_back();
+	return from_data(result);
+}
+
+Array PersistentArray::to_array() const {
+	Array array;
+	array.resize(data.size());
+	int i = 0;
+	for (const Variant &value : data) {
+		array[i++] = value;
+	}
+	return array;
+}
+
+void PersistentArray::_bind_methods() {
+	ClassDB::bind_static_method("PersistentArray", D_METHOD("from_array", "array"), &PersistentArray::from_array);
+
+	ClassDB::bind_method(D_METHOD("size"), &PersistentArray::size);
+	ClassDB::bind_method(D_METHOD("is_empty"), &PersistentArray::is_empty);
+	ClassDB::bind_method(D_METHOD("get_at", "index"), &PersistentArray::get_at);
+
+	ClassDB::bind_method(D_METHOD("set_at", "index", "value"), &PersistentArray::set_at);
+	ClassDB::bind_method(D_METHOD("push_back", "value"), &PersistentArray::push_back);
+	ClassDB::bind_method(D_METHOD("pop_back"), &PersistentArray::pop_back);
+
+	ClassDB::bind_method(D_METHOD("to_array"), &PersistentArray::to_array);
+}
+
+Ref<PersistentDictionary> PersistentDictionary::from_dictionary(const Dictionary &p_dictionary) {
+	Ref<PersistentDictionary> dictionary;
+	dictionary.instantiate();
+	List<Variant> keys;
+	p_dictionary.get_key_list(&keys);
+	for (const Variant &key : keys) {
+		dictionary->data.insert(key, p_dictionary[key]);
+	}
+	return dictionary;
+}
+
+Ref<PersistentDictionary> PersistentDictionary::from_data(const Data &p_data) {
+	Ref<PersistentDictionary> dictionary;
+	dictionary.instantiate();
+	dictionary->data = p_data;
+	return dictionary;
+}
+
+int PersistentDictionary::size() const {
+	return data.size();
+}
+
+bool PersistentDictionary::is_empty() const {
+	return data.is_empty();
+}
+
+bool PersistentDictionary::has(const Variant &p_key) const {
+	return data.has(p_key);
+}
+
+Variant PersistentDictionary::get_value(const Variant &p_key, const Variant &p_default) const {
+	const Variant *value = data.getptr(p_key);
+	return value ? *value : p_default;
+}
+
+Ref<PersistentDictionary> PersistentDictionary::set_value(const Variant &p_key, const Variant &p_value) const {
+	Data result = data;
+	result.insert(p_key, p_value);
+	return from_data(result);
+}
+
+Ref<PersistentDictionary> PersistentDictionary::erase(const Variant &p_key) const {
+	Data result = data;
+	result.erase(p_key);
+	return from_data(result);
+}
+
+Array PersistentDictionary::keys() const {
+	Array keys;
+	keys.resize(data.size());
+	int i = 0;
+	for (const Data::Pair &pair : data) {
+		keys[i++] = pair.key;
+	}
+	return keys;
+}
+
+Array PersistentDictionary::values() const {
+	Array values;
+	values.resize(data.size());
+	int i = 0;
+	for (const Data::Pair &pair : data) {
+		values[i++] = pair.value;
+	}
+	return values;
+}
+
+Dictionary PersistentDictionary::to_dictionary() const {
+	Dictionary dictionary;
+	for (const Data::Pair &pair : data) {
+		dictionary[pair.key] = pair.value;
+	}
+	return dictionary;
+}
+
+void PersistentDictionary::_bind_methods() {
+	ClassDB::bind_static_method("PersistentDictionary", D_METHOD("from_dictionary", "dictionary"), &PersistentDictionary::from_dictionary);
+
+	ClassDB::bind_method(D_METHOD("size"), &PersistentDictionary::size);
+	ClassDB::bind_method(D_METHOD("is_empty"), &PersistentDictionary::is_empty);
+	ClassDB::bind_method(D_METHOD("has", "key"), &PersistentDictionary::has);
+	ClassDB::bind_method(D_METHOD("get_value", "key", "default"), &PersistentDictionary::get_value, DEFVAL(Variant()));
+
+	ClassDB::bind_method(D_METHOD("set_value", "key", "value"), &PersistentDictionary::set_value);
+	ClassDB::bind_method(D_METHOD("erase", "key"), &PersistentDictionary::erase);
+
+	ClassDB::bind_method(D_METHOD("keys"), &PersistentDictionary::keys);
+	ClassDB::bind_method(D_METHOD("values"), &PersistentDictionary::values);
+	ClassDB::bind_method(D_METHOD("to_dictionary"), &PersistentDictionary::to_dictionary);
+}
@@ -0,0 +1,100 @@
+/**************************************************************************/
+/*  persistent_collections.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef PERSISTENT_COLLECTIONS_H
+#define PERSISTENT_COLLECTIONS_H
+
+#include "core/object/ref_counted.h"
+#include "core/templates/persistent_hash_map.h"
+#include "core/templates/persistent_vector.h"
+#include "core/variant/array.h"
+#include "core/variant/dictionary.h"
+
+// Immutable collections exposed to scripts. Every modification returns a new
+// collection sharing most of its storage with the original one, which makes
+// keeping many snapshots (undo history, rollback) cheap.
+
+class PersistentArray : public RefCounted {
+	GDCLASS(PersistentArray, RefCounted);
+
+	PersistentVector<Variant> data;
+
+protected:
+	static void _bind_methods();
+
+public:
+	typedef PersistentVector<Variant> Data;
+
+	static Ref<PersistentArray> from_array(const Array &p_array);
+	static Ref<PersistentArray> from_data(const Data &p_data);
+
+	const Data &get_data() const { return data; }
+
+	int size() const;
+	bool is_empty() const;
+	Variant get_at(int p_index) const;
+
+	Ref<PersistentArray> set_at(int p_index, const Variant &p_value) const;
+	Ref<PersistentArray> push_back(const Variant &p_value) const;
+	Ref<PersistentArray> pop_back() const;
+
+	Array to_array() const;
+};
+
+class PersistentDictionary : public RefCounted {
+	GDCLASS(PersistentDictionary, RefCounted);
+
+	PersistentHashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> data;
+
+protected:
+	static void _bind_methods();
+
+public:
+	typedef PersistentHashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> Data;
+
+	static Ref<PersistentDictionary> from_dictionary(const Dictionary &p_dictionary);
+	static Ref<PersistentDictionary> from_data(const Data &p_data);
+
+	const Data &get_data() const { return data; }
+
+	int size() const;
+	bool is_empty() const;
+	bool has(const Variant &p_key) const;
+	Variant get_value(const Variant &p_key, const Variant &p_default = Variant()) const;
+
+	Ref<PersistentDictionary> set_value(const Variant &p_key, const Variant &p_value) const;
+	Ref<PersistentDictionary> erase(const Variant &p_key) const;
+
+	Array keys() const;
+	Array values() const;
+	Dictionary to_dictionary() const;
+};
+
+#endif // PERSISTENT_COLLECTIONS_H
@@ -2484,11 +2484,21 @@ Variant::Variant(const StringName &p_string) :
 	memnew_placement(_data._mem, StringName(p_string));
 }
 
+Variant::Variant(StringName &&p_string) :
+		type(STRING_NAME) {
+	memnew_placement(_data._mem, StringName(std::move(p_string)));
+}
+
 Variant::Variant(const String &p_string) :
 		type(STRING) {
 	memnew_placement(_data._mem, String(p_string));
 }
 
+Variant::Variant(String &&p_string) :
+		type(STRING) {
+	memnew_placement(_data._mem, String(std::move(p_string)));
+}
+
 Variant::Variant(const char *const p_cstring) :
 		type(STRING) {
 	memnew_placement(_data._mem, String((const char *)p_cstring));
@@ -2621,6 +2631,11 @@ Variant::Variant(const Callable &p_callable) :
 	memnew_placement(_data._mem, Callable(p_callable));
 }
 
+Variant::Variant(Callable &&p_callable) :
+		type(CALLABLE) {
+	memnew_placement(_data._mem, Callable(std::move(p_callable)));
+}
+
 Variant::Variant(const Signal &p_callable) :
 		type(SIGNAL) {
 	memnew_placement(_data._mem, Signal(p_callable));
@@ -2631,11 +2646,21 @@ Variant::Variant(const Dictionary &p_dictionary) :
 	memnew_placement(_data._mem, Dictionary(p_dictionary));
 }
 
+Variant::Variant(Dictionary &&p_dictionary) :
+		type(DICTIONARY) {
+	memnew_placement(_data._mem, Dictionary(std::move(p_dictionary)));
+}
+
 Variant::Variant(const Array &p_array) :
 		type(ARRAY) {
 	memnew_placement(_data._mem, Array(p_array));
 }
 
+Variant::Variant(Array &&p_array) :
+		type(ARRAY) {
+	memnew_placement(_data._mem, Array(std::move(p_array)));
+}
+
 Variant::Variant(const PackedByteArray &p_byte_array) :
 		type(PACKED_BYTE_ARRAY) {
 	_data.packed_array = PackedArrayRef<uint8_t>::create(p_byte_array);
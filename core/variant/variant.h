@@ -62,6 +62,7 @@
 #include "core/variant/dictionary.h"
 
 class Object;
+class ObjectInlineCache;
 
 struct PropertyInfo;
 struct MethodInfo;
@@ -445,7 +446,9 @@ public:
 	Variant(double p_double);
 	Variant(const ObjectID &p_id);
 	Variant(const String &p_string);
+	Variant(String &&p_string);
 	Variant(const StringName &p_string);
+	Variant(StringName &&p_string);
 	Variant(const char *const p_cstring);
 	Variant(const char32_t *p_wstring);
 	Variant(const Vector2 &p_vector2);
@@ -468,10 +471,13 @@ public:
 	Variant(const ::RID &p_rid);
 	Variant(const Object *p_object);
 	Variant(const Callable &p_callable);
+	Variant(Callable &&p_callable);
 	Variant(const Signal &p_signal);
 	Variant(const Dictionary &p_dictionary);
+	Variant(Dictionary &&p_dictionary);
 
 	Variant(const Array &p_array);
+	Variant(Array &&p_array);
 	Variant(const PackedByteArray &p_byte_array);
 	Variant(const PackedInt32Array &p_int32_array);
 	Variant(const PackedInt64Array &p_int64_array);
@@ -588,6 +594,8 @@ public:
 	static uint32_t get_builtin_method_hash(Variant::Type p_type, const StringName &p_method);
 
 	void callp(const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error);
+	// Same as callp(), but calls on objects go through a per-call-site cache.
+	void callp_cached(ObjectInlineCache &r_cache, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error);
 
 	template <typename... VarArgs>
 	Variant call(const StringName &p_method, VarArgs... p_args) {
@@ -643,6 +651,9 @@ public:
 
 	void set_named(const StringName &p_member, const Variant &p_value, bool &r_valid);
 	Variant get_named(const StringName &p_member, bool &r_valid) const;
+	// Same as set_named() and get_named(), but objects go through a per-call-site cache.
+	void set_named_cached(ObjectInlineCache &r_cache, const StringName &p_member, const Variant &p_value, bool &r_valid);
+	Variant get_named_cached(ObjectInlineCache &r_cache, const StringName &p_member, bool &r_valid) const;
 
 	typedef void (*ValidatedSetter)(Variant *base, const Variant *value);
 	typedef void (*ValidatedGetter)(const Variant *base, Variant *value);
@@ -792,11 +803,27 @@ public:
 	static void construct_from_string(const String &p_string, Variant &r_value, ObjectConstruct p_obj_construct = nullptr, void *p_construct_ud = nullptr);
 
 	void operator=(const Variant &p_variant); // only this is enough for all the other types
+	// Moving takes over the source's data without touching reference counts and leaves the source as `null`.
+	_FORCE_INLINE_ void operator=(Variant &&p_variant) {
+		if (unlikely(this == &p_variant)) {
+			return;
+		}
+		// Release the old value last, it may own the source.
+		Variant previous(std::move(*this));
+		type = p_variant.type;
+		_data = p_variant._data;
+		p_variant.type = NIL;
+	}
 
 	static void register_types();
 	static void unregister_types();
 
 	Variant(const Variant &p_variant);
+	_FORCE_INLINE_ Variant(Variant &&p_variant) :
+			type(p_variant.type) {
+		_data = p_variant._data;
+		p_variant.type = NIL;
+	}
 	_FORCE_INLINE_ Variant() :
 			type(NIL) {}
 	_FORCE_INLINE_ ~Variant() {
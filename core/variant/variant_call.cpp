@@ -34,6 +34,7 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/io/compression.h"
 #include "core/io/marshalls.h"
+#include "core/math/packed_math.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
 #include "core/templates/local_vector.h"
@@ -572,7 +573,6 @@ static _FORCE_INLINE_ void vc_ptrcall(void (*method)(T *, P...), void *p_base, c
 			Callable::CallError ce;                                                                                                                               \
 			m_method_ptr(&base, vars_ptrs.ptr(), p_argcount, ret, ce);                                                                                            \
 			if (m_has_return) {                                                                                                                                   \
-				m_return_type r = ret;                                                                                                                            \
 				PtrToArg<m_return_type>::encode(ret, r_ret);                                                                                                      \
 			}                                                                                                                                                     \
 		}                                                                                                                                                         \
@@ -1018,6 +1018,76 @@ struct _VariantCall {
 		return len;
 	}
 
+	static AABB func_PackedVector3Array_get_aabb(PackedVector3Array *p_instance) {
+		return PackedMath::get_aabb(p_instance->ptr(), p_instance->size());
+	}
+	static PackedVector3Array func_PackedVector3Array_lerp(PackedVector3Array *p_instance, const PackedVector3Array &p_to, double p_weight) {
+		PackedVector3Array ret;
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_to.size(), ret, "Both arrays must have the same size.");
+		ret.resize(p_instance->size());
+		PackedMath::lerp(p_instance->ptr(), p_to.ptr(), p_weight, ret.ptrw(), ret.size());
+		return ret;
+	}
+	static PackedFloat32Array func_PackedVector3Array_dot(PackedVector3Array *p_instance, const PackedVector3Array &p_with) {
+		PackedFloat32Array ret;
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_with.size(), ret, "Both arrays must have the same size.");
+		ret.resize(p_instance->size());
+		PackedMath::dot(p_instance->ptr(), p_with.ptr(), ret.ptrw(), ret.size());
+		return ret;
+	}
+	static PackedVector3Array func_PackedVector3Array_cross(PackedVector3Array *p_instance, const PackedVector3Array &p_with) {
+		PackedVector3Array ret;
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_with.size(), ret, "Both arrays must have the same size.");
+		ret.resize(p_instance->size());
+		PackedMath::cross(p_instance->ptr(), p_with.ptr(), ret.ptrw(), ret.size());
+		return ret;
+	}
+	static PackedFloat32Array func_PackedVector3Array_lengths(PackedVector3Array *p_instance) {
+		PackedFloat32Array ret;
+		ret.resize(p_instance->size());
+		PackedMath::length(p_instance->ptr(), ret.ptrw(), ret.size());
+		return ret;
+	}
+
+	static Rect2 func_PackedVector2Array_get_rect(PackedVector2Array *p_instance) {
+		return PackedMath::get_rect(p_instance->ptr(), p_instance->size());
+	}
+	static PackedVector2Array func_PackedVector2Array_lerp(PackedVector2Array *p_instance, const PackedVector2Array &p_to, double p_weight) {
+		PackedVector2Array ret;
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_to.size(), ret, "Both arrays must have the same size.");
+		ret.resize(p_instance->size());
+		PackedMath::lerp(p_instance->ptr(), p_to.ptr(), p_weight, ret.ptrw(), ret.size());
+		return ret;
+	}
+	static PackedFloat32Array func_PackedVector2Array_dot(PackedVector2Array *p_instance, const PackedVector2Array &p_with) {
+		PackedFloat32Array ret;
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_with.size(), ret, "Both arrays must have the same size.");
+		ret.resize(p_instance->size());
+		PackedMath::dot(p_instance->ptr(), p_with.ptr(), ret.ptrw(), ret.size());
+		return ret;
+	}
+	static PackedFloat32Array func_PackedVector2Array_cross(PackedVector2Array *p_instance, const PackedVector2Array &p_with) {
+		PackedFloat32Array ret;
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_with.size(), ret, "Both arrays must have the same size.");
+		ret.resize(p_instance->size());
+		PackedMath::cross(p_instance->ptr(), p_with.ptr(), ret.ptrw(), ret.size());
+		return ret;
+	}
+	static PackedFloat32Array func_PackedVector2Array_lengths(PackedVector2Array *p_instance) {
+		PackedFloat32Array ret;
+		ret.resize(p_instance->size());
+		PackedMath::length(p_instance->ptr(), ret.ptrw(), ret.size());
+		return ret;
+	}
+
+	static PackedColorArray func_PackedColorArray_lerp(PackedColorArray *p_instance, const PackedColorArray &p_to, double p_weight) {
+		PackedColorArray ret;
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_to.size(), ret, "Both arrays must have the same size.");
+		ret.resize(p_instance->size());
+		PackedMath::lerp(p_instance->ptr(), p_to.ptr(), p_weight, ret.ptrw(), ret.size());
+		return ret;
+	}
+
 	static void func_Callable_call(Variant *v, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 		Callable *callable = VariantGetInternalPtr<Callable>::get_ptr(v);
 		callable->callp(p_args, p_argcount, r_ret, r_error);
@@ -1224,6 +1294,26 @@ void Variant::callp(const StringName &p_method, const Variant **p_args, int p_ar
 	}
 }
 
+void Variant::callp_cached(ObjectInlineCache &r_cache, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
+	if (type != Variant::OBJECT) {
+		callp(p_method, p_args, p_argcount, r_ret, r_error);
+		return;
+	}
+
+	Object *obj = _get_obj().obj;
+	if (!obj) {
+		r_error.error = Callable::CallError::CALL_ERROR_INSTANCE_IS_NULL;
+		return;
+	}
+#ifdef DEBUG_ENABLED
+	if (EngineDebugger::is_active() && !_get_obj().id.is_ref_counted() && ObjectDB::get_instance(_get_obj().id) == nullptr) {
+		r_error.error = Callable::CallError::CALL_ERROR_INSTANCE_IS_NULL;
+		return;
+	}
+#endif
+	r_ret = obj->callp_cached(r_cache, p_method, p_args, p_argcount, r_error);
+}
+
 void Variant::call_const(const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 	if (type == Variant::OBJECT) {
 		//call object
@@ -2526,6 +2616,11 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector2Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedVector2Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector2Array, count, sarray("value"), varray());
+	bind_function(PackedVector2Array, get_rect, _VariantCall::func_PackedVector2Array_get_rect, sarray(), varray());
+	bind_function(PackedVector2Array, lerp, _VariantCall::func_PackedVector2Array_lerp, sarray("to", "weight"), varray());
+	bind_function(PackedVector2Array, dot, _VariantCall::func_PackedVector2Array_dot, sarray("with"), varray());
+	bind_function(PackedVector2Array, cross, _VariantCall::func_PackedVector2Array_cross, sarray("with"), varray());
+	bind_function(PackedVector2Array, lengths, _VariantCall::func_PackedVector2Array_lengths, sarray(), varray());
 
 	/* Vector3 Array */
 
@@ -2550,6 +2645,11 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector3Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedVector3Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector3Array, count, sarray("value"), varray());
+	bind_function(PackedVector3Array, get_aabb, _VariantCall::func_PackedVector3Array_get_aabb, sarray(), varray());
+	bind_function(PackedVector3Array, lerp, _VariantCall::func_PackedVector3Array_lerp, sarray("to", "weight"), varray());
+	bind_function(PackedVector3Array, dot, _VariantCall::func_PackedVector3Array_dot, sarray("with"), varray());
+	bind_function(PackedVector3Array, cross, _VariantCall::func_PackedVector3Array_cross, sarray("with"), varray());
+	bind_function(PackedVector3Array, lengths, _VariantCall::func_PackedVector3Array_lengths, sarray(), varray());
 
 	/* Color Array */
 
@@ -2574,6 +2674,7 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedColorArray, find, sarray("value", "from"), varray(0));
 	bind_method(PackedColorArray, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedColorArray, count, sarray("value"), varray());
+	bind_function(PackedColorArray, lerp, _VariantCall::func_PackedColorArray_lerp, sarray("to", "weight"), varray());
 
 	/* Vector4 Array */
 
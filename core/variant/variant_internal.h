@@ -883,6 +883,7 @@ template <>
 struct VariantInternalAccessor<String> {
 	static _FORCE_INLINE_ const String &get(const Variant *v) { return *VariantInternal::get_string(v); }
 	static _FORCE_INLINE_ void set(Variant *v, const String &p_value) { *VariantInternal::get_string(v) = p_value; }
+	static _FORCE_INLINE_ void set(Variant *v, String &&p_value) { *VariantInternal::get_string(v) = std::move(p_value); }
 };
 
 template <>
@@ -984,6 +985,7 @@ template <>
 struct VariantInternalAccessor<StringName> {
 	static _FORCE_INLINE_ const StringName &get(const Variant *v) { return *VariantInternal::get_string_name(v); }
 	static _FORCE_INLINE_ void set(Variant *v, const StringName &p_value) { *VariantInternal::get_string_name(v) = p_value; }
+	static _FORCE_INLINE_ void set(Variant *v, StringName &&p_value) { *VariantInternal::get_string_name(v) = std::move(p_value); }
 };
 
 template <>
@@ -1002,6 +1004,7 @@ template <>
 struct VariantInternalAccessor<Callable> {
 	static _FORCE_INLINE_ const Callable &get(const Variant *v) { return *VariantInternal::get_callable(v); }
 	static _FORCE_INLINE_ void set(Variant *v, const Callable &p_value) { *VariantInternal::get_callable(v) = p_value; }
+	static _FORCE_INLINE_ void set(Variant *v, Callable &&p_value) { *VariantInternal::get_callable(v) = std::move(p_value); }
 };
 
 template <>
@@ -1014,12 +1017,14 @@ template <>
 struct VariantInternalAccessor<Dictionary> {
 	static _FORCE_INLINE_ const Dictionary &get(const Variant *v) { return *VariantInternal::get_dictionary(v); }
 	static _FORCE_INLINE_ void set(Variant *v, const Dictionary &p_value) { *VariantInternal::get_dictionary(v) = p_value; }
+	static _FORCE_INLINE_ void set(Variant *v, Dictionary &&p_value) { *VariantInternal::get_dictionary(v) = std::move(p_value); }
 };
 
 template <>
 struct VariantInternalAccessor<Array> {
 	static _FORCE_INLINE_ const Array &get(const Variant *v) { return *VariantInternal::get_array(v); }
 	static _FORCE_INLINE_ void set(Variant *v, const Array &p_value) { *VariantInternal::get_array(v) = p_value; }
+	static _FORCE_INLINE_ void set(Variant *v, Array &&p_value) { *VariantInternal::get_array(v) = std::move(p_value); }
 };
 
 template <>
@@ -1093,6 +1098,7 @@ struct VariantInternalAccessor<Variant> {
 	static _FORCE_INLINE_ Variant &get(Variant *v) { return *v; }
 	static _FORCE_INLINE_ const Variant &get(const Variant *v) { return *v; }
 	static _FORCE_INLINE_ void set(Variant *v, const Variant &p_value) { *v = p_value; }
+	static _FORCE_INLINE_ void set(Variant *v, Variant &&p_value) { *v = std::move(p_value); }
 };
 
 template <>
@@ -313,6 +313,33 @@ Variant Variant::get_named(const StringName &p_member, bool &r_valid) const {
 	return Variant();
 }
 
+void Variant::set_named_cached(ObjectInlineCache &r_cache, const StringName &p_member, const Variant &p_value, bool &r_valid) {
+	if (type != Variant::OBJECT) {
+		set_named(p_member, p_value, r_valid);
+		return;
+	}
+
+	Object *obj = get_validated_object();
+	if (!obj) {
+		r_valid = false;
+		return;
+	}
+	obj->set_cached(r_cache, p_member, p_value, &r_valid);
+}
+
+Variant Variant::get_named_cached(ObjectInlineCache &r_cache, const StringName &p_member, bool &r_valid) const {
+	if (type != Variant::OBJECT) {
+		return get_named(p_member, r_valid);
+	}
+
+	Object *obj = get_validated_object();
+	if (!obj) {
+		r_valid = false;
+		return "Instance base is null.";
+	}
+	return obj->get_cached(r_cache, p_member, &r_valid);
+}
+
 /**** INDEXED SETTERS AND GETTERS ****/
 
 #ifdef DEBUG_ENABLED
@@ -1171,6 +1171,15 @@ PackedByteArray VariantUtilityFunctions::var_to_bytes_with_objects(const Variant
 	return barr;
 }
 
+PackedByteArray VariantUtilityFunctions::var_to_bytes_packed(const Variant &p_var) {
+	PackedByteArray barr;
+	Error err = encode_variant_packed(p_var, barr);
+	if (err != OK) {
+		return PackedByteArray();
+	}
+	return barr;
+}
+
 Variant VariantUtilityFunctions::bytes_to_var(const PackedByteArray &p_arr) {
 	Variant ret;
 	{
@@ -1817,6 +1826,8 @@ void Variant::_register_variant_utility_functions() {
 	FUNCBINDR(var_to_bytes_with_objects, sarray("variable"), Variant::UTILITY_FUNC_TYPE_GENERAL);
 	FUNCBINDR(bytes_to_var_with_objects, sarray("bytes"), Variant::UTILITY_FUNC_TYPE_GENERAL);
 
+	FUNCBINDR(var_to_bytes_packed, sarray("variable"), Variant::UTILITY_FUNC_TYPE_GENERAL);
+
 	FUNCBINDR(hash, sarray("variable"), Variant::UTILITY_FUNC_TYPE_GENERAL);
 
 	FUNCBINDR(instance_from_id, sarray("instance_id"), Variant::UTILITY_FUNC_TYPE_GENERAL);
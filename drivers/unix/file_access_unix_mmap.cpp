@@ -0,0 +1,314 @@
+/**************************************************************************/
+/*  file_access_unix_mmap.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_unix_mmap.h"
+
+#if defined(UNIX_ENABLED)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct FileAccessUnixMMap::Mapping {
+	String path;
+	const uint8_t *data = nullptr;
+	uint64_t length = 0;
+	dev_t device = 0;
+	ino_t inode = 0;
+	time_t modified_time = 0;
+	uint32_t refcount = 0; // Guarded by mappings_mutex.
+};
+
+Mutex FileAccessUnixMMap::mappings_mutex;
+HashMap<String, FileAccessUnixMMap::Mapping *> FileAccessUnixMMap::mappings;
+
+Error FileAccessUnixMMap::_acquire_mapping(const String &p_path, Mapping *&r_mapping) {
+	int fd = ::open(p_path.utf8().get_data(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1) {
+		return errno == ENOENT ? ERR_FILE_NOT_FOUND : ERR_FILE_CANT_OPEN;
+	}
+
+	struct stat st = {};
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+		::close(fd);
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	MutexLock lock(mappings_mutex);
+
+	// Reuse the existing mapping unless the file was replaced or modified since.
+	HashMap<String, Mapping *>::Iterator E = mappings.find(p_path);
+	if (E) {
+		Mapping *m = E->value;
+		if (m->device == st.st_dev && m->inode == st.st_ino && m->length == (uint64_t)st.st_size && m->modified_time == st.st_mtime) {
+			m->refcount++;
+			::close(fd);
+			r_mapping = m;
+			return OK;
+		}
+	}
+
+	const uint8_t *mapped = nullptr;
+	if (st.st_size > 0) {
+		void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (addr == MAP_FAILED) {
+			::close(fd);
+			return ERR_FILE_CANT_OPEN;
+		}
+		mapped = (const uint8_t *)addr;
+	}
+	// The mapping keeps the pages reachable on its own.
+	::close(fd);
+
+	Mapping *m = memnew(Mapping);
+	m->path = p_path;
+	m->data = mapped;
+	m->length = st.st_size;
+	m->device = st.st_dev;
+	m->inode = st.st_ino;
+	m->modified_time = st.st_mtime;
+	m->refcount = 1;
+
+	// A stale mapping stays alive for its current users, it just can't be found anymore.
+	mappings[p_path] = m;
+
+	r_mapping = m;
+	return OK;
+}
+
+void FileAccessUnixMMap::_release_mapping(Mapping *p_mapping) {
+	MutexLock lock(mappings_mutex);
+
+	if (--p_mapping->refcount > 0) {
+		return;
+	}
+
+	HashMap<String, Mapping *>::Iterator E = mappings.find(p_mapping->path);
+	if (E && E->value == p_mapping) {
+		mappings.remove(E);
+	}
+
+	if (p_mapping->data) {
+		munmap((void *)p_mapping->data, p_mapping->length);
+	}
+	memdelete(p_mapping);
+}
+
+Error FileAccessUnixMMap::open_internal(const String &p_path, int p_mode_flags) {
+	_close();
+
+	// Writes go through FileAccessUnix, the caller falls back to it.
+	if (p_mode_flags != READ) {
+		return ERR_UNAVAILABLE;
+	}
+
+	path_src = p_path;
+	path = fix_path(p_path);
+
+	last_error = _acquire_mapping(path, mapping);
+	if (last_error != OK) {
+		mapping = nullptr;
+		return last_error;
+	}
+
+	data = mapping->data;
+	length = mapping->length;
+	pos = 0;
+	return OK;
+}
+
+void FileAccessUnixMMap::_close() {
+	if (!mapping) {
+		return;
+	}
+
+	_release_mapping(mapping);
+	mapping = nullptr;
+	data = nullptr;
+	length = 0;
+	pos = 0;
+}
+
+bool FileAccessUnixMMap::is_open() const {
+	return mapping != nullptr;
+}
+
+String FileAccessUnixMMap::get_path() const {
+	return path_src;
+}
+
+String FileAccessUnixMMap::get_path_absolute() const {
+	return path;
+}
+
+void FileAccessUnixMMap::seek(uint64_t p_position) {
+	ERR_FAIL_NULL_MSG(mapping, "File must be opened before use.");
+
+	last_error = OK;
+	pos = p_position;
+}
+
+void FileAccessUnixMMap::seek_end(int64_t p_position) {
+	ERR_FAIL_NULL_MSG(mapping, "File must be opened before use.");
+	ERR_FAIL_COND(p_position < 0 && (uint64_t)-p_position > length);
+
+	pos = length + p_position;
+}
+
+uint64_t FileAccessUnixMMap::get_position() const {
+	ERR_FAIL_NULL_V_MSG(mapping, 0, "File must be opened before use.");
+	return pos;
+}
+
+uint64_t FileAccessUnixMMap::get_length() const {
+	ERR_FAIL_NULL_V_MSG(mapping, 0, "File must be opened before use.");
+	return length;
+}
+
+bool FileAccessUnixMMap::eof_reached() const {
+	return last_error == ERR_FILE_EOF;
+}
+
+uint64_t FileAccessUnixMMap::_read(void *p_dst, uint64_t p_length) const {
+	uint64_t available = pos < length ? length - pos : 0;
+	uint64_t to_read = MIN(p_length, available);
+	if (to_read > 0) {
+		memcpy(p_dst, data + pos, to_read);
+		pos += to_read;
+	}
+	if (to_read < p_length) {
+		last_error = ERR_FILE_EOF;
+	}
+	return to_read;
+}
+
+uint8_t FileAccessUnixMMap::get_8() const {
+	ERR_FAIL_NULL_V_MSG(mapping, 0, "File must be opened before use.");
+
+	if (pos >= length) {
+		last_error = ERR_FILE_EOF;
+		return 0;
+	}
+	return data[pos++];
+}
+
+uint16_t FileAccessUnixMMap::get_16() const {
+	ERR_FAIL_NULL_V_MSG(mapping, 0, "File must be opened before use.");
+
+	uint16_t b = 0;
+	_read(&b, 2);
+
+	if (big_endian) {
+		b = BSWAP16(b);
+	}
+
+	return b;
+}
+
+uint32_t FileAccessUnixMMap::get_32() const {
+	ERR_FAIL_NULL_V_MSG(mapping, 0, "File must be opened before use.");
+
+	uint32_t b = 0;
+	_read(&b, 4);
+
+	if (big_endian) {
+		b = BSWAP32(b);
+	}
+
+	return b;
+}
+
+uint64_t FileAccessUnixMMap::get_64() const {
+	ERR_FAIL_NULL_V_MSG(mapping, 0, "File must be opened before use.");
+
+	uint64_t b = 0;
+	_read(&b, 8);
+
+	if (big_endian) {
+		b = BSWAP64(b);
+	}
+
+	return b;
+}
+
+uint64_t FileAccessUnixMMap::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+	ERR_FAIL_NULL_V_MSG(mapping, -1, "File must be opened before use.");
+
+	return _read(p_dst, p_length);
+}
+
+const uint8_t *FileAccessUnixMMap::get_buffer_ptr(uint64_t p_length) const {
+	ERR_FAIL_NULL_V_MSG(mapping, nullptr, "File must be opened before use.");
+
+	if (pos > length || p_length > length - pos) {
+		return nullptr;
+	}
+
+	const uint8_t *ptr = data + pos;
+	pos += p_length;
+	return ptr;
+}
+
+Error FileAccessUnixMMap::get_error() const {
+	return last_error;
+}
+
+void FileAccessUnixMMap::store_8(uint8_t p_dest) {
+	ERR_FAIL_MSG("Memory-mapped files are read-only.");
+}
+
+void FileAccessUnixMMap::store_16(uint16_t p_dest) {
+	ERR_FAIL_MSG("Memory-mapped files are read-only.");
+}
+
+void FileAccessUnixMMap::store_32(uint32_t p_dest) {
+	ERR_FAIL_MSG("Memory-mapped files are read-only.");
+}
+
+void FileAccessUnixMMap::store_64(uint64_t p_dest) {
+	ERR_FAIL_MSG("Memory-mapped files are read-only.");
+}
+
+void FileAccessUnixMMap::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL_MSG("Memory-mapped files are read-only.");
+}
+
+void FileAccessUnixMMap::close() {
+	_close();
+}
+
+FileAccessUnixMMap::~FileAccessUnixMMap() {
+	_close();
+}
+
+#endif // UNIX_ENABLED
@@ -44,6 +44,7 @@
 #include "editor/editor_paths.h"
 #include "editor/editor_resource_preview.h"
 #include "editor/editor_settings.h"
+#include "editor/import/editor_import_cache.h"
 #include "scene/resources/packed_scene.h"
 
 EditorFileSystem *EditorFileSystem::singleton = nullptr;
@@ -694,7 +695,11 @@ bool EditorFileSystem::_update_scan_actions() {
 			return true;
 		}
 
+		// Only files found changed by a scan may come from the shared import cache,
+		// reimports requested explicitly always run the importer.
+		use_import_cache = true;
 		reimport_files(reimports);
+		use_import_cache = false;
 	} else {
 		//reimport files will update the uid cache file so if nothing was reimported, update it manually
 		ResourceUID::get_singleton()->update_cache();
@@ -2168,7 +2173,15 @@ Error EditorFileSystem::_reimport_file(const String &p_file, const HashMap<Strin
 	List<String> import_variants;
 	List<String> gen_files;
 	Variant meta;
-	Error err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &meta);
+	Error err = OK;
+
+	const String cache_key = EditorImportCache::make_key(p_file, importer, params, generator_parameters);
+	if (!use_import_cache || !EditorImportCache::restore(cache_key, base_path, &import_variants, &meta)) {
+		const bool can_store = EditorImportCache::begin_import(cache_key, base_path);
+		err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &meta);
+		// Imports that write files outside of the imported directory can't be restored.
+		EditorImportCache::end_import(cache_key, base_path, err == OK, can_store && gen_files.is_empty(), import_variants, meta);
+	}
 
 	ERR_FAIL_COND_V_MSG(err != OK, ERR_FILE_UNRECOGNIZED, "Error importing '" + p_file + "'.");
 
@@ -165,6 +165,7 @@ class EditorFileSystem : public Node {
 
 	bool scanning = false;
 	bool importing = false;
+	bool use_import_cache = false;
 	bool first_scan = true;
 	bool scan_changes_pending = false;
 	float scan_total;
@@ -3157,6 +3157,28 @@ void ResourceImporterScene::add_post_importer_plugin(const Ref<EditorScenePostIm
 	}
 }
 
+static bool _is_external_plugin(const Object *p_plugin) {
+	if (p_plugin->get_script_instance()) {
+		return true;
+	}
+	const ClassDB::APIType api = ClassDB::get_api_type(p_plugin->get_class_name());
+	return api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION;
+}
+
+bool ResourceImporterScene::has_external_plugins() {
+	for (const Ref<EditorSceneFormatImporter> &importer : scene_importers) {
+		if (_is_external_plugin(importer.ptr())) {
+			return true;
+		}
+	}
+	for (const Ref<EditorScenePostImportPlugin> &plugin : post_importer_plugins) {
+		if (_is_external_plugin(plugin.ptr())) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void ResourceImporterScene::remove_scene_importer(Ref<EditorSceneFormatImporter> p_importer) {
 	scene_importers.erase(p_importer);
 }
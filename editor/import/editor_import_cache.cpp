@@ -0,0 +1,352 @@
+/**************************************************************************/
+/*  editor_import_cache.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "editor_import_cache.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/config_file.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/resource_uid.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/variant/variant_parser.h"
+#include "editor/editor_settings.h"
+#include "editor/import/3d/resource_importer_scene.h"
+#include "editor/import/editor_import_plugin.h"
+
+SafeNumeric<uint64_t> EditorImportCache::hits;
+SafeNumeric<uint64_t> EditorImportCache::misses;
+SafeNumeric<uint64_t> EditorImportCache::stores;
+
+String EditorImportCache::get_cache_path() {
+	if (!EditorSettings::get_singleton()) {
+		return String();
+	}
+	return String(EDITOR_GET("filesystem/import/shared_cache_path")).strip_edges();
+}
+
+bool EditorImportCache::_has_save_to_file(const Variant &p_value) {
+	if (p_value.get_type() == Variant::DICTIONARY) {
+		const Dictionary dict = p_value;
+		for (const Variant &key : dict.keys()) {
+			if (key.get_type() == Variant::STRING && String(key).ends_with("save_to_file/enabled") && bool(dict[key])) {
+				return true;
+			}
+			if (_has_save_to_file(dict[key])) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool EditorImportCache::_is_cacheable(const String &p_source_file, const Ref<ResourceImporter> &p_importer, const HashMap<StringName, Variant> &p_params) {
+	if (p_importer.is_null()) {
+		return false;
+	}
+	// Importers defined by scripts or extensions may change without changing their version.
+	if (Object::cast_to<EditorImportPlugin>(p_importer.ptr())) {
+		return false;
+	}
+	if (Object::cast_to<ResourceImporterScene>(p_importer.ptr()) && ResourceImporterScene::has_external_plugins()) {
+		return false;
+	}
+	// Post-import scripts run arbitrary code, and saving sub-resources to files
+	// writes outside of the imported directory (and reads those files back).
+	const Variant *import_script = p_params.getptr("import_script/path");
+	if (import_script && !String(*import_script).is_empty()) {
+		return false;
+	}
+	for (const KeyValue<StringName, Variant> &E : p_params) {
+		if (_has_save_to_file(E.value)) {
+			return false;
+		}
+	}
+	// The key only covers the contents of the source file itself. Text scene formats
+	// bake in data from sibling files (glTF buffers, OBJ material libraries), so a
+	// change there would not be noticed.
+	const String ext = p_source_file.get_extension().to_lower();
+	if (ext == "gltf" || ext == "obj") {
+		return false;
+	}
+	return true;
+}
+
+void EditorImportCache::_add_referenced_files(const Variant &p_value, String &r_key_text) {
+	// Options naming files (e.g. `roughness/src_normal`) are consumed by content,
+	// so what matters is the file contents, not only the path.
+	switch (p_value.get_type()) {
+		case Variant::STRING: {
+			String path = p_value;
+			if (path.begins_with("uid://")) {
+				const ResourceUID::ID id = ResourceUID::get_singleton()->text_to_id(path);
+				if (id == ResourceUID::INVALID_ID || !ResourceUID::get_singleton()->has_id(id)) {
+					break;
+				}
+				path = ResourceUID::get_singleton()->get_id_path(id);
+			}
+			if (path.is_absolute_path() && FileAccess::exists(path)) {
+				r_key_text += "file:" + path + "=" + FileAccess::get_sha256(path) + "\n";
+			}
+		} break;
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			for (int i = 0; i < array.size(); i++) {
+				_add_referenced_files(array[i], r_key_text);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			const Dictionary dict = p_value;
+			for (const Variant &key : dict.keys()) {
+				_add_referenced_files(dict[key], r_key_text);
+			}
+		} break;
+		default: {
+		}
+	}
+}
+
+String EditorImportCache::make_key(const String &p_source_file, const Ref<ResourceImporter> &p_importer, const HashMap<StringName, Variant> &p_params, const Variant &p_generator_parameters) {
+	if (get_cache_path().is_empty() || !_is_cacheable(p_source_file, p_importer, p_params)) {
+		return String();
+	}
+
+	const String source_hash = FileAccess::get_sha256(p_source_file);
+	if (source_hash.is_empty()) {
+		return String();
+	}
+
+	// The source path is part of the key because imported resources may embed it
+	// (e.g. as resource paths), so only projects with the same layout share entries.
+	String key_text = "v2\n";
+	key_text += p_source_file + "\n";
+	key_text += source_hash + "\n";
+	key_text += p_importer->get_importer_name() + "\n";
+	key_text += itos(p_importer->get_format_version()) + "\n";
+	key_text += p_importer->get_import_settings_string() + "\n";
+
+	List<StringName> names;
+	for (const KeyValue<StringName, Variant> &E : p_params) {
+		names.push_back(E.key);
+	}
+	names.sort_custom<StringName::AlphCompare>();
+	for (const StringName &E : names) {
+		String value;
+		VariantWriter::write_to_string(p_params[E], value);
+		key_text += String(E) + "=" + value + "\n";
+		_add_referenced_files(p_params[E], key_text);
+	}
+
+	if (p_generator_parameters != Variant()) {
+		String value;
+		VariantWriter::write_to_string(p_generator_parameters, value);
+		key_text += "generator=" + value + "\n";
+	}
+
+	return key_text.sha256_text();
+}
+
+String EditorImportCache::_get_entry_dir(const String &p_key) {
+	return get_cache_path().path_join(p_key.substr(0, 2)).path_join(p_key);
+}
+
+String EditorImportCache::_get_previous_outputs_dir(const String &p_base_path) {
+	return ProjectSettings::get_singleton()->globalize_path(p_base_path.get_base_dir()).path_join(".previous");
+}
+
+void EditorImportCache::_get_output_files(const String &p_dir, const String &p_base_path, List<String> *r_files) {
+	// Importers write their main output and any side files (e.g. `.editor.ctex`)
+	// next to the base path, all sharing its name as a prefix.
+	const String prefix = p_base_path.get_file() + ".";
+	const PackedStringArray files = DirAccess::get_files_at(p_dir);
+	for (const String &file : files) {
+		if (file.begins_with(prefix) && !file.ends_with(".md5")) {
+			r_files->push_back(file);
+		}
+	}
+}
+
+void EditorImportCache::_remove_dir(const String &p_dir) {
+	Ref<DirAccess> da = DirAccess::open(p_dir);
+	if (da.is_valid()) {
+		da->erase_contents_recursive();
+	}
+	DirAccess::remove_absolute(p_dir);
+}
+
+bool EditorImportCache::restore(const String &p_key, const String &p_base_path, List<String> *r_import_variants, Variant *r_metadata) {
+	if (p_key.is_empty()) {
+		return false;
+	}
+
+	const String entry_dir = _get_entry_dir(p_key);
+	Ref<ConfigFile> manifest;
+	manifest.instantiate();
+	if (manifest->load(entry_dir.path_join("manifest.cfg")) != OK) {
+		misses.increment();
+		return false;
+	}
+
+	const PackedStringArray files = manifest->get_value("entry", "files", PackedStringArray());
+	if (files.is_empty()) {
+		misses.increment();
+		return false;
+	}
+
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	const String dest_base = ProjectSettings::get_singleton()->globalize_path(p_base_path);
+	for (const String &suffix : files) {
+		if (da->copy(entry_dir.path_join(suffix), dest_base + "." + suffix) != OK) {
+			// A partially restored entry is harmless, the regular import overwrites it.
+			misses.increment();
+			return false;
+		}
+	}
+
+	const PackedStringArray variants = manifest->get_value("entry", "variants", PackedStringArray());
+	for (const String &variant : variants) {
+		r_import_variants->push_back(variant);
+	}
+	*r_metadata = manifest->get_value("entry", "metadata", Variant());
+
+	hits.increment();
+	print_verbose(vformat("EditorImportCache: Restored '%s' from the shared cache.", p_base_path));
+	return true;
+}
+
+bool EditorImportCache::begin_import(const String &p_key, const String &p_base_path) {
+	if (p_key.is_empty()) {
+		return false;
+	}
+
+	const String dir = ProjectSettings::get_singleton()->globalize_path(p_base_path.get_base_dir());
+	List<String> files;
+	_get_output_files(dir, p_base_path, &files);
+	if (files.is_empty()) {
+		return true;
+	}
+
+	const String previous_dir = _get_previous_outputs_dir(p_base_path);
+	if (DirAccess::make_dir_recursive_absolute(previous_dir) != OK) {
+		return false;
+	}
+	for (const String &file : files) {
+		if (DirAccess::rename_absolute(dir.path_join(file), previous_dir.path_join(file)) != OK) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void EditorImportCache::end_import(const String &p_key, const String &p_base_path, bool p_succeeded, bool p_store, const List<String> &p_import_variants, const Variant &p_metadata) {
+	if (p_key.is_empty()) {
+		return;
+	}
+
+	if (p_succeeded && p_store) {
+		_store(p_key, p_base_path, p_import_variants, p_metadata);
+	}
+
+	const String dir = ProjectSettings::get_singleton()->globalize_path(p_base_path.get_base_dir());
+	const String previous_dir = _get_previous_outputs_dir(p_base_path);
+	List<String> previous_files;
+	_get_output_files(previous_dir, p_base_path, &previous_files);
+	for (const String &file : previous_files) {
+		if (!p_succeeded && !FileAccess::exists(dir.path_join(file))) {
+			DirAccess::rename_absolute(previous_dir.path_join(file), dir.path_join(file));
+		} else {
+			DirAccess::remove_absolute(previous_dir.path_join(file));
+		}
+	}
+}
+
+void EditorImportCache::_store(const String &p_key, const String &p_base_path, const List<String> &p_import_variants, const Variant &p_metadata) {
+	// Outputs of previous imports were moved away by begin_import(), so these are
+	// exactly the files written by this import.
+	const String dir = ProjectSettings::get_singleton()->globalize_path(p_base_path.get_base_dir());
+	List<String> outputs;
+	_get_output_files(dir, p_base_path, &outputs);
+	if (outputs.is_empty()) {
+		return;
+	}
+
+	// Entries are written to a private directory first and renamed into place,
+	// so other editors sharing the cache never see a partial entry.
+	const String entry_dir = _get_entry_dir(p_key);
+	const String tmp_dir = get_cache_path().path_join("tmp").path_join(p_key + "-" + itos(OS::get_singleton()->get_process_id()) + "-" + itos(Thread::get_caller_id()));
+	if (DirAccess::make_dir_recursive_absolute(tmp_dir) != OK) {
+		return;
+	}
+
+	Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	const String prefix = p_base_path.get_file() + ".";
+	PackedStringArray files;
+	bool ok = true;
+	for (const String &output : outputs) {
+		const String suffix = output.substr(prefix.length());
+		if (da->copy(dir.path_join(output), tmp_dir.path_join(suffix)) != OK) {
+			ok = false;
+			break;
+		}
+		files.push_back(suffix);
+	}
+
+	if (ok) {
+		PackedStringArray variants;
+		for (const String &variant : p_import_variants) {
+			variants.push_back(variant);
+		}
+
+		Ref<ConfigFile> manifest;
+		manifest.instantiate();
+		manifest->set_value("entry", "files", files);
+		manifest->set_value("entry", "variants", variants);
+		manifest->set_value("entry", "metadata", p_metadata);
+		ok = manifest->save(tmp_dir.path_join("manifest.cfg")) == OK;
+	}
+
+	if (ok && DirAccess::make_dir_recursive_absolute(entry_dir.get_base_dir()) == OK) {
+		// An explicit reimport replaces the existing entry.
+		const String replaced_dir = tmp_dir + "-replaced";
+		const bool replacing = DirAccess::dir_exists_absolute(entry_dir) && DirAccess::rename_absolute(entry_dir, replaced_dir) == OK;
+		if (DirAccess::rename_absolute(tmp_dir, entry_dir) == OK) {
+			stores.increment();
+		}
+		if (replacing) {
+			_remove_dir(replaced_dir);
+		}
+	}
+
+	// Left over if something failed, or if another editor stored the same entry first.
+	if (DirAccess::dir_exists_absolute(tmp_dir)) {
+		_remove_dir(tmp_dir);
+	}
+}
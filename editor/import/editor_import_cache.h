@@ -0,0 +1,76 @@
+/**************************************************************************/
+/*  editor_import_cache.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef EDITOR_IMPORT_CACHE_H
+#define EDITOR_IMPORT_CACHE_H
+
+#include "core/io/resource_importer.h"
+#include "core/templates/safe_refcount.h"
+
+// Content-addressed store of import results, shared between projects through
+// a local directory (see the `filesystem/import/shared_cache_path` editor setting).
+// Entries are keyed by the source contents, importer name, importer version and
+// import options, including the contents of the files the options refer to.
+class EditorImportCache {
+	static SafeNumeric<uint64_t> hits;
+	static SafeNumeric<uint64_t> misses;
+	static SafeNumeric<uint64_t> stores;
+
+	static bool _is_cacheable(const String &p_source_file, const Ref<ResourceImporter> &p_importer, const HashMap<StringName, Variant> &p_params);
+	static bool _has_save_to_file(const Variant &p_value);
+	static void _add_referenced_files(const Variant &p_value, String &r_key_text);
+	static String _get_entry_dir(const String &p_key);
+	static String _get_previous_outputs_dir(const String &p_base_path);
+	static void _get_output_files(const String &p_dir, const String &p_base_path, List<String> *r_files);
+	static void _remove_dir(const String &p_dir);
+	static void _store(const String &p_key, const String &p_base_path, const List<String> &p_import_variants, const Variant &p_metadata);
+
+public:
+	static String get_cache_path();
+
+	// Returns an empty key when the cache is disabled or the import can't be cached.
+	static String make_key(const String &p_source_file, const Ref<ResourceImporter> &p_importer, const HashMap<StringName, Variant> &p_params, const Variant &p_generator_parameters);
+
+	static bool restore(const String &p_key, const String &p_base_path, List<String> *r_import_variants, Variant *r_metadata);
+
+	// Moves the outputs of a previous import out of the way, so that only the files
+	// written by the next import are stored. Returns false if they can't be told apart.
+	static bool begin_import(const String &p_key, const String &p_base_path);
+	// Stores the outputs of a successful import if `p_store` is true (replacing any
+	// existing entry), then drops the previous outputs, or puts back the ones that a
+	// failed import didn't replace.
+	static void end_import(const String &p_key, const String &p_base_path, bool p_succeeded, bool p_store, const List<String> &p_import_variants, const Variant &p_metadata);
+
+	static uint64_t get_hit_count() { return hits.get(); }
+	static uint64_t get_miss_count() { return misses.get(); }
+	static uint64_t get_store_count() { return stores.get(); }
+};
+
+#endif // EDITOR_IMPORT_CACHE_H
@@ -46,6 +46,8 @@
 #include "core/io/ip.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
+#include "core/os/frame_arena.h"
+#include "core/os/heap_profiler.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
 #include "core/register_core_types.h"
@@ -188,6 +190,7 @@ static bool project_manager = false;
 static bool cmdline_tool = false;
 static String locale;
 static String log_file;
+static String heap_profile_file;
 static bool show_help = false;
 static uint64_t quit_after = 0;
 static OS::ProcessID editor_pid = 0;
@@ -598,6 +601,7 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("-d, --debug", "Debug (local stdout debugger).\n");
 	print_help_option("-b, --breakpoints", "Breakpoint list as source::line comma-separated pairs, no spaces (use %%20 instead).\n");
 	print_help_option("--profiling", "Enable profiling in the script debugger.\n");
+	print_help_option("--heap-profile <file>", "Sample heap allocations from startup and write per-tag statistics and the top allocation sites to <file> when the engine quits.\n");
 	print_help_option("--gpu-profile", "Show a GPU profile of the tasks that took the most time during frame rendering.\n");
 	print_help_option("--gpu-validation", "Enable graphics API validation layers for debugging.\n");
 #ifdef DEBUG_ENABLED
@@ -1326,6 +1330,17 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 
 			use_debug_profiler = true;
 
+		} else if (arg == "--heap-profile") { // sample heap allocations and dump them on exit
+
+			if (N) {
+				heap_profile_file = N->get();
+				HeapProfiler::start();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <file> argument for --heap-profile <file>.\n");
+				goto error;
+			}
+
 		} else if (arg == "-l" || arg == "--language") { // language
 
 			if (N) {
@@ -1859,6 +1874,12 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	}
 #endif
 
+	GLOBAL_DEF_RST("filesystem/file_access/memory_mapped_reads", false);
+	// The editor rewrites files it may still have open, so mappings are only used by running projects.
+	if (!editor && !project_manager) {
+		FileAccess::set_mapped_reads_enabled(GLOBAL_GET("filesystem/file_access/memory_mapped_reads"));
+	}
+
 	GLOBAL_DEF("debug/file_logging/enable_file_logging", false);
 	// Only file logging by default on desktop platforms as logs can't be
 	// accessed easily on mobile/Web platforms (if at all).
@@ -3209,6 +3230,9 @@ Error Main::setup2() {
 
 	print_verbose("CORE API HASH: " + uitos(ClassDB::get_api_hash(ClassDB::API_CORE)));
 	print_verbose("EDITOR API HASH: " + uitos(ClassDB::get_api_hash(ClassDB::API_EDITOR)));
+
+	// Registration is done, so reflection lookups can skip the ClassDB lock from now on.
+	ClassDB::freeze();
 	MAIN_PRINT("Main: Done");
 
 	OS::get_singleton()->benchmark_end_measure("Startup", "Setup");
@@ -4033,6 +4057,8 @@ bool Main::iteration() {
 	NavigationServer3D::get_singleton()->sync();
 
 	for (int iters = 0; iters < advance.physics_steps; ++iters) {
+		HEAP_PROFILE_TAG("Physics");
+
 		if (Input::get_singleton()->is_using_input_buffering() && agile_input_event_flushing) {
 			Input::get_singleton()->flush_buffered_events();
 		}
@@ -4096,10 +4122,14 @@ bool Main::iteration() {
 
 	uint64_t process_begin = OS::get_singleton()->get_ticks_usec();
 
-	if (OS::get_singleton()->get_main_loop()->process(process_step * time_scale)) {
-		exit = true;
+	{
+		HEAP_PROFILE_TAG("Process");
+
+		if (OS::get_singleton()->get_main_loop()->process(process_step * time_scale)) {
+			exit = true;
+		}
+		message_queue->flush();
 	}
-	message_queue->flush();
 
 	RenderingServer::get_singleton()->sync(); //sync if still drawing from previous frames.
 
@@ -4133,6 +4163,7 @@ bool Main::iteration() {
 
 	frames++;
 	Engine::get_singleton()->_process_frames++;
+	FrameArena::end_frame();
 
 	if (frame > 1000000) {
 		// Wait a few seconds before printing FPS, as FPS reporting just after the engine has started is inaccurate.
@@ -4223,6 +4254,15 @@ void Main::cleanup(bool p_force) {
 		ERR_FAIL_COND(!_start_success);
 	}
 
+	if (!heap_profile_file.is_empty()) {
+		// Dump the steady state, not what is left once everything has been torn down.
+		HeapProfiler::stop();
+		if (HeapProfiler::dump(heap_profile_file) == OK) {
+			print_line(vformat("Heap profile written to \"%s\".", heap_profile_file));
+		}
+		heap_profile_file = String();
+	}
+
 #ifdef DEBUG_ENABLED
 	if (input) {
 		input->flush_frame_parsed_events();
@@ -30,10 +30,13 @@
 
 #include "performance.h"
 
+#include "core/io/resource_streamer.h"
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
+#include "scene/resources/packed_scene.h"
 #include "servers/audio_server.h"
 #include "servers/navigation_server_3d.h"
 #include "servers/rendering_server.h"
@@ -91,6 +94,12 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA_ALLOCATIONS);
+	BIND_ENUM_CONSTANT(OBJECT_SCENE_POOL_HIT_RATE);
+	BIND_ENUM_CONSTANT(OBJECT_SCENE_POOLED_INSTANCES);
+	BIND_ENUM_CONSTANT(RESOURCE_STREAMING_QUEUE_DEPTH);
+	BIND_ENUM_CONSTANT(RESOURCE_STREAMING_LATENCY);
+	BIND_ENUM_CONSTANT(RESOURCE_STREAMING_MEMORY_IN_FLIGHT);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -141,6 +150,12 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation/edges_merged"),
 		PNAME("navigation/edges_connected"),
 		PNAME("navigation/edges_free"),
+		PNAME("memory/frame_arena_allocations"),
+		PNAME("object/scene_pool_hit_rate"),
+		PNAME("object/scene_pooled_instances"),
+		PNAME("resource/streaming_queue_depth"),
+		PNAME("resource/streaming_latency"),
+		PNAME("resource/streaming_memory_in_flight"),
 
 	};
 
@@ -225,6 +240,21 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case MEMORY_FRAME_ARENA_ALLOCATIONS:
+			return FrameArena::get_last_frame_allocation_count();
+		case OBJECT_SCENE_POOL_HIT_RATE: {
+			uint64_t hits = PackedScene::get_total_pool_hit_count();
+			uint64_t requests = hits + PackedScene::get_total_pool_miss_count();
+			return requests ? double(hits) / double(requests) : 0.0;
+		}
+		case OBJECT_SCENE_POOLED_INSTANCES:
+			return PackedScene::get_total_pooled_instance_count();
+		case RESOURCE_STREAMING_QUEUE_DEPTH:
+			return ResourceStreamer::get_queue_depth();
+		case RESOURCE_STREAMING_LATENCY:
+			return ResourceStreamer::get_average_latency();
+		case RESOURCE_STREAMING_MEMORY_IN_FLIGHT:
+			return ResourceStreamer::get_size_in_flight();
 
 		default: {
 		}
@@ -272,6 +302,12 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_MEMORY,
 
 	};
 
@@ -100,6 +100,12 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		MEMORY_FRAME_ARENA_ALLOCATIONS,
+		OBJECT_SCENE_POOL_HIT_RATE,
+		OBJECT_SCENE_POOLED_INSTANCES,
+		RESOURCE_STREAMING_QUEUE_DEPTH,
+		RESOURCE_STREAMING_LATENCY,
+		RESOURCE_STREAMING_MEMORY_IN_FLIGHT,
 		MONITOR_MAX
 	};
 
@@ -794,6 +794,9 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+	// The set of methods and members is about to change.
+	ObjectInlineCache::invalidate_all();
+
 	valid = false;
 	GDScriptParser parser;
 	Error err;
@@ -833,6 +836,7 @@ Error GDScript::reload(bool p_keep_state) {
 
 	GDScriptCompiler compiler;
 	err = compiler.compile(&parser, this, p_keep_state);
+	ObjectInlineCache::invalidate_all();
 
 	if (err) {
 		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), compiler.get_error_line(), ("Compile Error: " + compiler.get_error()).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
@@ -1533,6 +1537,9 @@ void GDScript::clear(ClearData *p_clear_data) {
 	}
 	clearing = true;
 
+	// Inline caches may be keyed on this script, whose address could be reused.
+	ObjectInlineCache::invalidate_all();
+
 	ClearData data;
 	ClearData *clear_data = p_clear_data;
 	bool is_root = false;
@@ -2063,6 +2070,49 @@ Variant GDScriptInstance::callp(const StringName &p_method, const Variant **p_ar
 	return Variant();
 }
 
+bool GDScriptInstance::defers_to_native(const StringName &p_name, ObjectInlineCache::Access p_access) const {
+	if (unlikely(!script->valid)) {
+		return true; // Nothing is handled by invalid scripts.
+	}
+
+	switch (p_access) {
+		case ObjectInlineCache::ACCESS_CALL: {
+			if (p_name == SceneStringName(_ready)) {
+				return false; // Runs the implicit initializers first, see callp().
+			}
+			for (const GDScript *sptr = script.ptr(); sptr; sptr = sptr->_base) {
+				if (sptr->member_functions.has(p_name)) {
+					return false;
+				}
+			}
+		} break;
+		case ObjectInlineCache::ACCESS_GET: {
+			if (script->member_indices.has(p_name)) {
+				return false;
+			}
+			const StringName &get_name = GDScriptLanguage::get_singleton()->strings._get;
+			for (const GDScript *sptr = script.ptr(); sptr; sptr = sptr->_base) {
+				if (sptr->constants.has(p_name) || sptr->static_variables_indices.has(p_name) || sptr->_signals.has(p_name) ||
+						sptr->member_functions.has(p_name) || sptr->subclasses.has(p_name) || sptr->member_functions.has(get_name)) {
+					return false;
+				}
+			}
+		} break;
+		case ObjectInlineCache::ACCESS_SET: {
+			if (script->member_indices.has(p_name)) {
+				return false;
+			}
+			const StringName &set_name = GDScriptLanguage::get_singleton()->strings._set;
+			for (const GDScript *sptr = script.ptr(); sptr; sptr = sptr->_base) {
+				if (sptr->static_variables_indices.has(p_name) || sptr->member_functions.has(set_name)) {
+					return false;
+				}
+			}
+		} break;
+	}
+	return true;
+}
+
 void GDScriptInstance::notification(int p_notification, bool p_reversed) {
 	if (unlikely(!script->valid)) {
 		return;
@@ -49,6 +49,7 @@ class GDScriptNativeClass : public RefCounted {
 protected:
 	bool _get(const StringName &p_name, Variant &r_ret) const;
 	static void _bind_methods();
+	virtual bool _has_custom_callp() const override { return true; }
 
 public:
 	_FORCE_INLINE_ const StringName &get_name() const { return name; }
@@ -388,6 +389,7 @@ public:
 	virtual int get_method_argument_count(const StringName &p_method, bool *r_is_valid = nullptr) const;
 
 	virtual Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	virtual bool defers_to_native(const StringName &p_name, ObjectInlineCache::Access p_access) const;
 
 	Variant debug_get_member_by_index(int p_idx) const { return members[p_idx]; }
 
@@ -33,6 +33,7 @@
 
 #include "gdscript_utility_functions.h"
 
+#include "core/object/object_inline_cache.h"
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
 #include "core/os/thread.h"
@@ -457,6 +458,7 @@ private:
 	int _gds_utilities_count = 0;
 	int _methods_count = 0;
 	int _lambdas_count = 0;
+	int _inline_caches_count = 0;
 
 	int *_code_ptr = nullptr;
 	const int *_default_arg_ptr = nullptr;
@@ -475,6 +477,7 @@ private:
 	const GDScriptUtilityFunctions::FunctionPtr *_gds_utilities_ptr = nullptr;
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
+	ObjectInlineCache *_inline_caches_ptr = nullptr; // One per untyped call, get and set instruction.
 
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
@@ -0,0 +1,36 @@
+class Enemy extends Node:
+	signal died
+	var health := 100
+	var visited := []
+
+class Spawner:
+	var deaths := 0
+
+	func on_died():
+		deaths += 1
+
+func test():
+	var template := Enemy.new()
+	var scene := PackedScene.new()
+	scene.pack(template)
+	template.free()
+
+	var spawner := Spawner.new()
+	var enemy: Enemy = scene.acquire_instance()
+	enemy.died.connect(spawner.on_died)
+	enemy.health = 5
+	enemy.visited.push_back("cave")
+	enemy.died.emit()
+	scene.release_instance(enemy)
+
+	# Script variables and runtime connections are reset like for a new instance.
+	var reused: Enemy = scene.acquire_instance()
+	print(reused == enemy)
+	print(reused.health)
+	print(reused.visited)
+	print(reused.died.is_connected(spawner.on_died))
+
+	reused.died.connect(spawner.on_died)
+	reused.died.emit()
+	print(spawner.deaths)
+	reused.free()
@@ -178,6 +178,9 @@ class JavaClass : public RefCounted {
 	jclass _class;
 #endif
 
+protected:
+	virtual bool _has_custom_callp() const override { return true; }
+
 public:
 	virtual Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) override;
 
@@ -194,6 +197,9 @@ class JavaObject : public RefCounted {
 	jobject instance;
 #endif
 
+protected:
+	virtual bool _has_custom_callp() const override { return true; }
+
 public:
 	virtual Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) override;
 
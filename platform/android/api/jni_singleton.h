@@ -52,6 +52,9 @@ class JNISingleton : public Object {
 	RBMap<StringName, MethodData> method_map;
 #endif
 
+protected:
+	virtual bool _has_custom_callp() const override { return true; }
+
 public:
 	virtual Variant callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) override {
 #ifdef ANDROID_ENABLED
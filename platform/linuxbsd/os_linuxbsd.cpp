@@ -32,6 +32,8 @@
 
 #include "core/io/certs_compressed.gen.h"
 #include "core/io/dir_access.h"
+#include "core/os/heap_profiler.h"
+#include "drivers/unix/file_access_unix_mmap.h"
 #include "main/main.h"
 #include "servers/display_server.h"
 #include "servers/rendering_server.h"
@@ -66,6 +68,37 @@
 #include <sys/sysctl.h>
 #endif
 
+#ifdef CRASH_HANDLER_ENABLED
+#include <cxxabi.h>
+#include <execinfo.h>
+
+static int _heap_profiler_backtrace(void **r_frames, int p_max_frames) {
+	return backtrace(r_frames, p_max_frames);
+}
+
+static void _heap_profiler_symbolize(void *p_address, char *r_buffer, int p_buffer_size) {
+	Dl_info info;
+	if (!dladdr(p_address, &info) || !info.dli_fname) {
+		snprintf(r_buffer, p_buffer_size, "%p", p_address);
+		return;
+	}
+
+	const char *module = strrchr(info.dli_fname, '/') ? strrchr(info.dli_fname, '/') + 1 : info.dli_fname;
+	if (!info.dli_sname) {
+		// Offset into the module, can be resolved with addr2line.
+		snprintf(r_buffer, p_buffer_size, "%s+%p", module, (void *)((uintptr_t)p_address - (uintptr_t)info.dli_fbase));
+		return;
+	}
+
+	int status = 0;
+	char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+	snprintf(r_buffer, p_buffer_size, "%s+%p (%s)", (status == 0 && demangled) ? demangled : info.dli_sname, (void *)((uintptr_t)p_address - (uintptr_t)info.dli_saddr), module);
+	if (demangled) {
+		free(demangled);
+	}
+}
+#endif // CRASH_HANDLER_ENABLED
+
 void OS_LinuxBSD::alert(const String &p_alert, const String &p_title) {
 	const char *message_programs[] = { "zenity", "kdialog", "Xdialog", "xmessage" };
 
@@ -135,8 +168,17 @@ void OS_LinuxBSD::alert(const String &p_alert, const String &p_title) {
 void OS_LinuxBSD::initialize() {
 	crash_handler.initialize();
 
+#ifdef CRASH_HANDLER_ENABLED
+	HeapProfiler::set_backtrace_func(_heap_profiler_backtrace);
+	HeapProfiler::set_symbolize_func(_heap_profiler_symbolize);
+#endif
+
 	OS_Unix::initialize_core();
 
+	FileAccess::make_mapped_default<FileAccessUnixMMap>(FileAccess::ACCESS_RESOURCES);
+	FileAccess::make_mapped_default<FileAccessUnixMMap>(FileAccess::ACCESS_USERDATA);
+	FileAccess::make_mapped_default<FileAccessUnixMMap>(FileAccess::ACCESS_FILESYSTEM);
+
 	system_dir_desktop_cache = get_system_dir(SYSTEM_DIR_DESKTOP);
 }
 
@@ -38,6 +38,7 @@
 
 #include "core/crypto/crypto_core.h"
 #include "core/version_generated.gen.h"
+#include "drivers/unix/file_access_unix_mmap.h"
 #include "main/main.h"
 
 #include <dlfcn.h>
@@ -109,6 +110,10 @@ void OS_MacOS::revoke_granted_permissions() {
 void OS_MacOS::initialize_core() {
 	OS_Unix::initialize_core();
 
+	FileAccess::make_mapped_default<FileAccessUnixMMap>(FileAccess::ACCESS_RESOURCES);
+	FileAccess::make_mapped_default<FileAccessUnixMMap>(FileAccess::ACCESS_USERDATA);
+	FileAccess::make_mapped_default<FileAccessUnixMMap>(FileAccess::ACCESS_FILESYSTEM);
+
 	DirAccess::make_default<DirAccessMacOS>(DirAccess::ACCESS_RESOURCES);
 	DirAccess::make_default<DirAccessMacOS>(DirAccess::ACCESS_USERDATA);
 	DirAccess::make_default<DirAccessMacOS>(DirAccess::ACCESS_FILESYSTEM);
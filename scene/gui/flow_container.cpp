@@ -30,6 +30,7 @@
 
 #include "flow_container.h"
 
+#include "core/os/frame_arena.h"
 #include "scene/theme/theme_db.h"
 
 struct _LineData {
@@ -49,7 +50,7 @@ void FlowContainer::_resort() {
 
 	bool rtl = is_layout_rtl();
 
-	HashMap<Control *, Size2i> children_minsize_cache;
+	FrameHashMap<Control *, Size2i> children_minsize_cache;
 
 	Vector<_LineData> lines_data;
 
@@ -3681,6 +3681,8 @@ void Node::_bind_methods() {
 	BIND_CONSTANT(NOTIFICATION_DISABLED);
 	BIND_CONSTANT(NOTIFICATION_ENABLED);
 	BIND_CONSTANT(NOTIFICATION_RESET_PHYSICS_INTERPOLATION);
+	BIND_CONSTANT(NOTIFICATION_SCENE_POOL_PARKED);
+	BIND_CONSTANT(NOTIFICATION_SCENE_POOL_REUSED);
 
 	BIND_CONSTANT(NOTIFICATION_EDITOR_PRE_SAVE);
 	BIND_CONSTANT(NOTIFICATION_EDITOR_POST_SAVE);
@@ -3890,6 +3892,11 @@ Error Node::emit_signalp(const StringName &p_name, const Variant **p_args, int p
 	return Object::emit_signalp(p_name, p_args, p_argcount);
 }
 
+Error Node::emit_signalp(const SignalID &p_signal, const Variant **p_args, int p_argcount) {
+	ERR_THREAD_GUARD_V(ERR_INVALID_PARAMETER);
+	return Object::emit_signalp(p_signal, p_args, p_argcount);
+}
+
 bool Node::has_signal(const StringName &p_name) const {
 	ERR_THREAD_GUARD_V(false);
 	return Object::has_signal(p_name);
@@ -384,6 +384,8 @@ public:
 		NOTIFICATION_DISABLED = 28,
 		NOTIFICATION_ENABLED = 29,
 		NOTIFICATION_RESET_PHYSICS_INTERPOLATION = 2001, // A GodotSpace Odyssey.
+		NOTIFICATION_SCENE_POOL_PARKED = 2002,
+		NOTIFICATION_SCENE_POOL_REUSED = 2003,
 		// Keep these linked to Node.
 		NOTIFICATION_WM_MOUSE_ENTER = 1002,
 		NOTIFICATION_WM_MOUSE_EXIT = 1003,
@@ -754,6 +756,7 @@ public:
 	virtual void get_meta_list(List<StringName> *p_list) const override;
 
 	virtual Error emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) override;
+	virtual Error emit_signalp(const SignalID &p_signal, const Variant **p_args, int p_argcount) override;
 	virtual bool has_signal(const StringName &p_name) const override;
 	virtual void get_signal_list(List<MethodInfo> *p_signals) const override;
 	virtual void get_signal_connection_list(const StringName &p_signal, List<Connection> *p_connections) const override;
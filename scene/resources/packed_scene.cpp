@@ -34,6 +34,7 @@
 #include "core/config/project_settings.h"
 #include "core/io/missing_resource.h"
 #include "core/io/resource_loader.h"
+#include "core/object/object_inline_cache.h"
 #include "core/templates/local_vector.h"
 #include "scene/2d/node_2d.h"
 #ifndef _3D_DISABLED
@@ -50,6 +51,30 @@
 SceneState::InstantiationWarningNotify SceneState::instantiation_warn_notify = nullptr;
 #endif
 
+struct SceneState::InstantiationPlan {
+	struct Property {
+		ObjectInlineCache cache;
+		// Plain values that can go straight to the cached setter, skipping
+		// the local-to-scene resource and typed container handling.
+		bool direct = false;
+	};
+
+	SafeRefCount refcount;
+	uint32_t generation = 0;
+	// Native constructor per node, or nullptr if the node is not created by
+	// this scene or needs the generic ClassDB::instantiate() path.
+	LocalVector<Object *(*)()> creation_funcs;
+	// Index of each node's first property in properties.
+	LocalVector<uint32_t> property_offsets;
+	Property *properties = nullptr;
+
+	~InstantiationPlan() {
+		if (properties) {
+			memdelete_arr(properties);
+		}
+	}
+};
+
 bool SceneState::can_instantiate() const {
 	return nodes.size() > 0;
 }
@@ -165,6 +190,17 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 	LocalVector<DeferredNodePathProperties> deferred_node_paths;
 
+	InstantiationPlan *plan = nullptr;
+	if (use_instantiation_plans && p_edit_state == GEN_EDIT_STATE_DISABLED) {
+		plan = _acquire_instantiation_plan();
+	}
+	// Released on every return path, including the error ones.
+	struct PlanReleaser {
+		InstantiationPlan *plan = nullptr;
+		~PlanReleaser() { _release_instantiation_plan(plan); }
+	} plan_releaser;
+	plan_releaser.plan = plan;
+
 	for (int i = 0; i < nc; i++) {
 		const NodeData &n = nd[i];
 
@@ -257,7 +293,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			}
 		} else {
 			// Node belongs to this scene and must be created.
-			Object *obj = ClassDB::instantiate(snames[n.type]);
+			Object *obj = (plan && plan->creation_funcs[i]) ? plan->creation_funcs[i]() : ClassDB::instantiate(snames[n.type]);
 
 			node = Object::cast_to<Node>(obj);
 
@@ -304,6 +340,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			int nprop_count = n.properties.size();
 			if (nprop_count) {
 				const NodeData::Property *nprops = &n.properties[0];
+				InstantiationPlan::Property *plan_props = plan ? &plan->properties[plan->property_offsets[i]] : nullptr;
 
 				Dictionary missing_resource_properties;
 				HashMap<Ref<Resource>, Ref<Resource>> resources_local_to_sub_scene; // Record the mappings in the sub-scene.
@@ -313,6 +350,11 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 					ERR_FAIL_INDEX_V(nprops[j].value, prop_count, nullptr);
 
+					if (plan_props && plan_props[j].direct) {
+						node->set_cached(plan_props[j].cache, snames[nprops[j].name], props[nprops[j].value], &valid);
+						continue;
+					}
+
 					if (nprops[j].name & FLAG_PATH_PROPERTY_IS_NODE) {
 						if (!Engine::get_singleton()->is_editor_hint() && node->get_scene_instance_load_placeholder()) {
 							// We cannot know if the referenced nodes exist yet, so instead of deferring, we write the NodePaths directly.
@@ -607,6 +649,239 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+bool SceneState::_get_instance_nodes(Node *p_root, LocalVector<Node *> &r_nodes) const {
+	ERR_FAIL_NULL_V(p_root, false);
+
+	// Only scenes whose nodes are all created by this state can be restored,
+	// sub-scene instances and inherited scenes carry state from other scenes.
+	if (base_scene_idx >= 0 || nodes.is_empty()) {
+		return false;
+	}
+
+	const int nc = nodes.size();
+	r_nodes.resize(nc);
+	int child_count = 0;
+
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nodes[i];
+		if (n.instance >= 0 || n.type == TYPE_INSTANTIATED || n.type < 0 || n.type >= names.size() || n.name < 0 || n.name >= names.size()) {
+			return false;
+		}
+
+		Node *node = p_root;
+		if (i > 0) {
+			if ((n.parent & FLAG_ID_IS_PATH) || (n.parent & FLAG_MASK) >= i) {
+				return false;
+			}
+			node = r_nodes[n.parent & FLAG_MASK]->_get_child_by_name(names[n.name]);
+			if (!node) {
+				return false;
+			}
+		}
+		if (node->get_class_name() != names[n.type] || node->is_queued_for_deletion()) {
+			return false;
+		}
+		for (int group : n.groups) {
+			if (group < 0 || group >= names.size()) {
+				return false;
+			}
+		}
+		for (const NodeData::Property &prop : n.properties) {
+			if ((prop.name & FLAG_PROP_NAME_MASK) >= names.size() || prop.value < 0 || prop.value >= variants.size()) {
+				return false;
+			}
+		}
+
+		r_nodes[i] = node;
+		child_count += node->get_child_count(false);
+	}
+
+	return child_count == nc - 1; // Otherwise nodes were added or removed.
+}
+
+static Variant _duplicate_script_variable(const Variant &p_value) {
+	// Containers are shared by reference, so the baseline needs its own copy.
+	switch (p_value.get_type()) {
+		case Variant::ARRAY:
+			return Array(p_value).duplicate(true);
+		case Variant::DICTIONARY:
+			return Dictionary(p_value).duplicate(true);
+		default:
+			return p_value;
+	}
+}
+
+static void _get_non_persistent_connections(Node *p_node, List<Object::Connection> *r_connections) {
+	List<Object::Connection> connections;
+	p_node->get_all_signal_connections(&connections);
+	p_node->get_signals_connected_to_this(&connections);
+	for (const Object::Connection &c : connections) {
+		if (!(c.flags & Object::CONNECT_PERSIST)) {
+			r_connections->push_back(c);
+		}
+	}
+}
+
+bool SceneState::capture_instance_baseline(Node *p_root, InstanceBaseline &r_baseline) const {
+	LocalVector<Node *> ret_nodes;
+	if (!_get_instance_nodes(p_root, ret_nodes)) {
+		return false;
+	}
+
+	r_baseline.nodes.resize(ret_nodes.size());
+	for (uint32_t i = 0; i < ret_nodes.size(); i++) {
+		Node *node = ret_nodes[i];
+		InstanceBaseline::NodeBaseline &nb = r_baseline.nodes[i];
+		nb.script = node->get_script();
+		nb.script_variables.clear();
+		nb.connections.clear();
+
+		ScriptInstance *si = node->get_script_instance();
+		if (si) {
+			List<PropertyInfo> plist;
+			si->get_property_list(&plist);
+			for (const PropertyInfo &E : plist) {
+				Variant value;
+				if ((E.usage & PROPERTY_USAGE_SCRIPT_VARIABLE) && si->get(E.name, value)) {
+					nb.script_variables.push_back(Pair<StringName, Variant>(E.name, _duplicate_script_variable(value)));
+				}
+			}
+		}
+
+		List<Object::Connection> connections;
+		_get_non_persistent_connections(node, &connections);
+		for (const Object::Connection &c : connections) {
+			nb.connections.push_back(c);
+		}
+	}
+	return true;
+}
+
+bool SceneState::reset_instance(Node *p_root, const InstanceBaseline &p_baseline) const {
+	// First make sure the instance still has the packed structure, so it is
+	// either fully reset or left alone.
+	LocalVector<Node *> ret_nodes;
+	if (!_get_instance_nodes(p_root, ret_nodes) || ret_nodes.size() != p_baseline.nodes.size()) {
+		return false;
+	}
+	for (uint32_t i = 0; i < ret_nodes.size(); i++) {
+		if (ret_nodes[i]->get_script() != p_baseline.nodes[i].script) {
+			return false; // A replaced script cannot be reset.
+		}
+	}
+
+	const int nc = nodes.size();
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nodes[i];
+		Node *node = ret_nodes[i];
+
+		HashMap<StringName, int> packed_values;
+		for (const NodeData::Property &prop : n.properties) {
+			packed_values[names[prop.name & FLAG_PROP_NAME_MASK]] = prop.name & FLAG_PATH_PROPERTY_IS_NODE ? -1 - prop.value : prop.value;
+		}
+
+		List<PropertyInfo> plist;
+		node->get_property_list(&plist);
+		for (const PropertyInfo &E : plist) {
+			// Script variables are restored from the baseline below.
+			if (!(E.usage & PROPERTY_USAGE_STORAGE) || (E.usage & PROPERTY_USAGE_SCRIPT_VARIABLE) || E.name == CoreStringName(script)) {
+				continue;
+			}
+
+			Variant value;
+			const int *packed = packed_values.getptr(E.name);
+			if (packed && *packed < 0) {
+				// Node references are stored as paths relative to the node.
+				const Variant &paths = variants[-1 - *packed];
+				if (paths.get_type() == Variant::ARRAY) {
+					Array nodes_array;
+					Array path_array = paths;
+					for (int j = 0; j < path_array.size(); j++) {
+						nodes_array.push_back(node->get_node_or_null(path_array[j]));
+					}
+					value = nodes_array;
+				} else {
+					value = node->get_node_or_null(paths);
+				}
+			} else if (packed) {
+				value = variants[*packed];
+				Ref<Resource> res = value;
+				if (res.is_valid() && res->is_local_to_scene()) {
+					continue; // Keep the instance's own copy.
+				}
+			} else if (E.name.begins_with("metadata/")) {
+				node->remove_meta(E.name.substr(9));
+				continue;
+			} else {
+				bool valid = false;
+				value = ClassDB::class_get_default_property_value(node->get_class_name(), E.name, &valid);
+				if (!valid) {
+					continue;
+				}
+			}
+
+			if (!node->get(E.name).hash_compare(value)) {
+				node->set(E.name, value);
+			}
+		}
+
+		for (const Pair<StringName, Variant> &E : p_baseline.nodes[i].script_variables) {
+			if (!node->get(E.first).hash_compare(E.second)) {
+				node->set(E.first, _duplicate_script_variable(E.second));
+			}
+		}
+
+		List<Node::GroupInfo> groups;
+		node->get_groups(&groups);
+		for (const Node::GroupInfo &gi : groups) {
+			if (!gi.persistent) {
+				continue;
+			}
+			bool packed_group = false;
+			for (int group : n.groups) {
+				if (names[group] == gi.name) {
+					packed_group = true;
+					break;
+				}
+			}
+			if (!packed_group) {
+				node->remove_from_group(gi.name);
+			}
+		}
+		for (int group : n.groups) {
+			node->add_to_group(names[group], true);
+		}
+	}
+
+	// Drop the connections made since the instance was created, once the setters
+	// above have settled their own (e.g. to resources that were swapped meanwhile).
+	for (int i = 0; i < nc; i++) {
+		const InstanceBaseline::NodeBaseline &nb = p_baseline.nodes[i];
+		List<Object::Connection> connections;
+		_get_non_persistent_connections(ret_nodes[i], &connections);
+		for (const Object::Connection &c : connections) {
+			bool in_baseline = false;
+			for (const Object::Connection &b : nb.connections) {
+				if (b.signal == c.signal && b.callable == c.callable) {
+					in_baseline = true;
+					break;
+				}
+			}
+			Object *source = c.signal.get_object();
+			// Connections between two nodes of the instance are listed for both.
+			if (!in_baseline && source && source->is_connected(c.signal.get_name(), c.callable)) {
+				source->disconnect(c.signal.get_name(), c.callable);
+			}
+		}
+	}
+
+	for (int i = 0; i < nc; i++) {
+		ret_nodes[i]->request_ready();
+	}
+
+	return true;
+}
+
 Variant SceneState::make_local_resource(Variant &p_value, const SceneState::NodeData &p_node_data, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_sub_scene, Node *p_node, const StringName p_sname, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_scene, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const {
 	Ref<Resource> res = p_value;
 	if (res.is_null() || !res->is_local_to_scene()) {
@@ -1215,6 +1490,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instantiation_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1270,6 +1546,8 @@ Ref<SceneState> SceneState::get_base_scene_state() const {
 void SceneState::update_instance_resource(String p_path, Ref<PackedScene> p_packed_scene) {
 	ERR_FAIL_COND(p_packed_scene.is_null());
 
+	_clear_instantiation_plan();
+
 	for (const NodeData &nd : nodes) {
 		if (nd.instance >= 0) {
 			if (!(nd.instance & FLAG_INSTANCE_IS_PLACEHOLDER)) {
@@ -1383,6 +1661,86 @@ void SceneState::set_disable_placeholders(bool p_disable) {
 	disable_placeholders = p_disable;
 }
 
+bool SceneState::use_instantiation_plans = true;
+
+void SceneState::set_use_instantiation_plans(bool p_enable) {
+	use_instantiation_plans = p_enable;
+}
+
+SceneState::InstantiationPlan *SceneState::_build_instantiation_plan(uint32_t p_generation) const {
+	InstantiationPlan *plan = memnew(InstantiationPlan);
+	plan->refcount.init();
+	plan->generation = p_generation;
+
+	const int nc = nodes.size();
+	plan->creation_funcs.resize(nc);
+	plan->property_offsets.resize(nc);
+
+	uint32_t property_count = 0;
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nodes[i];
+		plan->property_offsets[i] = property_count;
+		property_count += n.properties.size();
+
+		plan->creation_funcs[i] = nullptr;
+		bool created_here = n.instance < 0 && n.type != TYPE_INSTANTIATED && !(i == 0 && base_scene_idx >= 0);
+		if (created_here && n.type >= 0 && n.type < names.size() && ClassDB::is_parent_class(names[n.type], SNAME("Node"))) {
+			plan->creation_funcs[i] = ClassDB::get_creation_func(names[n.type]);
+		}
+	}
+
+	if (property_count == 0) {
+		return plan;
+	}
+	plan->properties = memnew_arr(InstantiationPlan::Property, property_count);
+
+	for (int i = 0; i < nc; i++) {
+		if (i == 0 && base_scene_idx >= 0) {
+			continue; // Values set on an inherited root are duplicated first.
+		}
+		const NodeData &n = nodes[i];
+		InstantiationPlan::Property *plan_props = &plan->properties[plan->property_offsets[i]];
+		for (int j = 0; j < n.properties.size(); j++) {
+			const NodeData::Property &prop = n.properties[j];
+			if ((prop.name & FLAG_PATH_PROPERTY_IS_NODE) || prop.name < 0 || prop.name >= names.size() || prop.value < 0 || prop.value >= variants.size()) {
+				continue;
+			}
+			if (names[prop.name] == CoreStringName(script)) {
+				continue;
+			}
+			Variant::Type type = variants[prop.value].get_type();
+			plan_props[j].direct = type != Variant::OBJECT && type != Variant::ARRAY && type != Variant::DICTIONARY;
+		}
+	}
+
+	return plan;
+}
+
+SceneState::InstantiationPlan *SceneState::_acquire_instantiation_plan() const {
+	// Read before building, so a plan resolved against stale class data is rebuilt next time.
+	uint32_t generation = ObjectInlineCache::get_generation();
+
+	MutexLock lock(instantiation_plan_mutex);
+	if (!instantiation_plan || instantiation_plan->generation != generation) {
+		_release_instantiation_plan(instantiation_plan);
+		instantiation_plan = _build_instantiation_plan(generation);
+	}
+	instantiation_plan->refcount.ref();
+	return instantiation_plan;
+}
+
+void SceneState::_release_instantiation_plan(InstantiationPlan *p_plan) {
+	if (p_plan && p_plan->refcount.unref()) {
+		memdelete(p_plan);
+	}
+}
+
+void SceneState::_clear_instantiation_plan() {
+	MutexLock lock(instantiation_plan_mutex);
+	_release_instantiation_plan(instantiation_plan);
+	instantiation_plan = nullptr;
+}
+
 bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_node, const StringName &p_to_method) const {
 	ERR_FAIL_COND_V(p_node < 0, false);
 	ERR_FAIL_COND_V(p_to_node < 0, false);
@@ -1417,6 +1775,8 @@ bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_
 }
 
 void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
+	_clear_instantiation_plan();
+
 	ERR_FAIL_COND(!p_dictionary.has("names"));
 	ERR_FAIL_COND(!p_dictionary.has("variants"));
 	ERR_FAIL_COND(!p_dictionary.has("node_count"));
@@ -1906,6 +2266,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.instance = p_instance;
 	nd.index = p_index;
 
+	_clear_instantiation_plan();
 	nodes.push_back(nd);
 
 	return nodes.size() - 1;
@@ -1922,6 +2283,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 		prop.name |= FLAG_PATH_PROPERTY_IS_NODE;
 	}
 	prop.value = p_value;
+	_clear_instantiation_plan();
 	nodes.write[p_node].properties.push_back(prop);
 }
 
@@ -1933,6 +2295,7 @@ void SceneState::add_node_group(int p_node, int p_group) {
 
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
+	_clear_instantiation_plan();
 	base_scene_idx = p_idx;
 }
 
@@ -2041,9 +2404,14 @@ void SceneState::_bind_methods() {
 SceneState::SceneState() {
 }
 
+SceneState::~SceneState() {
+	_release_instantiation_plan(instantiation_plan);
+}
+
 ////////////////
 
 void PackedScene::_set_bundled_scene(const Dictionary &p_scene) {
+	clear_pool();
 	state->set_bundled_scene(p_scene);
 }
 
@@ -2052,10 +2420,12 @@ Dictionary PackedScene::_get_bundled_scene() const {
 }
 
 Error PackedScene::pack(Node *p_scene) {
+	clear_pool();
 	return state->pack(p_scene);
 }
 
 void PackedScene::clear() {
+	clear_pool();
 	state->clear();
 }
 
@@ -2108,7 +2478,189 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 	return s;
 }
 
+SafeNumeric<uint64_t> PackedScene::total_pool_hits;
+SafeNumeric<uint64_t> PackedScene::total_pool_misses;
+SafeNumeric<uint32_t> PackedScene::total_pooled_instances;
+
+Node *PackedScene::acquire_instance() {
+	Node *node = nullptr;
+	uint64_t version;
+	{
+		MutexLock lock(pool_mutex);
+		if (!pool.is_empty()) {
+			node = pool[pool.size() - 1];
+			pool.resize(pool.size() - 1);
+			total_pooled_instances.decrement();
+			pool_hits++;
+		} else {
+			pool_misses++;
+		}
+		version = pool_version;
+	}
+
+	if (node) {
+		total_pool_hits.increment();
+		node->propagate_notification(Node::NOTIFICATION_SCENE_POOL_REUSED);
+		return node;
+	}
+
+	total_pool_misses.increment();
+	node = instantiate();
+	if (!node) {
+		return nullptr;
+	}
+
+	SceneState::InstanceBaseline *baseline = memnew(SceneState::InstanceBaseline);
+	if (!state->capture_instance_baseline(node, *baseline)) {
+		memdelete(baseline); // Can't be reset, so it won't be pooled.
+		return node;
+	}
+
+	MutexLock lock(pool_mutex);
+	if (version != pool_version) {
+		memdelete(baseline); // The scene changed meanwhile.
+		return node;
+	}
+	if (instance_baselines.size() >= baseline_sweep_size) {
+		LocalVector<ObjectID> freed;
+		for (const KeyValue<ObjectID, SceneState::InstanceBaseline *> &E : instance_baselines) {
+			if (!ObjectDB::get_instance(E.key)) {
+				freed.push_back(E.key);
+			}
+		}
+		for (const ObjectID &id : freed) {
+			memdelete(instance_baselines[id]);
+			instance_baselines.erase(id);
+		}
+		baseline_sweep_size = MAX(64u, instance_baselines.size() * 2);
+	}
+	instance_baselines[node->get_instance_id()] = baseline;
+	return node;
+}
+
+void PackedScene::release_instance(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(p_node->is_queued_for_deletion(), "Cannot release a node queued for deletion.");
+	ERR_FAIL_COND_MSG(!is_built_in() && p_node->get_scene_file_path() != get_path(), vformat("Node '%s' was not instantiated from '%s'.", p_node->get_name(), get_path()));
+
+	Node *parent = p_node->get_parent();
+	if (parent) {
+		parent->remove_child(p_node);
+		ERR_FAIL_COND_MSG(p_node->get_parent(), "Could not remove the node from its parent, use call_deferred() to release it.");
+	}
+
+	p_node->propagate_notification(Node::NOTIFICATION_SCENE_POOL_PARKED);
+
+	// Instances not handed out by acquire_instance() have no baseline to go back to.
+	SceneState::InstanceBaseline *baseline = nullptr;
+	bool has_room;
+	uint64_t version;
+	{
+		MutexLock lock(pool_mutex);
+		HashMap<ObjectID, SceneState::InstanceBaseline *>::Iterator E = instance_baselines.find(p_node->get_instance_id());
+		if (E) {
+			baseline = E->value;
+			instance_baselines.remove(E);
+		}
+		has_room = (int)pool.size() < pool_capacity;
+		version = pool_version;
+	}
+
+	// Resetting can run setters and scripts, so it happens outside the lock.
+	if (!baseline || !has_room || !state->reset_instance(p_node, *baseline)) {
+		if (baseline) {
+			memdelete(baseline);
+		}
+		memdelete(p_node);
+		return;
+	}
+
+	MutexLock lock(pool_mutex);
+	if (version != pool_version || (int)pool.size() >= pool_capacity) {
+		// The scene changed, or the pool filled up from another thread in the meantime.
+		memdelete(baseline);
+		memdelete(p_node);
+		return;
+	}
+	instance_baselines[p_node->get_instance_id()] = baseline;
+	pool.push_back(p_node);
+	total_pooled_instances.increment();
+}
+
+void PackedScene::clear_pool() {
+	LocalVector<Node *> pooled;
+	LocalVector<SceneState::InstanceBaseline *> baselines;
+	{
+		MutexLock lock(pool_mutex);
+		pooled = pool;
+		pool.clear();
+		total_pooled_instances.sub(pooled.size());
+		for (const KeyValue<ObjectID, SceneState::InstanceBaseline *> &E : instance_baselines) {
+			baselines.push_back(E.value);
+		}
+		instance_baselines.clear();
+		baseline_sweep_size = 64;
+		pool_version++;
+	}
+
+	for (Node *node : pooled) {
+		memdelete(node);
+	}
+	for (SceneState::InstanceBaseline *baseline : baselines) {
+		memdelete(baseline);
+	}
+}
+
+void PackedScene::set_pool_capacity(int p_capacity) {
+	ERR_FAIL_COND(p_capacity < 0);
+	LocalVector<Node *> excess;
+	LocalVector<SceneState::InstanceBaseline *> baselines;
+	{
+		MutexLock lock(pool_mutex);
+		pool_capacity = p_capacity;
+		while ((int)pool.size() > pool_capacity) {
+			Node *node = pool[pool.size() - 1];
+			pool.resize(pool.size() - 1);
+			HashMap<ObjectID, SceneState::InstanceBaseline *>::Iterator E = instance_baselines.find(node->get_instance_id());
+			if (E) {
+				baselines.push_back(E->value);
+				instance_baselines.remove(E);
+			}
+			excess.push_back(node);
+		}
+		total_pooled_instances.sub(excess.size());
+	}
+
+	for (Node *node : excess) {
+		memdelete(node);
+	}
+	for (SceneState::InstanceBaseline *baseline : baselines) {
+		memdelete(baseline);
+	}
+}
+
+int PackedScene::get_pool_capacity() const {
+	MutexLock lock(pool_mutex);
+	return pool_capacity;
+}
+
+int PackedScene::get_pooled_instance_count() const {
+	MutexLock lock(pool_mutex);
+	return pool.size();
+}
+
+uint64_t PackedScene::get_pool_hit_count() const {
+	MutexLock lock(pool_mutex);
+	return pool_hits;
+}
+
+uint64_t PackedScene::get_pool_miss_count() const {
+	MutexLock lock(pool_mutex);
+	return pool_misses;
+}
+
 void PackedScene::replace_state(Ref<SceneState> p_by) {
+	clear_pool();
 	state = p_by;
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
@@ -2117,6 +2669,7 @@ void PackedScene::replace_state(Ref<SceneState> p_by) {
 }
 
 void PackedScene::recreate_state() {
+	clear_pool();
 	state = Ref<SceneState>(memnew(SceneState));
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
@@ -2145,11 +2698,20 @@ void PackedScene::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pack", "path"), &PackedScene::pack);
 	ClassDB::bind_method(D_METHOD("instantiate", "edit_state"), &PackedScene::instantiate, DEFVAL(GEN_EDIT_STATE_DISABLED));
 	ClassDB::bind_method(D_METHOD("can_instantiate"), &PackedScene::can_instantiate);
+	ClassDB::bind_method(D_METHOD("acquire_instance"), &PackedScene::acquire_instance);
+	ClassDB::bind_method(D_METHOD("release_instance", "node"), &PackedScene::release_instance);
+	ClassDB::bind_method(D_METHOD("clear_pool"), &PackedScene::clear_pool);
+	ClassDB::bind_method(D_METHOD("set_pool_capacity", "capacity"), &PackedScene::set_pool_capacity);
+	ClassDB::bind_method(D_METHOD("get_pool_capacity"), &PackedScene::get_pool_capacity);
+	ClassDB::bind_method(D_METHOD("get_pooled_instance_count"), &PackedScene::get_pooled_instance_count);
+	ClassDB::bind_method(D_METHOD("get_pool_hit_count"), &PackedScene::get_pool_hit_count);
+	ClassDB::bind_method(D_METHOD("get_pool_miss_count"), &PackedScene::get_pool_miss_count);
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene", "scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
 	ClassDB::bind_method(D_METHOD("get_state"), &PackedScene::get_state);
 
 	ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "_bundled"), "_set_bundled_scene", "_get_bundled_scene");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "pool_capacity", PROPERTY_HINT_RANGE, "0,1024,1,or_greater", PROPERTY_USAGE_NONE), "set_pool_capacity", "get_pool_capacity");
 
 	BIND_ENUM_CONSTANT(GEN_EDIT_STATE_DISABLED);
 	BIND_ENUM_CONSTANT(GEN_EDIT_STATE_INSTANCE);
@@ -2160,3 +2722,7 @@ void PackedScene::_bind_methods() {
 PackedScene::PackedScene() {
 	state = Ref<SceneState>(memnew(SceneState));
 }
+
+PackedScene::~PackedScene() {
+	clear_pool();
+}
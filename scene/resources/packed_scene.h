@@ -32,6 +32,8 @@
 #define PACKED_SCENE_H
 
 #include "core/io/resource.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -98,7 +100,20 @@ class SceneState : public RefCounted {
 
 	static bool disable_placeholders;
 
+	// Precompiled data for GEN_EDIT_STATE_DISABLED instantiation, built on first use and
+	// shared by concurrent instantiate() calls. Dropped when the scene data changes.
+	struct InstantiationPlan;
+	mutable Mutex instantiation_plan_mutex;
+	mutable InstantiationPlan *instantiation_plan = nullptr;
+	static bool use_instantiation_plans;
+
+	InstantiationPlan *_build_instantiation_plan(uint32_t p_generation) const;
+	InstantiationPlan *_acquire_instantiation_plan() const;
+	static void _release_instantiation_plan(InstantiationPlan *p_plan);
+	void _clear_instantiation_plan();
+
 	Vector<String> _get_node_groups(int p_idx) const;
+	bool _get_instance_nodes(Node *p_root, LocalVector<Node *> &r_nodes) const;
 
 	int _find_base_scene_node_remap_key(int p_idx) const;
 
@@ -135,7 +150,20 @@ public:
 		int node = -1;
 	};
 
+	// What a new instance holds beyond its packed values, captured right after
+	// instantiation: the values of its script variables, and the connections that
+	// were made while creating it.
+	struct InstanceBaseline {
+		struct NodeBaseline {
+			Variant script;
+			LocalVector<Pair<StringName, Variant>> script_variables;
+			LocalVector<Object::Connection> connections;
+		};
+		LocalVector<NodeBaseline> nodes;
+	};
+
 	static void set_disable_placeholders(bool p_disable);
+	static void set_use_instantiation_plans(bool p_enable);
 	static Ref<Resource> get_remap_resource(const Ref<Resource> &p_resource, HashMap<Ref<Resource>, Ref<Resource>> &remap_cache, const Ref<Resource> &p_fallback, Node *p_for_scene);
 
 	int find_node_by_path(const NodePath &p_node) const;
@@ -156,6 +184,10 @@ public:
 
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state) const;
+	bool capture_instance_baseline(Node *p_root, InstanceBaseline &r_baseline) const;
+	// Puts an instance (out of the tree) back into the state it was in when its baseline was captured,
+	// so it can be reused. Returns false if the instance no longer matches this scene and cannot be reset.
+	bool reset_instance(Node *p_root, const InstanceBaseline &p_baseline) const;
 
 	Array setup_resources_in_array(Array &array_to_scan, const SceneState::NodeData &n, HashMap<Ref<Resource>, Ref<Resource>> &resources_local_to_sub_scene, Node *node, const StringName sname, HashMap<Ref<Resource>, Ref<Resource>> &resources_local_to_scene, int i, Node **ret_nodes, SceneState::GenEditState p_edit_state) const;
 	Variant make_local_resource(Variant &value, const SceneState::NodeData &p_node_data, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_sub_scene, Node *p_node, const StringName p_sname, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_scene, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const;
@@ -223,6 +255,7 @@ public:
 #endif
 
 	SceneState();
+	~SceneState();
 };
 
 VARIANT_ENUM_CAST(SceneState::GenEditState)
@@ -233,6 +266,21 @@ class PackedScene : public Resource {
 
 	Ref<SceneState> state;
 
+	mutable Mutex pool_mutex;
+	LocalVector<Node *> pool;
+	// Baselines of the instances handed out by acquire_instance(), pooled or not.
+	// Entries of instances freed elsewhere are swept once the map doubles in size.
+	HashMap<ObjectID, SceneState::InstanceBaseline *> instance_baselines;
+	uint32_t baseline_sweep_size = 64;
+	uint64_t pool_version = 0;
+	int pool_capacity = 32;
+	uint64_t pool_hits = 0;
+	uint64_t pool_misses = 0;
+
+	static SafeNumeric<uint64_t> total_pool_hits;
+	static SafeNumeric<uint64_t> total_pool_misses;
+	static SafeNumeric<uint32_t> total_pooled_instances;
+
 	void _set_bundled_scene(const Dictionary &p_scene);
 	Dictionary _get_bundled_scene() const;
 
@@ -256,6 +304,20 @@ public:
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
 
+	Node *acquire_instance();
+	void release_instance(Node *p_node);
+	void clear_pool();
+
+	void set_pool_capacity(int p_capacity);
+	int get_pool_capacity() const;
+	int get_pooled_instance_count() const;
+	uint64_t get_pool_hit_count() const;
+	uint64_t get_pool_miss_count() const;
+
+	static uint64_t get_total_pool_hit_count() { return total_pool_hits.get(); }
+	static uint64_t get_total_pool_miss_count() { return total_pool_misses.get(); }
+	static uint32_t get_total_pooled_instance_count() { return total_pooled_instances.get(); }
+
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
 
@@ -274,6 +336,7 @@ public:
 	Ref<SceneState> get_state() const;
 
 	PackedScene();
+	~PackedScene();
 };
 
 VARIANT_ENUM_CAST(PackedScene::GenEditState)
@@ -102,7 +102,8 @@ void PhysicsServer2DWrapMT::finish() {
 	}
 }
 
-PhysicsServer2DWrapMT::PhysicsServer2DWrapMT(PhysicsServer2D *p_contained, bool p_create_thread) {
+PhysicsServer2DWrapMT::PhysicsServer2DWrapMT(PhysicsServer2D *p_contained, bool p_create_thread) :
+		command_queue(CommandQueueMT::PRODUCER_MODE_LOCK_FREE) {
 	physics_server_2d = p_contained;
 	create_thread = p_create_thread;
 }
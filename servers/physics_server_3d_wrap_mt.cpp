@@ -102,7 +102,8 @@ void PhysicsServer3DWrapMT::finish() {
 	}
 }
 
-PhysicsServer3DWrapMT::PhysicsServer3DWrapMT(PhysicsServer3D *p_contained, bool p_create_thread) {
+PhysicsServer3DWrapMT::PhysicsServer3DWrapMT(PhysicsServer3D *p_contained, bool p_create_thread) :
+		command_queue(CommandQueueMT::PRODUCER_MODE_LOCK_FREE) {
 	physics_server_3d = p_contained;
 	create_thread = p_create_thread;
 }
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/marshalls.h"
+#include "core/os/heap_profiler.h"
 #include "core/os/os.h"
 #include "core/templates/sort_array.h"
 #include "renderer_canvas_cull.h"
@@ -69,6 +70,8 @@ void RenderingServerDefault::request_frame_drawn_callback(const Callable &p_call
 }
 
 void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
+	HEAP_PROFILE_TAG("Rendering");
+
 	RSG::rasterizer->begin_frame(frame_step);
 
 	TIMESTAMP_BEGIN()
@@ -369,6 +372,8 @@ void RenderingServerDefault::_thread_exit() {
 }
 
 void RenderingServerDefault::_thread_loop() {
+	HEAP_PROFILE_TAG("Rendering");
+
 	DisplayServer::get_singleton()->gl_window_make_current(DisplayServer::MAIN_WINDOW_ID); // Move GL to this thread.
 
 	while (!exit) {
@@ -415,7 +420,8 @@ void RenderingServerDefault::_call_on_render_thread(const Callable &p_callable)
 	p_callable.call();
 }
 
-RenderingServerDefault::RenderingServerDefault(bool p_create_thread) {
+RenderingServerDefault::RenderingServerDefault(bool p_create_thread) :
+		command_queue(CommandQueueMT::PRODUCER_MODE_LOCK_FREE) {
 	RenderingServer::init();
 
 	create_thread = p_create_thread;
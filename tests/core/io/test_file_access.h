@@ -32,6 +32,7 @@
 #define TEST_FILE_ACCESS_H
 
 #include "core/io/file_access.h"
+#include "core/io/file_access_memory.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -107,6 +108,80 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Memory-mapped read") {
+	const String path = TestUtils::get_data_path("line_endings_crlf.test.txt");
+	Vector<uint8_t> expected = FileAccess::get_file_as_bytes(path);
+	REQUIRE(expected.size() > 8);
+
+	Ref<FileAccess> f = FileAccess::open_mapped(path);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == (uint64_t)expected.size());
+	CHECK(f->get_buffer(expected.size()) == expected);
+	CHECK_FALSE(f->eof_reached());
+	CHECK(f->get_8() == 0);
+	CHECK(f->eof_reached());
+
+	f->seek(2);
+	CHECK(f->get_16() == (expected[2] | (expected[3] << 8)));
+
+	// A second handle shares the mapping and keeps its own position.
+	Ref<FileAccess> f2 = FileAccess::open_mapped(path);
+	REQUIRE(f2.is_valid());
+	CHECK(f2->get_8() == expected[0]);
+	CHECK(f->get_position() == 4);
+
+	const uint8_t *ptr = f2->get_buffer_ptr(4);
+	if (ptr) {
+		// Only backends that expose their storage return a pointer.
+		CHECK(memcmp(ptr, expected.ptr() + 1, 4) == 0);
+		CHECK(f2->get_position() == 5);
+		CHECK(f2->get_buffer_ptr(expected.size()) == nullptr);
+		CHECK(f2->get_position() == 5);
+	}
+
+	Error err = OK;
+	CHECK(FileAccess::open_mapped(TestUtils::get_data_path("does_not_exist.txt"), &err).is_null());
+	CHECK(err == ERR_FILE_NOT_FOUND);
+}
+
+TEST_CASE("[FileAccess] Memory files expose their buffer in place") {
+	const uint8_t data[] = { 1, 2, 3, 4, 5, 6 };
+	Ref<FileAccessMemory> f;
+	f.instantiate();
+	REQUIRE(f->open_custom(data, sizeof(data)) == OK);
+
+	CHECK(f->get_8() == 1);
+	CHECK(f->get_buffer_ptr(4) == data + 1);
+	CHECK(f->get_position() == 5);
+	CHECK(f->get_buffer_ptr(2) == nullptr);
+	CHECK(f->get_position() == 5);
+	CHECK(f->get_buffer_ptr(1) == data + 5);
+	CHECK(f->get_buffer_ptr(0) == data + 6);
+}
+
+TEST_CASE("[FileAccess] Buffer view outlives the file handle") {
+	const String path = TestUtils::get_data_path("line_endings_lf.test.txt");
+	Vector<uint8_t> expected = FileAccess::get_file_as_bytes(path);
+	REQUIRE(expected.size() > 4);
+
+	Ref<FileAccess> f = FileAccess::open_mapped(path);
+	REQUIRE(f.is_valid());
+	f->seek(2);
+	Ref<FileBufferView> view = FileBufferView::create(f, expected.size() - 2);
+	if (view.is_null()) {
+		// Not memory-mapped on this platform, callers read into their own buffer instead.
+		CHECK(f->get_position() == 2);
+		return;
+	}
+
+	CHECK(f->get_position() == (uint64_t)expected.size());
+	CHECK(FileBufferView::create(f, 1).is_null());
+
+	f.unref();
+	CHECK(view->get_size() == (uint64_t)expected.size() - 2);
+	CHECK(memcmp(view->ptr(), expected.ptr() + 2, view->get_size()) == 0);
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
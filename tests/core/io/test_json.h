@@ -232,6 +232,20 @@ TEST_CASE("[JSON] Parsing escape sequences") {
 		ERR_PRINT_ON
 	}
 }
+
+TEST_CASE("[JSON] Keeping the parsed text") {
+	const String ascii = "{\"name\": \"Godot\", \"values\": [1, 2, 3]}";
+	const String wide = String::utf8("{\"name\": \"Gödot 混合\"}");
+
+	JSON json;
+	CHECK(json.parse(ascii, true) == OK);
+	CHECK(json.get_parsed_text() == ascii);
+	CHECK(json.parse(wide, true) == OK);
+	CHECK(json.get_parsed_text() == wide);
+
+	json.set_data(Dictionary());
+	CHECK(json.get_parsed_text().is_empty());
+}
 } // namespace TestJSON
 
 #endif // TEST_JSON_H
@@ -32,6 +32,7 @@
 #define TEST_MARSHALLS_H
 
 #include "core/io/marshalls.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -386,6 +387,246 @@ TEST_CASE("[Marshalls] Typed array decoding") {
 	CHECK(array[0] == Variant(uint64_t(0x0f123456789abcdef)));
 }
 
+static Dictionary make_packed_test_data() {
+	Dictionary data;
+	data["nil"] = Variant();
+	data["bool"] = true;
+	data["small_int"] = -3;
+	data["large_int"] = int64_t(0x0f123456789abcdef);
+	data["float"] = 0.5;
+	data["double"] = 0.1;
+	data["string"] = String::utf8("Hello, wörld");
+	data[StringName("name")] = StringName("position");
+	data[7] = Vector3(1, 2, 3);
+
+	PackedByteArray bytes;
+	PackedInt32Array ints;
+	PackedInt64Array longs;
+	PackedFloat64Array doubles;
+	PackedVector3Array vectors;
+	PackedColorArray colors;
+	for (int i = 0; i < 10; i++) {
+		bytes.push_back(i);
+		ints.push_back(-i * 1000);
+		longs.push_back(int64_t(i) << 40);
+		doubles.push_back(i / 3.0);
+		vectors.push_back(Vector3(i, -i, i * 0.5));
+		colors.push_back(Color(i * 0.1, 0.2, 0.3, 1.0));
+	}
+	data["bytes"] = bytes;
+	data["ints"] = ints;
+	data["longs"] = longs;
+	data["doubles"] = doubles;
+	data["vectors"] = vectors;
+	data["colors"] = colors;
+	data["strings"] = PackedStringArray({ "a", "bc", "" });
+
+	Array nested;
+	nested.push_back(PackedVector2Array({ Vector2(1, 2) }));
+	nested.push_back(Dictionary());
+	nested.push_back(Transform2D());
+	TypedArray<int> typed;
+	typed.push_back(4);
+	nested.push_back(typed);
+	data["nested"] = nested;
+	return data;
+}
+
+TEST_CASE("[Marshalls] Packed Variant round trip") {
+	Dictionary data = make_packed_test_data();
+	const uint32_t flag_sets[] = { 0, PACKED_VARIANT_VARINT, PACKED_VARIANT_STRING_TABLE, PACKED_VARIANT_DEFAULT };
+
+	for (uint32_t flags : flag_sets) {
+		PackedByteArray buffer;
+		CHECK(encode_variant_packed(data, buffer, flags) == OK);
+		CHECK(is_variant_packed(buffer.ptr(), buffer.size()));
+
+		Variant decoded;
+		int r_len = 0;
+		CHECK(decode_variant_packed(decoded, buffer.ptr(), buffer.size(), &r_len) == OK);
+		CHECK(r_len == buffer.size());
+		CHECK_MESSAGE(decoded == Variant(data), vformat("Round trip with flags %d should preserve the value.", flags));
+
+		Dictionary result = decoded;
+		CHECK(Variant(result[StringName("name")]).get_type() == Variant::STRING_NAME);
+		CHECK(Variant(result["double"]).get_type() == Variant::FLOAT);
+		CHECK(Array(result["nested"]).get(3).operator Array().get_typed_builtin() == Variant::INT);
+	}
+}
+
+TEST_CASE("[Marshalls] Packed Variant is smaller than the default format") {
+	Array messages;
+	for (int i = 0; i < 16; i++) {
+		Dictionary message;
+		message[StringName("id")] = i;
+		message[StringName("position")] = PackedVector3Array({ Vector3(i, 0, 0) });
+		message[StringName("health")] = 100;
+		messages.push_back(message);
+	}
+
+	int legacy_len = 0;
+	CHECK(encode_variant(messages, nullptr, legacy_len) == OK);
+	PackedByteArray buffer;
+	CHECK(encode_variant_packed(messages, buffer) == OK);
+	CHECK_MESSAGE(buffer.size() * 2 < legacy_len, "Varints and the string table should at least halve the size.");
+}
+
+TEST_CASE("[Marshalls] Packed Variant views") {
+	Dictionary data;
+	data[StringName("key")] = String("value");
+	data[StringName("count")] = -42;
+	data[StringName("floats")] = PackedFloat32Array({ 1.5, 2.5, 3.5 });
+
+	PackedByteArray buffer;
+	CHECK(encode_variant_packed(data, buffer) == OK);
+
+	PackedVariantReader reader;
+	CHECK(reader.open(buffer.ptr(), buffer.size()) == OK);
+	PackedVariantView root = reader.get_root();
+	CHECK(root.is_valid());
+	CHECK(root.get_type() == Variant::DICTIONARY);
+	CHECK(root.get_size() == 3);
+
+	LocalVector<PackedVariantView> elements;
+	CHECK(root.get_elements(elements) == OK);
+	REQUIRE(elements.size() == 6);
+
+	const uint8_t *begin = buffer.ptr();
+	const uint8_t *end = begin + buffer.size();
+	int checked = 0;
+	for (uint32_t i = 0; i < elements.size(); i += 2) {
+		const char *key = nullptr;
+		int key_length = 0;
+		CHECK(elements[i].get_type() == Variant::STRING_NAME);
+		CHECK(elements[i].get_utf8(key, key_length) == OK);
+		CHECK((const uint8_t *)key >= begin);
+		CHECK((const uint8_t *)key + key_length <= end);
+		String name = String::utf8(key, key_length);
+
+		const PackedVariantView &value = elements[i + 1];
+		if (name == "key") {
+			const char *utf8 = nullptr;
+			int length = 0;
+			CHECK(value.get_utf8(utf8, length) == OK);
+			CHECK(String::utf8(utf8, length) == "value");
+			checked++;
+		} else if (name == "count") {
+			CHECK(value.get_type() == Variant::INT);
+			CHECK(value.get_int() == -42);
+			checked++;
+		} else if (name == "floats") {
+			CHECK(value.get_type() == Variant::PACKED_FLOAT32_ARRAY);
+			const void *ptr = nullptr;
+			int count = 0;
+			CHECK(value.get_packed_data(ptr, count) == OK);
+			CHECK(count == 3);
+			CHECK((const uint8_t *)ptr >= begin);
+			CHECK((const uint8_t *)ptr + count * sizeof(float) <= end);
+			CHECK(((const float *)ptr)[1] == 2.5);
+
+			Variant decoded;
+			CHECK(value.decode(decoded) == OK);
+			CHECK(decoded == Variant(PackedFloat32Array({ 1.5, 2.5, 3.5 })));
+			checked++;
+		}
+	}
+	CHECK(checked == 3);
+}
+
+TEST_CASE("[Marshalls] Packed Variant invalid data") {
+	PackedByteArray buffer;
+	CHECK(encode_variant_packed(make_packed_test_data(), buffer) == OK);
+
+	Variant decoded;
+	ERR_PRINT_OFF;
+	for (int len = 0; len < buffer.size(); len++) {
+		PackedVariantReader reader;
+		CHECK_MESSAGE(reader.open(buffer.ptr(), len) != OK, vformat("Truncated buffer of %d bytes should be rejected.", len));
+	}
+
+	PackedByteArray bad_version = buffer;
+	bad_version.set(1, 0xFF);
+	CHECK(decode_variant_packed(decoded, bad_version.ptr(), bad_version.size()) == ERR_UNAVAILABLE);
+
+	// Flip each byte of the body and make sure decoding never crashes.
+	for (int i = 3; i < buffer.size(); i++) {
+		PackedByteArray corrupt = buffer;
+		corrupt.set(i, corrupt[i] ^ 0xFF);
+		decode_variant_packed(decoded, corrupt.ptr(), corrupt.size());
+	}
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[Marshalls] decode_variant accepts the packed format") {
+	Array array;
+	array.push_back(StringName("a"));
+	array.push_back(123456789);
+
+	PackedByteArray buffer;
+	CHECK(encode_variant_packed(array, buffer) == OK);
+	// Encoded values can be followed by other data, as with the default format.
+	buffer.push_back(0xAB);
+
+	Variant decoded;
+	int r_len = 0;
+	CHECK(decode_variant(decoded, buffer.ptr(), buffer.size(), &r_len) == OK);
+	CHECK(r_len == buffer.size() - 1);
+	CHECK(decoded == Variant(array));
+}
+
+TEST_CASE("[Marshalls] Packed format round trips nested arrays of dictionaries") {
+	Array messages;
+	for (int i = 0; i < 64; i++) {
+		Dictionary message = make_packed_test_data();
+		message["index"] = i;
+		messages.push_back(message);
+	}
+
+	int legacy_len = 0;
+	CHECK(encode_variant(messages, nullptr, legacy_len) == OK);
+	PackedByteArray packed;
+	CHECK(encode_variant_packed(messages, packed) == OK);
+	CHECK(packed.size() < legacy_len);
+
+	Variant decoded;
+	CHECK(decode_variant_packed(decoded, packed.ptr(), packed.size()) == OK);
+	CHECK(decoded == Variant(messages));
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Marshalls] Packed Variant decoding") {
+	Array messages;
+	for (int i = 0; i < 64; i++) {
+		Dictionary message = make_packed_test_data();
+		message["index"] = i;
+		messages.push_back(message);
+	}
+
+	int legacy_len = 0;
+	CHECK(encode_variant(messages, nullptr, legacy_len) == OK);
+	PackedByteArray legacy;
+	legacy.resize(legacy_len);
+	CHECK(encode_variant(messages, legacy.ptrw(), legacy_len) == OK);
+	PackedByteArray packed;
+	CHECK(encode_variant_packed(messages, packed) == OK);
+
+	const int iterations = 200;
+	Variant decoded;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		decode_variant(decoded, legacy.ptr(), legacy.size());
+	}
+	uint64_t legacy_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		decode_variant_packed(decoded, packed.ptr(), packed.size());
+	}
+	uint64_t packed_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(decoded == Variant(messages));
+	MESSAGE(vformat("Default format: %d bytes, %d usec. Packed format: %d bytes, %d usec.", legacy.size(), legacy_usec, packed.size(), packed_usec));
+}
+
 } // namespace TestMarshalls
 
 #endif // TEST_MARSHALLS_H
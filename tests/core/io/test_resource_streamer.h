@@ -0,0 +1,224 @@
+/**************************************************************************/
+/*  test_resource_streamer.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RESOURCE_STREAMER_H
+#define TEST_RESOURCE_STREAMER_H
+
+#include "core/io/resource.h"
+#include "core/io/resource_saver.h"
+#include "core/io/resource_streamer.h"
+#include "core/os/os.h"
+#include "core/os/semaphore.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+#include "tests/test_macros.h"
+
+namespace TestResourceStreamer {
+
+static Vector<String> save_streaming_resources(int p_count) {
+	Vector<String> paths;
+	for (int i = 0; i < p_count; i++) {
+		Ref<Resource> resource;
+		resource.instantiate();
+		resource->set_name(vformat("Streamed %d", i));
+		const String path = TestUtils::get_temp_path(vformat("streamed_%d.res", i));
+		CHECK(ResourceSaver::save(resource, path) == OK);
+		paths.push_back(path);
+	}
+	return paths;
+}
+
+TEST_CASE("[ResourceStreamer] Requesting and collecting") {
+	const Vector<String> paths = save_streaming_resources(8);
+
+	for (int i = 0; i < paths.size(); i++) {
+		CHECK(ResourceStreamer::request(paths[i], "", float(i), ResourceFormatLoader::CACHE_MODE_IGNORE) == OK);
+		CHECK(ResourceStreamer::get_status(paths[i]) != ResourceLoader::THREAD_LOAD_INVALID_RESOURCE);
+	}
+	// A repeated request shares the existing one, and is collected separately.
+	CHECK(ResourceStreamer::request(paths[0], "", 100.0f, ResourceFormatLoader::CACHE_MODE_IGNORE) == OK);
+
+	for (int i = 0; i < paths.size(); i++) {
+		Error err = FAILED;
+		Ref<Resource> loaded = ResourceStreamer::get(paths[i], &err);
+		CHECK(err == OK);
+		REQUIRE(loaded.is_valid());
+		CHECK(loaded->get_name() == vformat("Streamed %d", i));
+		if (i == 0) {
+			CHECK(ResourceStreamer::get_status(paths[i]) == ResourceLoader::THREAD_LOAD_LOADED);
+			CHECK(ResourceStreamer::get(paths[i]) == loaded);
+		}
+		CHECK(ResourceStreamer::get_status(paths[i]) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE);
+	}
+
+	CHECK(ResourceStreamer::get_queue_depth() == 0);
+	CHECK(ResourceStreamer::get_average_latency() > 0.0);
+
+	Error err = OK;
+	CHECK(ResourceStreamer::get(paths[0], &err).is_null());
+	CHECK(err == ERR_INVALID_PARAMETER);
+}
+
+TEST_CASE("[ResourceStreamer] Cancelling") {
+	const Vector<String> paths = save_streaming_resources(8);
+	ResourceStreamer::set_max_loads(1);
+
+	for (int i = 0; i < paths.size(); i++) {
+		ResourceStreamer::request(paths[i], "", 0.0f, ResourceFormatLoader::CACHE_MODE_IGNORE);
+	}
+	// Whatever state they are in, cancelled requests are gone.
+	for (int i = 0; i < paths.size(); i += 2) {
+		CHECK(ResourceStreamer::cancel(paths[i]));
+		CHECK_FALSE(ResourceStreamer::cancel(paths[i]));
+		CHECK(ResourceStreamer::get_status(paths[i]) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE);
+	}
+	for (int i = 1; i < paths.size(); i += 2) {
+		Ref<Resource> loaded = ResourceStreamer::get(paths[i]);
+		REQUIRE(loaded.is_valid());
+		CHECK(loaded->get_name() == vformat("Streamed %d", i));
+	}
+
+	// Cancelling a shared request only ends it for one requester.
+	ResourceStreamer::request(paths[0], "", 0.0f, ResourceFormatLoader::CACHE_MODE_IGNORE);
+	ResourceStreamer::request(paths[0], "", 0.0f, ResourceFormatLoader::CACHE_MODE_IGNORE);
+	CHECK(ResourceStreamer::cancel(paths[0]));
+	CHECK(ResourceStreamer::get_status(paths[0]) != ResourceLoader::THREAD_LOAD_INVALID_RESOURCE);
+	Ref<Resource> shared = ResourceStreamer::get(paths[0]);
+	REQUIRE(shared.is_valid());
+	CHECK(shared->get_name() == "Streamed 0");
+	CHECK(ResourceStreamer::get_status(paths[0]) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE);
+
+	ResourceStreamer::clear();
+	CHECK(ResourceStreamer::get_loads_in_flight() == 0);
+	CHECK(ResourceStreamer::get_size_in_flight() == 0);
+	ResourceStreamer::set_max_loads(0);
+}
+
+// Records the order in which resources are loaded. Loading the "gate" resource
+// blocks until the test releases it, so that requests pile up behind it.
+class _StreamingOrderLoader : public ResourceFormatLoader {
+public:
+	Semaphore gate;
+	BinaryMutex mutex;
+	Vector<String> order;
+
+	virtual Ref<Resource> load(const String &p_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) override {
+		if (p_path.get_file().get_basename() == "gate") {
+			gate.wait();
+		}
+		{
+			MutexLock lock(mutex);
+			order.push_back(p_path.get_file().get_basename());
+		}
+		if (r_error) {
+			*r_error = OK;
+		}
+		Ref<Resource> resource;
+		resource.instantiate();
+		return resource;
+	}
+
+	virtual void get_recognized_extensions(List<String> *p_extensions) const override {
+		p_extensions->push_back("streamorder");
+	}
+
+	virtual bool handles_type(const String &p_type) const override {
+		return p_type == "Resource";
+	}
+
+	virtual String get_resource_type(const String &p_path) const override {
+		return p_path.get_extension() == "streamorder" ? "Resource" : "";
+	}
+};
+
+TEST_CASE("[ResourceStreamer] Dispatch order") {
+	Ref<_StreamingOrderLoader> loader;
+	loader.instantiate();
+	ResourceLoader::add_resource_format_loader(loader, true);
+	ResourceStreamer::set_max_loads(1);
+	ResourceStreamer::set_origin(Vector3());
+
+	// The gate takes the only load slot, so the other requests wait in the queue.
+	const String paths[] = { "res://gate.streamorder", "res://low.streamorder", "res://high.streamorder", "res://near.streamorder", "res://far.streamorder" };
+	ResourceStreamer::request(paths[0], "", 0.0f, ResourceFormatLoader::CACHE_MODE_IGNORE);
+	ResourceStreamer::request(paths[1], "", 0.0f, ResourceFormatLoader::CACHE_MODE_IGNORE);
+	ResourceStreamer::request(paths[2], "", 10.0f, ResourceFormatLoader::CACHE_MODE_IGNORE);
+	ResourceStreamer::request(paths[3], "", 5.0f, ResourceFormatLoader::CACHE_MODE_IGNORE);
+	ResourceStreamer::set_position(paths[3], Vector3(1, 0, 0));
+	ResourceStreamer::request(paths[4], "", 5.0f, ResourceFormatLoader::CACHE_MODE_IGNORE);
+	ResourceStreamer::set_position(paths[4], Vector3(100, 0, 0));
+	CHECK(ResourceStreamer::get_queue_depth() == 4);
+
+	// Collecting a waiting request would load it right away, so wait for all of them first.
+	loader->gate.post();
+	for (int attempt = 0; attempt < 5000 && ResourceStreamer::get_queue_depth() + ResourceStreamer::get_loads_in_flight() > 0; attempt++) {
+		OS::get_singleton()->delay_usec(1000);
+	}
+	for (const String &path : paths) {
+		CHECK(ResourceStreamer::get(path).is_valid());
+	}
+
+	// Highest priority first, with the distance to the origin subtracted from it.
+	const Vector<String> expected = { "gate", "high", "near", "low", "far" };
+	CHECK(loader->order == expected);
+
+	ResourceLoader::remove_resource_format_loader(loader);
+	ResourceStreamer::set_max_loads(0);
+}
+
+TEST_CASE("[ResourceStreamer] Budget and distance priorities") {
+	const Vector<String> paths = save_streaming_resources(6);
+	ResourceStreamer::set_max_loads(2);
+	// Smaller than any file, so requests load one at a time.
+	ResourceStreamer::set_memory_budget(1);
+	ResourceStreamer::set_origin(Vector3(100, 0, 0));
+
+	for (int i = 0; i < paths.size(); i++) {
+		ResourceStreamer::request(paths[i], "", 0.0f, ResourceFormatLoader::CACHE_MODE_IGNORE);
+		ResourceStreamer::set_position(paths[i], Vector3(i * 20, 0, 0));
+		CHECK(ResourceStreamer::get_loads_in_flight() <= 1);
+	}
+	ResourceStreamer::set_priority(paths[0], 1000.0f);
+	CHECK(ResourceStreamer::get_origin() == Vector3(100, 0, 0));
+
+	for (int i = 0; i < paths.size(); i++) {
+		Ref<Resource> loaded = ResourceStreamer::get(paths[i]);
+		CHECK(loaded.is_valid());
+	}
+
+	ResourceStreamer::set_memory_budget(0);
+	ResourceStreamer::set_max_loads(0);
+	ResourceStreamer::set_origin(Vector3());
+}
+
+} // namespace TestResourceStreamer
+
+#endif // TEST_RESOURCE_STREAMER_H
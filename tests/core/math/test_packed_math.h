@@ -0,0 +1,278 @@
+/**************************************************************************/
+/*  test_packed_math.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PACKED_MATH_H
+#define TEST_PACKED_MATH_H
+
+#include "core/math/packed_math.h"
+#include "core/math/random_number_generator.h"
+#include "core/os/os.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPackedMath {
+
+// Counts up to 37 cover empty arrays, the vectorized body and every scalar tail length.
+static const int MAX_COUNT = 37;
+
+static PackedVector3Array _random_vector3s(Ref<RandomNumberGenerator> &p_rng, int p_count) {
+	PackedVector3Array ret;
+	ret.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		ret.write[i] = Vector3(p_rng->randf_range(-100, 100), p_rng->randf_range(-100, 100), p_rng->randf_range(-100, 100));
+	}
+	return ret;
+}
+
+static PackedVector2Array _random_vector2s(Ref<RandomNumberGenerator> &p_rng, int p_count) {
+	PackedVector2Array ret;
+	ret.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		ret.write[i] = Vector2(p_rng->randf_range(-100, 100), p_rng->randf_range(-100, 100));
+	}
+	return ret;
+}
+
+TEST_CASE("[PackedMath] Vector3 kernels match per-element math") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(1234);
+	const Transform3D xform = Transform3D(Basis(Vector3(1, 2, 3).normalized(), 0.7).scaled(Vector3(2, 3, 0.5)), Vector3(4, -5, 6));
+
+	for (int count = 0; count <= MAX_COUNT; count++) {
+		const PackedVector3Array a = _random_vector3s(rng, count);
+		const PackedVector3Array b = _random_vector3s(rng, count);
+
+		Vector3 *vectors = memnew_arr(Vector3, MAX(count, 1));
+		float *floats = memnew_arr(float, MAX(count, 1));
+
+		PackedMath::xform(xform, a.ptr(), vectors, count);
+		for (int i = 0; i < count; i++) {
+			CHECK(vectors[i].is_equal_approx(xform.xform(a[i])));
+		}
+		PackedMath::lerp(a.ptr(), b.ptr(), 0.3, vectors, count);
+		for (int i = 0; i < count; i++) {
+			CHECK(vectors[i].is_equal_approx(a[i].lerp(b[i], 0.3)));
+		}
+		PackedMath::cross(a.ptr(), b.ptr(), vectors, count);
+		for (int i = 0; i < count; i++) {
+			CHECK(vectors[i].is_equal_approx(a[i].cross(b[i])));
+		}
+		PackedMath::dot(a.ptr(), b.ptr(), floats, count);
+		for (int i = 0; i < count; i++) {
+			CHECK(floats[i] == doctest::Approx(a[i].dot(b[i])));
+		}
+		PackedMath::length(a.ptr(), floats, count);
+		for (int i = 0; i < count; i++) {
+			CHECK(floats[i] == doctest::Approx(a[i].length()));
+		}
+
+		AABB expected;
+		for (int i = 0; i < count; i++) {
+			if (i == 0) {
+				expected.position = a[i];
+			} else {
+				expected.expand_to(a[i]);
+			}
+		}
+		CHECK(PackedMath::get_aabb(a.ptr(), count).is_equal_approx(expected));
+
+		memdelete_arr(vectors);
+		memdelete_arr(floats);
+	}
+}
+
+TEST_CASE("[PackedMath] Vector2 kernels match per-element math") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(5678);
+	const Transform2D xform = Transform2D(0.4, Size2(3, 0.5), 0.2, Vector2(-7, 8));
+
+	for (int count = 0; count <= MAX_COUNT; count++) {
+		const PackedVector2Array a = _random_vector2s(rng, count);
+		const PackedVector2Array b = _random_vector2s(rng, count);
+
+		Vector2 *vectors = memnew_arr(Vector2, MAX(count, 1));
+		float *floats = memnew_arr(float, MAX(count, 1));
+
+		PackedMath::xform(xform, a.ptr(), vectors, count);
+		for (int i = 0; i < count; i++) {
+			CHECK(vectors[i].is_equal_approx(xform.xform(a[i])));
+		}
+		PackedMath::lerp(a.ptr(), b.ptr(), 0.6, vectors, count);
+		for (int i = 0; i < count; i++) {
+			CHECK(vectors[i].is_equal_approx(a[i].lerp(b[i], 0.6)));
+		}
+		PackedMath::cross(a.ptr(), b.ptr(), floats, count);
+		for (int i = 0; i < count; i++) {
+			CHECK(floats[i] == doctest::Approx(a[i].cross(b[i])));
+		}
+		PackedMath::dot(a.ptr(), b.ptr(), floats, count);
+		for (int i = 0; i < count; i++) {
+			CHECK(floats[i] == doctest::Approx(a[i].dot(b[i])));
+		}
+		PackedMath::length(a.ptr(), floats, count);
+		for (int i = 0; i < count; i++) {
+			CHECK(floats[i] == doctest::Approx(a[i].length()));
+		}
+
+		Rect2 expected;
+		for (int i = 0; i < count; i++) {
+			if (i == 0) {
+				expected.position = a[i];
+			} else {
+				expected.expand_to(a[i]);
+			}
+		}
+		CHECK(PackedMath::get_rect(a.ptr(), count).is_equal_approx(expected));
+
+		memdelete_arr(vectors);
+		memdelete_arr(floats);
+	}
+}
+
+TEST_CASE("[PackedMath] Color lerp matches per-element math") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(91011);
+
+	for (int count = 0; count <= MAX_COUNT; count++) {
+		PackedColorArray a;
+		PackedColorArray b;
+		a.resize(count);
+		b.resize(count);
+		for (int i = 0; i < count; i++) {
+			a.write[i] = Color(rng->randf(), rng->randf(), rng->randf(), rng->randf());
+			b.write[i] = Color(rng->randf(), rng->randf(), rng->randf(), rng->randf());
+		}
+
+		PackedColorArray result;
+		result.resize(count);
+		PackedMath::lerp(a.ptr(), b.ptr(), 0.25f, result.ptrw(), count);
+		for (int i = 0; i < count; i++) {
+			CHECK(result[i].is_equal_approx(a[i].lerp(b[i], 0.25)));
+		}
+	}
+}
+
+TEST_CASE("[PackedMath] Script-exposed packed array methods") {
+	PackedVector3Array points;
+	points.push_back(Vector3(1, 0, 0));
+	points.push_back(Vector3(0, 2, 0));
+	points.push_back(Vector3(-1, 0, 3));
+	PackedVector3Array others;
+	others.push_back(Vector3(0, 1, 0));
+	others.push_back(Vector3(0, 0, 1));
+	others.push_back(Vector3(1, 0, 0));
+
+	Variant v = points;
+	Callable::CallError ce;
+	Variant ret;
+
+	v.callp("get_aabb", nullptr, 0, ret, ce);
+	CHECK(ce.error == Callable::CallError::CALL_OK);
+	CHECK(AABB(ret).is_equal_approx(AABB(Vector3(-1, 0, 0), Vector3(2, 2, 3))));
+
+	const Variant others_arg = others;
+	const Variant *args[1] = { &others_arg };
+	v.callp("dot", args, 1, ret, ce);
+	CHECK(ce.error == Callable::CallError::CALL_OK);
+	CHECK(PackedFloat32Array(ret) == PackedFloat32Array({ 0, 0, -1 }));
+
+	v.callp("cross", args, 1, ret, ce);
+	const PackedVector3Array crosses = ret;
+	REQUIRE(crosses.size() == 3);
+	CHECK(crosses[0].is_equal_approx(Vector3(0, 0, 1)));
+	CHECK(crosses[1].is_equal_approx(Vector3(2, 0, 0)));
+	CHECK(crosses[2].is_equal_approx(Vector3(0, 3, 0)));
+
+	v.callp("lengths", nullptr, 0, ret, ce);
+	const PackedFloat32Array lengths = ret;
+	REQUIRE(lengths.size() == 3);
+	CHECK(lengths[2] == doctest::Approx(Math::sqrt(10.0)));
+
+	const Variant weight = 0.5;
+	const Variant *lerp_args[2] = { &others_arg, &weight };
+	v.callp("lerp", lerp_args, 2, ret, ce);
+	CHECK(PackedVector3Array(ret)[0].is_equal_approx(Vector3(0.5, 0.5, 0)));
+
+	PackedVector3Array mismatched;
+	mismatched.push_back(Vector3());
+	const Variant mismatched_arg = mismatched;
+	const Variant *mismatched_args[1] = { &mismatched_arg };
+	ERR_PRINT_OFF;
+	v.callp("dot", mismatched_args, 1, ret, ce);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(PackedFloat32Array(ret).is_empty(), "Arrays of different sizes should produce an empty result.");
+
+	PackedVector2Array points_2d;
+	points_2d.push_back(Vector2(3, 4));
+	points_2d.push_back(Vector2(-2, 1));
+	v = points_2d;
+	v.callp("get_rect", nullptr, 0, ret, ce);
+	CHECK(Rect2(ret).is_equal_approx(Rect2(-2, 1, 5, 3)));
+	v.callp("lengths", nullptr, 0, ret, ce);
+	CHECK(PackedFloat32Array(ret)[0] == doctest::Approx(5.0));
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][PackedMath] Bulk transform throughput") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(42);
+	const PackedVector3Array points = _random_vector3s(rng, 1 << 16);
+	const Transform3D xform = Transform3D(Basis(Vector3(0, 1, 0), 0.3), Vector3(1, 2, 3));
+	const int iterations = 100;
+	PackedVector3Array result;
+	result.resize(points.size());
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		Vector3 *w = result.ptrw();
+		for (int j = 0; j < points.size(); j++) {
+			w[j] = xform.xform(points[j]);
+		}
+	}
+	uint64_t scalar_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		PackedMath::xform(xform, points.ptr(), result.ptrw(), points.size());
+	}
+	uint64_t packed_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(result[0].is_equal_approx(xform.xform(points[0])));
+	MESSAGE(vformat("%d transforms of %d points: %d usec element-wise, %d usec in bulk.",
+			iterations, points.size(), (int64_t)scalar_usec, (int64_t)packed_usec));
+}
+
+} // namespace TestPackedMath
+
+#endif // TEST_PACKED_MATH_H
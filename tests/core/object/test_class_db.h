@@ -34,6 +34,9 @@
 #include "core/core_bind.h"
 #include "core/core_constants.h"
 #include "core/object/class_db.h"
+#include "core/os/os.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 
 #include "tests/test_macros.h"
 
@@ -849,6 +852,156 @@ TEST_SUITE("[ClassDB]") {
 		}
 	}
 }
+
+TEST_CASE("[ClassDB] Frozen lookups") {
+	ClassDB::freeze();
+	CHECK(ClassDB::is_frozen());
+
+	CHECK(ClassDB::get_method("Node", "add_child") != nullptr);
+	CHECK(ClassDB::is_parent_class("Node", "Object"));
+	CHECK_FALSE(ClassDB::is_parent_class("Object", "Node"));
+
+	// Modifying a frozen ClassDB is allowed and keeps it frozen.
+	ClassDB::set_class_enabled("Node", true);
+	CHECK(ClassDB::is_frozen());
+	CHECK(ClassDB::is_class_enabled("Node"));
+
+	Object *object = memnew(Object);
+	CHECK(object->call("get_instance_id") == Variant(object->get_instance_id()));
+	memdelete(object);
+
+	ClassDB::unfreeze();
+	CHECK_FALSE(ClassDB::is_frozen());
+	CHECK(ClassDB::get_method("Node", "add_child") != nullptr);
+}
+
+// Calls back into ClassDB while a writer on another thread is modifying it.
+class _ReentrantValidator : public Object {
+public:
+	Semaphore *writer_start = nullptr;
+	mutable int validated = 0;
+	mutable bool lookups_ok = true;
+
+	virtual void _validate_propertyv(PropertyInfo &p_property) const override {
+		if (validated++ == 0) {
+			writer_start->post();
+			// Give the writer time to take the lock and wait for readers.
+			OS::get_singleton()->delay_usec(20000);
+		}
+		lookups_ok = lookups_ok && ClassDB::has_method("Node", "add_child");
+	}
+};
+
+static void _class_db_writer(void *p_userdata) {
+	Semaphore *writer_start = (Semaphore *)p_userdata;
+	writer_start->wait();
+	ClassDB::set_class_enabled("Node", true);
+}
+
+TEST_CASE("[ClassDB] Property validators can look up classes while a writer waits") {
+	ClassDB::freeze();
+
+	Semaphore writer_start;
+	_ReentrantValidator validator;
+	validator.writer_start = &writer_start;
+
+	Thread writer;
+	writer.start(_class_db_writer, &writer_start);
+	List<PropertyInfo> properties;
+	ClassDB::get_property_list("Node", &properties, true, &validator);
+	writer.wait_to_finish();
+
+	CHECK(validator.validated == properties.size());
+	CHECK(validator.lookups_ok);
+
+	writer.start(_class_db_writer, &writer_start);
+	validator.validated = 0;
+	PropertyInfo info;
+	CHECK(ClassDB::get_property_info("Node", "name", &info, false, &validator));
+	writer.wait_to_finish();
+
+	CHECK(info.name == "name");
+	CHECK(validator.validated == 1);
+	CHECK(validator.lookups_ok);
+	CHECK(ClassDB::is_frozen());
+
+	ClassDB::unfreeze();
+}
+
+struct ThreadedDispatch {
+	Vector<Object *> objects;
+	SafeNumeric<uint32_t> next;
+	SafeNumeric<uint32_t> failures;
+	int rounds = 2000;
+
+	ThreadedDispatch() {
+		for (int i = 0; i < 16; i++) {
+			objects.push_back(memnew(Object));
+		}
+	}
+
+	~ThreadedDispatch() {
+		for (Object *object : objects) {
+			memdelete(object);
+		}
+	}
+
+	static void thread_func(void *p_userdata) {
+		ThreadedDispatch *self = (ThreadedDispatch *)p_userdata;
+		Object *object = self->objects[self->next.postincrement()];
+		const StringName method = "get_instance_id";
+		const StringName node = "Node";
+		const StringName add_child = "add_child";
+		for (int i = 0; i < self->rounds; i++) {
+			if (object->call(method) != Variant(object->get_instance_id())) {
+				self->failures.increment();
+			}
+			if (!ClassDB::has_method(node, add_child)) {
+				self->failures.increment();
+			}
+		}
+	}
+
+	uint64_t run(int p_threads) {
+		next.set(0);
+		Vector<Thread *> threads;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < p_threads; i++) {
+			Thread *thread = memnew(Thread);
+			thread->start(thread_func, this);
+			threads.push_back(thread);
+		}
+		for (Thread *thread : threads) {
+			thread->wait_to_finish();
+			memdelete(thread);
+		}
+		return OS::get_singleton()->get_ticks_usec() - begin;
+	}
+};
+
+TEST_CASE("[ClassDB] Threaded call dispatch, locked and frozen") {
+	ThreadedDispatch dispatch;
+	dispatch.run(4);
+	ClassDB::freeze();
+	dispatch.run(4);
+	ClassDB::unfreeze();
+	CHECK(dispatch.failures.get() == 0);
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][ClassDB] Threaded call dispatch, locked and frozen") {
+	ThreadedDispatch dispatch;
+	dispatch.rounds = 20000;
+	for (int threads : { 1, 2, 4, 8, 16 }) {
+		uint64_t locked_usec = dispatch.run(threads);
+		ClassDB::freeze();
+		uint64_t frozen_usec = dispatch.run(threads);
+		ClassDB::unfreeze();
+
+		MESSAGE(vformat("%d thread(s), %d calls each: %d usec locked, %d usec frozen.",
+				threads, dispatch.rounds * 2, (int64_t)locked_usec, (int64_t)frozen_usec));
+	}
+	CHECK(dispatch.failures.get() == 0);
+}
 } // namespace TestClassDB
 
 #endif // TEST_CLASS_DB_H
@@ -0,0 +1,203 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MESSAGE_QUEUE_H
+#define TEST_MESSAGE_QUEUE_H
+
+#include "core/object/message_queue.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+class MessageRecorder : public Object {
+public:
+	LocalVector<int> order;
+
+	void record(int p_value) {
+		order.push_back(p_value);
+	}
+};
+
+struct PushRange {
+	CallQueue *queue = nullptr;
+	MessageRecorder *recorder = nullptr;
+	int from = 0;
+	int to = 0;
+	int stride = 1;
+
+	static void push_thread(void *p_userdata) {
+		PushRange *range = static_cast<PushRange *>(p_userdata);
+		for (int i = range->from; i < range->to; i += range->stride) {
+			range->queue->push_callable(callable_mp(range->recorder, &MessageRecorder::record), i);
+		}
+	}
+};
+
+TEST_CASE("[MessageQueue] Thread buffers keep the push order") {
+	CallQueue queue(nullptr, 8192, String(), true);
+	MessageRecorder *recorder = memnew(MessageRecorder);
+
+	// Each batch is pushed only after the previous one, alternating between
+	// the main thread and other threads.
+	int next = 0;
+	for (int batch = 0; batch < 6; batch++) {
+		PushRange range;
+		range.queue = &queue;
+		range.recorder = recorder;
+		range.from = next;
+		range.to = next + 100;
+		next = range.to;
+
+		if (batch % 2 == 0) {
+			PushRange::push_thread(&range);
+		} else {
+			Thread thread;
+			thread.start(&PushRange::push_thread, &range);
+			thread.wait_to_finish();
+		}
+	}
+
+	CHECK(queue.has_messages());
+	const int usage_before_flush = queue.get_max_buffer_usage();
+	queue.flush();
+	CHECK_FALSE(queue.has_messages());
+
+	REQUIRE(recorder->order.size() == (uint32_t)next);
+	for (int i = 0; i < next; i++) {
+		CHECK(recorder->order[i] == i);
+	}
+
+	// Buffers of threads that exited are released once drained.
+	CHECK(queue.get_max_buffer_usage() < usage_before_flush);
+
+	memdelete(recorder);
+}
+
+TEST_CASE("[MessageQueue] Concurrent pushes from several threads") {
+	CallQueue queue(nullptr, 8192, String(), true);
+	MessageRecorder *recorder = memnew(MessageRecorder);
+
+	const int thread_count = 4;
+	const int per_thread = 2000;
+	Thread threads[thread_count];
+	PushRange ranges[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		// Thread i pushes i, i + thread_count, i + 2 * thread_count...
+		ranges[i].queue = &queue;
+		ranges[i].recorder = recorder;
+		ranges[i].from = i;
+		ranges[i].to = thread_count * per_thread;
+		ranges[i].stride = thread_count;
+		threads[i].start(&PushRange::push_thread, &ranges[i]);
+	}
+
+	// Flush while the other threads are still pushing.
+	for (int i = 0; i < 16; i++) {
+		queue.flush();
+	}
+
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+	queue.flush();
+
+	REQUIRE(recorder->order.size() == (uint32_t)(thread_count * per_thread));
+	int last[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		last[i] = -1;
+	}
+	bool in_order = true;
+	for (int value : recorder->order) {
+		int thread = value % thread_count;
+		in_order = in_order && value > last[thread];
+		last[thread] = value;
+	}
+	CHECK(in_order);
+
+	memdelete(recorder);
+}
+
+struct PushUntilFull {
+	CallQueue *queue = nullptr;
+	MessageRecorder *recorder = nullptr;
+	int pushed = 0;
+
+	static void push_thread(void *p_userdata) {
+		PushUntilFull *self = static_cast<PushUntilFull *>(p_userdata);
+		while (self->queue->push_callable(callable_mp(self->recorder, &MessageRecorder::record), self->pushed) == OK) {
+			self->pushed++;
+		}
+	}
+};
+
+TEST_CASE("[MessageQueue] The page limit is shared by all thread buffers") {
+	CallQueue queue(nullptr, 4, String(), true);
+	MessageRecorder *recorder = memnew(MessageRecorder);
+
+	PushUntilFull single;
+	single.queue = &queue;
+	single.recorder = recorder;
+	Thread thread;
+	thread.start(&PushUntilFull::push_thread, &single);
+	thread.wait_to_finish();
+
+	queue.flush();
+	CHECK(single.pushed > 0);
+	CHECK(recorder->order.size() == (uint32_t)single.pushed);
+
+	// Pages of drained buffers are given back, and several threads together
+	// can't store more than a single one.
+	const int thread_count = 3;
+	Thread threads[thread_count];
+	PushUntilFull several[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		several[i].queue = &queue;
+		several[i].recorder = recorder;
+		threads[i].start(&PushUntilFull::push_thread, &several[i]);
+	}
+	int total = 0;
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+		total += several[i].pushed;
+	}
+	CHECK(total > 0);
+	CHECK(total <= single.pushed);
+
+	queue.flush();
+	CHECK(recorder->order.size() == (uint32_t)(single.pushed + total));
+
+	memdelete(recorder);
+}
+
+} // namespace TestMessageQueue
+
+#endif // TEST_MESSAGE_QUEUE_H
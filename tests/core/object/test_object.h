@@ -33,7 +33,9 @@
 
 #include "core/object/class_db.h"
 #include "core/object/object.h"
+#include "core/object/object_inline_cache.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -289,6 +291,103 @@ TEST_CASE("[Object] Absent name getter") {
 			"The returned value should equal nil variant.");
 }
 
+TEST_CASE("[Object] Inline caches") {
+	GDREGISTER_CLASS(_TestDerivedObject);
+	_TestDerivedObject derived_object;
+	ObjectInlineCache set_cache;
+	ObjectInlineCache get_cache;
+	ObjectInlineCache call_cache;
+	const StringName property = "property";
+	const StringName getter = "get_property";
+
+	// The first round fills the caches, the following ones hit them.
+	for (int i = 0; i < 3; i++) {
+		bool valid = false;
+		derived_object.set_cached(set_cache, property, i, &valid);
+		CHECK(valid);
+		CHECK(derived_object.get_property() == i);
+
+		valid = false;
+		CHECK(derived_object.get_cached(get_cache, property, &valid) == Variant(i));
+		CHECK(valid);
+
+		Callable::CallError ce;
+		CHECK(derived_object.callp_cached(call_cache, getter, nullptr, 0, ce) == Variant(i));
+		CHECK(ce.error == Callable::CallError::CALL_OK);
+	}
+
+	SUBCASE("Entries only match the class they were filled for") {
+		Object object;
+		bool valid = true;
+		object.get_cached(get_cache, property, &valid);
+		CHECK_FALSE(valid);
+
+		Callable::CallError ce;
+		object.callp_cached(call_cache, getter, nullptr, 0, ce);
+		CHECK(ce.error == Callable::CallError::CALL_ERROR_INVALID_METHOD);
+	}
+
+	SUBCASE("Script instances handling the name take precedence") {
+		_MockScriptInstance *script_instance = memnew(_MockScriptInstance);
+		script_instance->set(property, 42);
+		derived_object.set_script_instance(script_instance);
+		CHECK(derived_object.get_cached(get_cache, property) == Variant(42));
+	}
+
+	SUBCASE("Invalidated entries are filled again") {
+		ObjectInlineCache::invalidate_all();
+		derived_object.set_property(7);
+		CHECK(derived_object.get_cached(get_cache, property) == Variant(7));
+	}
+
+	SUBCASE("Names taking the generic path are remembered") {
+		ObjectInlineCache absent_cache;
+		MethodBind *method = nullptr;
+		for (int i = 0; i < 2; i++) {
+			Callable::CallError ce;
+			derived_object.callp_cached(absent_cache, "absent_method", nullptr, 0, ce);
+			CHECK(ce.error == Callable::CallError::CALL_ERROR_INVALID_METHOD);
+			CHECK(absent_cache.lookup(&derived_object.get_class_name(), nullptr, method));
+			CHECK(method == nullptr);
+		}
+
+		ObjectInlineCache::invalidate_all();
+		CHECK_FALSE(absent_cache.lookup(&derived_object.get_class_name(), nullptr, method));
+	}
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Object] Inline cache dispatch") {
+	GDREGISTER_CLASS(_TestDerivedObject);
+	_TestDerivedObject derived_object;
+	derived_object.set_property(1);
+	ObjectInlineCache get_cache;
+	ObjectInlineCache call_cache;
+	const StringName property = "property";
+	const StringName getter = "get_property";
+	const int iterations = 1000000;
+	int64_t sum = 0;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		Callable::CallError ce;
+		sum += (int64_t)derived_object.callp(getter, nullptr, 0, ce);
+		sum += (int64_t)derived_object.get(property);
+	}
+	uint64_t uncached_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		Callable::CallError ce;
+		sum += (int64_t)derived_object.callp_cached(call_cache, getter, nullptr, 0, ce);
+		sum += (int64_t)derived_object.get_cached(get_cache, property);
+	}
+	uint64_t cached_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(sum == (int64_t)iterations * 4);
+	MESSAGE(vformat("%d calls and gets: %d usec uncached, %d usec with inline caches.",
+			iterations, (int64_t)uncached_usec, (int64_t)cached_usec));
+}
+
 TEST_CASE("[Object] Signals") {
 	Object object;
 
@@ -431,6 +530,149 @@ TEST_CASE("[Object] Signals") {
 	}
 }
 
+class _SignalReceiver : public Object {
+	GDCLASS(_SignalReceiver, Object);
+
+public:
+	int calls = 0;
+	Object *emitter = nullptr;
+	_SignalReceiver *to_disconnect = nullptr;
+	_SignalReceiver *to_connect = nullptr;
+
+	void on_signal() {
+		calls++;
+		if (to_disconnect) {
+			emitter->disconnect("my_custom_signal", callable_mp(to_disconnect, &_SignalReceiver::on_signal));
+			to_disconnect = nullptr;
+		}
+		if (to_connect) {
+			emitter->connect("my_custom_signal", callable_mp(to_connect, &_SignalReceiver::on_signal));
+			to_connect = nullptr;
+		}
+	}
+	void on_signal_bound(const Ref<RefCounted> &p_ref) {
+		calls++;
+	}
+};
+
+TEST_CASE("[Object] Signal IDs") {
+	Object object;
+	object.add_user_signal(MethodInfo("my_custom_signal"));
+	_SignalReceiver receiver;
+	object.connect("my_custom_signal", callable_mp(&receiver, &_SignalReceiver::on_signal));
+
+	Object::SignalID signal_id = object.get_signal_id("my_custom_signal");
+	REQUIRE(signal_id.is_valid());
+	CHECK(signal_id.get_name() == StringName("my_custom_signal"));
+
+	SUBCASE("Emitting through an ID calls the connected methods") {
+		CHECK(object.emit_signal(signal_id) == OK);
+		CHECK(object.emit_signal(signal_id) == OK);
+		CHECK(receiver.calls == 2);
+
+		object.disconnect("my_custom_signal", callable_mp(&receiver, &_SignalReceiver::on_signal));
+		CHECK(object.emit_signal(signal_id) == OK);
+		CHECK(receiver.calls == 2);
+
+		object.connect("my_custom_signal", callable_mp(&receiver, &_SignalReceiver::on_signal), Object::CONNECT_ONE_SHOT);
+		CHECK(object.emit_signal(signal_id) == OK);
+		CHECK(object.emit_signal(signal_id) == OK);
+		CHECK(receiver.calls == 3);
+		CHECK_FALSE(object.is_connected("my_custom_signal", callable_mp(&receiver, &_SignalReceiver::on_signal)));
+	}
+
+	SUBCASE("IDs of built-in signals stay valid without connections") {
+		Object::SignalID script_changed = object.get_signal_id("script_changed");
+		REQUIRE(script_changed.is_valid());
+
+		_SignalReceiver other;
+		object.connect("script_changed", callable_mp(&other, &_SignalReceiver::on_signal));
+		CHECK(object.emit_signal(script_changed) == OK);
+		object.disconnect("script_changed", callable_mp(&other, &_SignalReceiver::on_signal));
+		CHECK(object.emit_signal(script_changed) == OK);
+		object.connect("script_changed", callable_mp(&other, &_SignalReceiver::on_signal));
+		CHECK(object.emit_signal(script_changed) == OK);
+		CHECK(other.calls == 2);
+	}
+
+	SUBCASE("Connection changes during an emission apply to the next one") {
+		_SignalReceiver disconnected;
+		_SignalReceiver connected;
+		object.connect("my_custom_signal", callable_mp(&disconnected, &_SignalReceiver::on_signal));
+		receiver.emitter = &object;
+		receiver.to_disconnect = &disconnected;
+		receiver.to_connect = &connected;
+
+		// Whether `disconnected` runs before or after `receiver`, it's still part of this emission.
+		CHECK(object.emit_signal(signal_id) == OK);
+		CHECK(receiver.calls == 1);
+		CHECK(disconnected.calls == 1);
+		CHECK(connected.calls == 0);
+
+		CHECK(object.emit_signal(signal_id) == OK);
+		CHECK(receiver.calls == 2);
+		CHECK(disconnected.calls == 1);
+		CHECK(connected.calls == 1);
+	}
+
+	SUBCASE("Disconnecting releases bound arguments without another emission") {
+		Ref<RefCounted> bound;
+		bound.instantiate();
+		_SignalReceiver other;
+		object.connect("my_custom_signal", callable_mp(&other, &_SignalReceiver::on_signal_bound).bind(bound));
+		CHECK(object.emit_signal(signal_id) == OK);
+		CHECK(other.calls == 1);
+		CHECK(bound->get_reference_count() > 1);
+
+		// Bound callables are disconnected through their unbound base.
+		object.disconnect("my_custom_signal", callable_mp(&other, &_SignalReceiver::on_signal_bound));
+		CHECK(bound->get_reference_count() == 1);
+	}
+
+	SUBCASE("IDs are checked against the object") {
+		Object other;
+		other.add_user_signal(MethodInfo("my_custom_signal"));
+		ERR_PRINT_OFF;
+		CHECK(other.emit_signal(signal_id) == ERR_INVALID_PARAMETER);
+		CHECK_FALSE(object.get_signal_id("nonexistent_signal").is_valid());
+		CHECK(object.emit_signal(Object::SignalID()) == ERR_INVALID_PARAMETER);
+		ERR_PRINT_ON;
+		CHECK(receiver.calls == 0);
+	}
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Object] Signal emission throughput") {
+	Object object;
+	object.add_user_signal(MethodInfo("my_custom_signal"));
+	_SignalReceiver receivers[8];
+	for (_SignalReceiver &receiver : receivers) {
+		object.connect("my_custom_signal", callable_mp(&receiver, &_SignalReceiver::on_signal));
+	}
+
+	const int emissions = 200000;
+	const StringName name = "my_custom_signal";
+	Object::SignalID signal_id = object.get_signal_id(name);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < emissions; i++) {
+		object.emit_signal(name);
+	}
+	uint64_t name_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < emissions; i++) {
+		object.emit_signal(signal_id);
+	}
+	uint64_t id_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	for (const _SignalReceiver &receiver : receivers) {
+		CHECK(receiver.calls == emissions * 2);
+	}
+
+	MESSAGE(vformat("%d emissions to %d connections: by name in %d usec, by SignalID in %d usec.",
+			emissions, (int64_t)std::size(receivers), (int64_t)name_usec, (int64_t)id_usec));
+}
+
 class NotificationObject1 : public Object {
 	GDCLASS(NotificationObject1, Object);
 
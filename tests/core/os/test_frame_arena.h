@@ -0,0 +1,175 @@
+/**************************************************************************/
+/*  test_frame_arena.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FRAME_ARENA_H
+#define TEST_FRAME_ARENA_H
+
+#include "core/os/frame_arena.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Allocate, grow and free") {
+	// Allocations still alive on this thread keep the arena from starting over.
+	const uint32_t live_at_start = FrameArena::get_thread_live_allocation_count();
+
+	uint8_t *a = (uint8_t *)FrameArena::alloc(16);
+	REQUIRE(a != nullptr);
+	CHECK((uintptr_t)a % alignof(max_align_t) == 0);
+	for (int i = 0; i < 16; i++) {
+		a[i] = i;
+	}
+
+	// Last allocation, so it grows in place.
+	uint8_t *grown = (uint8_t *)FrameArena::realloc(a, 256);
+	CHECK(grown == a);
+
+	uint8_t *b = (uint8_t *)FrameArena::alloc(16);
+	CHECK(b != a);
+
+	// Not the last allocation anymore, so it has to move while keeping the contents.
+	uint8_t *moved = (uint8_t *)FrameArena::realloc(grown, 1024);
+	REQUIRE(moved != nullptr);
+	bool contents_kept = true;
+	for (int i = 0; i < 16; i++) {
+		contents_kept &= moved[i] == i;
+	}
+	CHECK(contents_kept);
+
+	FrameArena::free(b);
+	FrameArena::free(moved);
+
+	CHECK(FrameArena::get_thread_live_allocation_count() == live_at_start);
+
+	if (live_at_start == 0) {
+		// Everything was freed, so the arena starts over.
+		uint8_t *c = (uint8_t *)FrameArena::alloc(16);
+		CHECK(c == a);
+		FrameArena::free(c);
+	}
+}
+
+TEST_CASE("[FrameArena] Large allocations") {
+	// Bigger than a chunk, but still served by the arena.
+	uint8_t *big = (uint8_t *)FrameArena::alloc(1024 * 1024);
+	REQUIRE(big != nullptr);
+	big[1024 * 1024 - 1] = 42;
+
+	// Too big for the arena, falls back to the heap transparently.
+	uint8_t *huge = (uint8_t *)FrameArena::alloc(32 * 1024 * 1024);
+	REQUIRE(huge != nullptr);
+	huge[32 * 1024 * 1024 - 1] = 42;
+
+	FrameArena::free(huge);
+	FrameArena::free(big);
+}
+
+TEST_CASE("[FrameArena] Idle chunks are released") {
+	const uint32_t live_at_start = FrameArena::get_thread_live_allocation_count();
+	const size_t reserved_at_start = FrameArena::get_thread_reserved_bytes();
+
+	// Bigger than anything reserved so far, so it needs a chunk of its own.
+	const size_t burst_size = MAX(reserved_at_start, (size_t)1024 * 1024) + 1;
+	FrameArena::free(FrameArena::alloc(burst_size));
+	const size_t reserved_after_burst = FrameArena::get_thread_reserved_bytes();
+	CHECK(reserved_after_burst > reserved_at_start);
+	CHECK(FrameArena::get_thread_live_allocation_count() == live_at_start);
+
+	if (live_at_start == 0) {
+		// Used once more right away, so it's kept.
+		FrameArena::free(FrameArena::alloc(8));
+		CHECK(FrameArena::get_thread_reserved_bytes() == reserved_after_burst);
+
+		for (uint64_t i = 0; i <= FrameArena::CHUNK_IDLE_FRAMES; i++) {
+			FrameArena::end_frame();
+		}
+		FrameArena::free(FrameArena::alloc(8));
+		CHECK(FrameArena::get_thread_reserved_bytes() < reserved_after_burst);
+	}
+}
+
+static void free_from_thread(void *p_memory) {
+	FrameArena::free(p_memory);
+}
+
+TEST_CASE("[FrameArena] Free from another thread") {
+	void *a = FrameArena::alloc(64);
+	void *b = FrameArena::alloc(64);
+
+	Thread thread;
+	thread.start(free_from_thread, a);
+	thread.wait_to_finish();
+
+	// b is still alive, so the arena must not start over.
+	void *c = FrameArena::alloc(64);
+	CHECK(c != a);
+	CHECK(c != b);
+
+	FrameArena::free(c);
+	FrameArena::free(b);
+}
+
+TEST_CASE("[FrameArena] Containers") {
+	FrameLocalVector<int> vector;
+	for (int i = 0; i < 1000; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.size() == 1000);
+	CHECK(vector[999] == 999);
+
+	FrameHashMap<int, String> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i, itos(i));
+	}
+	CHECK(map.size() == 100);
+	CHECK(map[42] == "42");
+	map.erase(42);
+	CHECK_FALSE(map.has(42));
+	map.clear();
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[FrameArena] Statistics") {
+	FrameArena::end_frame();
+	for (int i = 0; i < 10; i++) {
+		FrameArena::free(FrameArena::alloc(8));
+	}
+	FrameArena::end_frame();
+	CHECK(FrameArena::get_last_frame_allocation_count() == 10);
+	CHECK(FrameArena::get_last_frame_allocated_bytes() == 80);
+	FrameArena::end_frame();
+	CHECK(FrameArena::get_last_frame_allocation_count() == 0);
+}
+
+} // namespace TestFrameArena
+
+#endif // TEST_FRAME_ARENA_H
@@ -0,0 +1,85 @@
+/**************************************************************************/
+/*  test_heap_profiler.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_HEAP_PROFILER_H
+#define TEST_HEAP_PROFILER_H
+
+#include "core/os/heap_profiler.h"
+#include "core/os/memory.h"
+
+#include "tests/test_macros.h"
+
+namespace TestHeapProfiler {
+
+static const HeapProfiler::TagStats *find_tag(const HeapProfiler::TagStats *p_stats, int p_count, const char *p_name) {
+	for (int i = 0; i < p_count; i++) {
+		if (p_stats[i].name && strcmp(p_stats[i].name, p_name) == 0) {
+			return &p_stats[i];
+		}
+	}
+	return nullptr;
+}
+
+TEST_CASE("[HeapProfiler] Tagged allocations are counted and released") {
+	REQUIRE_FALSE(HeapProfiler::is_active());
+
+	// Sample every byte so the live estimate is exact enough to check.
+	HeapProfiler::start(1);
+	REQUIRE(HeapProfiler::is_active());
+
+	void *ptr = nullptr;
+	{
+		HEAP_PROFILE_TAG("TestHeapProfiler");
+		ptr = memalloc(64 * 1024);
+	}
+
+	HeapProfiler::TagStats stats[HeapProfiler::MAX_TAGS];
+	int count = HeapProfiler::get_tag_stats(stats, HeapProfiler::MAX_TAGS);
+	const HeapProfiler::TagStats *tag = find_tag(stats, count, "TestHeapProfiler");
+	REQUIRE(tag != nullptr);
+	CHECK(tag->alloc_count == 1);
+	CHECK(tag->alloc_bytes == 64 * 1024);
+	CHECK(tag->live_bytes >= 64 * 1024);
+
+	memfree(ptr);
+
+	count = HeapProfiler::get_tag_stats(stats, HeapProfiler::MAX_TAGS);
+	tag = find_tag(stats, count, "TestHeapProfiler");
+	REQUIRE(tag != nullptr);
+	CHECK(tag->alloc_count == 1);
+	CHECK(tag->live_bytes == 0);
+
+	HeapProfiler::stop();
+	CHECK_FALSE(HeapProfiler::is_active());
+}
+
+} // namespace TestHeapProfiler
+
+#endif // TEST_HEAP_PROFILER_H
@@ -0,0 +1,230 @@
+/**************************************************************************/
+/*  test_compact_string.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_COMPACT_STRING_H
+#define TEST_COMPACT_STRING_H
+
+#include "core/os/os.h"
+#include "core/string/compact_string.h"
+#include "core/templates/hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCompactString {
+
+TEST_CASE("[CompactString] Storage form") {
+	CompactString ascii = "node_name";
+	CHECK(ascii.is_compact());
+	CHECK(ascii.length() == 9);
+	CHECK(ascii.get_storage_size() == 9);
+
+	CompactString latin1 = String::utf8("café");
+	CHECK(latin1.is_compact());
+	CHECK(latin1.length() == 4);
+	CHECK(latin1[3] == U'é');
+
+	CompactString wide = String::utf8("ключ");
+	CHECK_FALSE(wide.is_compact());
+	CHECK(wide.length() == 4);
+	CHECK(wide.get_storage_size() == 16);
+
+	CHECK(CompactString().is_compact());
+	CHECK(CompactString().is_empty());
+}
+
+TEST_CASE("[CompactString] Conversions round-trip") {
+	for (const String &s : { String("plain ascii"), String::utf8("naïve façade"), String::utf8("混合 text"), String() }) {
+		CompactString c(s);
+		CHECK(c.to_string() == s);
+		CHECK(c == s);
+		CHECK(s == c);
+		CHECK(c.hash() == s.hash());
+		CHECK(String::utf8(c.utf8().get_data()) == s);
+		CHECK(CompactString::from_utf8(s.utf8().get_data()) == c);
+	}
+
+	HashMap<CompactString, int, CompactStringHasher> map;
+	map[CompactString("key")] = 1;
+	map[CompactString(String::utf8("clé"))] = 2;
+	CHECK(map[CompactString("key")] == 1);
+	CHECK(map[CompactString(String::utf8("clé"))] == 2);
+}
+
+TEST_CASE("[CompactString] Comparison") {
+	CHECK(CompactString("abc") == CompactString("abc"));
+	CHECK(CompactString("abc") != CompactString("abd"));
+	CHECK(CompactString("abc") == "abc");
+	CHECK(CompactString(String::utf8("ключ")) != CompactString("key"));
+	CHECK(CompactString("abc") < CompactString("abd"));
+	CHECK(CompactString("ab") < CompactString("abc"));
+	CHECK(CompactString("z") < CompactString(String::utf8("é")));
+	CHECK(CompactString(String::utf8("é")) < CompactString(String::utf8("ключ")));
+}
+
+TEST_CASE("[CompactString] Find, substr and concatenation") {
+	CompactString s = "Hello, World! Hello!";
+	CHECK(s.find("Hello") == 0);
+	CHECK(s.find("Hello", 1) == 14);
+	CHECK(s.find("hello") == -1);
+	CHECK(s.find("") == -1);
+	CHECK(s.find(String::utf8("ключ")) == -1);
+	CHECK(s.find_char('W') == 7);
+	CHECK(s.find_char(U'ю') == -1);
+	CHECK(s.begins_with("Hello,"));
+	CHECK(s.substr(7, 5) == "World");
+	CHECK(s.substr(14) == "Hello!");
+
+	CompactString wide = String::utf8("ключ=значение");
+	CHECK(wide.find("=") == 4);
+	CHECK(wide.substr(0, 4) == String::utf8("ключ"));
+
+	// Concatenating ASCII keeps the compact form, anything wide widens the result.
+	CompactString joined = CompactString("key") + CompactString("=value");
+	CHECK(joined.is_compact());
+	CHECK(joined == "key=value");
+	joined += CompactString(String::utf8(" ключ"));
+	CHECK_FALSE(joined.is_compact());
+	CHECK(joined == String::utf8("key=value ключ"));
+
+	// A wide substring that fits in Latin-1 goes back to the compact form.
+	CHECK_FALSE(wide.substr(5).is_compact());
+	CHECK(joined.substr(0, 9).is_compact());
+}
+
+TEST_CASE("[CompactString] Split matches String") {
+	const String sources[] = { "a,b,,c", ",a,", "", "no_separator", String::utf8("á,ключ,c") };
+	for (const String &source : sources) {
+		for (int maxsplit : { 0, 1, 2 }) {
+			for (bool allow_empty : { true, false }) {
+				Vector<String> expected = source.split(",", allow_empty, maxsplit);
+				Vector<CompactString> parts = CompactString(source).split(",", allow_empty, maxsplit);
+				REQUIRE(parts.size() == expected.size());
+				for (int i = 0; i < parts.size(); i++) {
+					CHECK(parts[i] == expected[i]);
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("[CompactString] Long ASCII text matches String") {
+	String line;
+	for (int i = 0; i < 64; i++) {
+		line += vformat("{\"id\": %d, \"name\": \"node_%d\", \"visible\": true},", i, i);
+	}
+	const CompactString compact_line = line;
+
+	CHECK(compact_line.is_compact());
+	CHECK(compact_line.get_storage_size() < line.length() * (int)sizeof(char32_t));
+	CHECK(compact_line.find("\"node_63\"") == line.find("\"node_63\""));
+	CHECK(compact_line.split(",").size() == line.split(",").size());
+	CHECK((compact_line + compact_line) == (line + line));
+	CHECK(compact_line.hash() == line.hash());
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][CompactString] Memory and throughput against String") {
+	String line;
+	for (int i = 0; i < 64; i++) {
+		line += vformat("{\"id\": %d, \"name\": \"node_%d\", \"visible\": true},", i, i);
+	}
+	const CompactString compact_line = line;
+	const int iterations = 2000;
+
+	MESSAGE(vformat("%d characters: String %d bytes, CompactString %d bytes.",
+			line.length(), line.length() * (int)sizeof(char32_t), compact_line.get_storage_size()));
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	int64_t string_found = 0;
+	for (int i = 0; i < iterations; i++) {
+		string_found += line.find("\"node_63\"");
+	}
+	uint64_t string_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	int64_t compact_found = 0;
+	for (int i = 0; i < iterations; i++) {
+		compact_found += compact_line.find("\"node_63\"");
+	}
+	uint64_t compact_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(string_found == compact_found);
+	MESSAGE(vformat("find: String %d usec, CompactString %d usec.", (int64_t)string_usec, (int64_t)compact_usec));
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	int64_t string_parts = 0;
+	for (int i = 0; i < iterations / 10; i++) {
+		string_parts += line.split(",").size();
+	}
+	string_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	int64_t compact_parts = 0;
+	for (int i = 0; i < iterations / 10; i++) {
+		compact_parts += compact_line.split(",").size();
+	}
+	compact_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(string_parts == compact_parts);
+	MESSAGE(vformat("split: String %d usec, CompactString %d usec.", (int64_t)string_usec, (int64_t)compact_usec));
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	int64_t string_length = 0;
+	for (int i = 0; i < iterations; i++) {
+		string_length += (line + line).length();
+	}
+	string_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	int64_t compact_length = 0;
+	for (int i = 0; i < iterations; i++) {
+		compact_length += (compact_line + compact_line).length();
+	}
+	compact_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(string_length == compact_length);
+	MESSAGE(vformat("concatenation: String %d usec, CompactString %d usec.", (int64_t)string_usec, (int64_t)compact_usec));
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	uint32_t string_hash = 0;
+	for (int i = 0; i < iterations; i++) {
+		string_hash ^= line.hash() + i;
+	}
+	string_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	uint32_t compact_hash = 0;
+	for (int i = 0; i < iterations; i++) {
+		compact_hash ^= compact_line.hash() + i;
+	}
+	compact_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(string_hash == compact_hash);
+	MESSAGE(vformat("hash: String %d usec, CompactString %d usec.", (int64_t)string_usec, (int64_t)compact_usec));
+}
+
+} // namespace TestCompactString
+
+#endif // TEST_COMPACT_STRING_H
@@ -1626,6 +1626,49 @@ TEST_CASE("[String] hash") {
 	CHECK(a.hash64() != c.hash64());
 }
 
+TEST_CASE("[String] Scanning functions agree across lengths") {
+	// The scanning functions process several characters per step, so check every alignment of
+	// the interesting character against a plain per-character reference.
+	for (int len = 1; len < 40; len++) {
+		for (int pos = 0; pos < len; pos++) {
+			String s = String("a").repeat(len);
+			s[pos] = 'B';
+
+			CHECK(s.find("B") == pos);
+			CHECK(s.find(String("B")) == pos);
+			CHECK(s.find_char('B') == pos);
+			CHECK(s.findn("b") == pos);
+			CHECK(s.to_lower() == String("a").repeat(len));
+			CHECK(s.is_valid_identifier());
+			CHECK(s.hash() == String::hash(s.utf8().get_data()));
+
+			String wide = s;
+			wide[pos] = U'ж';
+			CHECK_FALSE(String(wide + "-").is_valid_identifier());
+			CHECK(String::utf8(wide.utf8().get_data()) == wide);
+			CHECK(wide.to_lower() == wide);
+		}
+	}
+
+	// U+212A KELVIN SIGN lowercases to 'k'.
+	String kelvin = String("aaaaaaaa") + String::chr(0x212A) + "elvin";
+	CHECK(kelvin.findn("kelvin") == 8);
+	CHECK(String("Cut-Off").findn("cut-off") == 0);
+	CHECK(String("ab").find_char(0) == 2);
+
+	// Long text mixing ASCII runs with wider characters.
+	String csv = "keys,en,fr,de\n";
+	for (int i = 0; i < 50; i++) {
+		csv += vformat(String::utf8("MENU_ITEM_%d,Menu item %d,Élément de menu %d,Menüeintrag %d\n"), i, i, i, i);
+	}
+	const CharString csv_utf8 = csv.utf8();
+	CHECK(String::utf8(csv_utf8.get_data(), csv_utf8.length()) == csv);
+	CHECK(csv.split("\n", false).size() == 51);
+	CHECK(csv.find("MENU_ITEM_49") == csv.rfind("MENU_ITEM_49"));
+	CHECK(csv.findn("menu_item_49") == csv.find("MENU_ITEM_49"));
+	CHECK(csv.replace("MENU_ITEM_", "M").find("MENU_ITEM_") == -1);
+}
+
 TEST_CASE("[String] uri_encode/unescape") {
 	String s = "Godot Engine:'docs'";
 	String t = "Godot%20Engine%3A%27docs%27";
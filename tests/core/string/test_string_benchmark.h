@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*  test_string_benchmark.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_BENCHMARK_H
+#define TEST_STRING_BENCHMARK_H
+
+#include "core/os/os.h"
+#include "core/string/ustring.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringBenchmark {
+
+// Typical text-heavy inputs: a JSON document, a CSV table and translation-like prose.
+static String make_json() {
+	String json = "[";
+	for (int i = 0; i < 500; i++) {
+		json += vformat("{\"id\": %d, \"name\": \"Node_%d\", \"path\": \"res://scenes/level_%d.tscn\", \"visible\": true},", i, i, i % 7);
+	}
+	return json + "]";
+}
+
+static String make_csv() {
+	String csv = "keys,en,fr,de\n";
+	for (int i = 0; i < 500; i++) {
+		csv += vformat("MENU_ITEM_%d,Menu item %d,Élément de menu %d,Menüeintrag %d\n", i, i, i, i);
+	}
+	return csv;
+}
+
+template <typename F>
+static void benchmark(const char *p_name, int p_iterations, F p_func) {
+	int64_t checksum = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < p_iterations; i++) {
+		checksum += p_func();
+	}
+	uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+	MESSAGE(vformat("%s: %d iterations in %d usec (checksum %d).", p_name, p_iterations, (int64_t)usec, checksum));
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][String] Text processing") {
+	const String json = make_json();
+	const String csv = make_csv();
+	const CharString json_utf8 = json.utf8();
+	const CharString csv_utf8 = csv.utf8();
+
+	benchmark("find (miss)", 2000, [&]() { return json.find("\"missing\""); });
+	benchmark("find (last)", 2000, [&]() { return json.find("Node_499"); });
+	benchmark("findn", 2000, [&]() { return json.findn("NODE_499"); });
+	benchmark("find_char", 2000, [&]() { return json.find_char('#'); });
+	benchmark("split (JSON)", 200, [&]() { return json.split(",").size(); });
+	benchmark("split (CSV lines)", 200, [&]() { return csv.split("\n").size(); });
+	benchmark("replace", 200, [&]() { return json.replace("Node_", "N").length(); });
+	benchmark("to_lower", 500, [&]() { return json.to_lower().length(); });
+	benchmark("hash", 2000, [&]() { return (int64_t)json.hash(); });
+	benchmark("utf8 (ASCII)", 500, [&]() { return json.utf8().length(); });
+	benchmark("utf8 (mixed)", 500, [&]() { return csv.utf8().length(); });
+	benchmark("parse_utf8 (ASCII)", 500, [&]() { return String::utf8(json_utf8.get_data(), json_utf8.length()).length(); });
+	benchmark("parse_utf8 (mixed)", 500, [&]() { return String::utf8(csv_utf8.get_data(), csv_utf8.length()).length(); });
+
+	const Vector<String> words = json.split("\"");
+	benchmark("is_valid_identifier", 200, [&]() {
+		int64_t valid = 0;
+		for (const String &word : words) {
+			valid += word.is_valid_identifier();
+		}
+		return valid;
+	});
+
+	CHECK(String::utf8(json_utf8.get_data()) == json);
+	CHECK(String::utf8(csv_utf8.get_data()) == csv);
+}
+
+} // namespace TestStringBenchmark
+
+#endif // TEST_STRING_BENCHMARK_H
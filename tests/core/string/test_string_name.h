@@ -0,0 +1,175 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	StringName a = "test_string_name_interning";
+	StringName b = String("test_string_name_interning");
+	StringName c = StringName::search("test_string_name_interning");
+	CHECK(a == b);
+	CHECK(a == c);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a == "test_string_name_interning");
+	CHECK(a.hash() == String("test_string_name_interning").hash());
+
+	CHECK(StringName::search("test_string_name_never_created") == StringName());
+	CHECK(StringName("") == StringName());
+}
+
+TEST_CASE("[StringName] Released names can be created again") {
+	const void *first = nullptr;
+	{
+		StringName name = "test_string_name_released";
+		first = name.data_unique_pointer();
+		CHECK(first != nullptr);
+	}
+	CHECK(StringName::search("test_string_name_released") == StringName());
+
+	StringName again = "test_string_name_released";
+	CHECK(again == "test_string_name_released");
+	CHECK(StringName::search("test_string_name_released") == again);
+}
+
+TEST_CASE("[StringName] Table growth keeps every name") {
+	const int count = 20000;
+	Vector<StringName> names;
+	names.resize(count);
+	for (int i = 0; i < count; i++) {
+		names.write[i] = StringName(vformat("test_string_name_growth_%d", i));
+	}
+
+	bool all_found = true;
+	for (int i = 0; i < count; i++) {
+		StringName found = StringName::search(vformat("test_string_name_growth_%d", i));
+		all_found &= found == names[i] && found.data_unique_pointer() == names[i].data_unique_pointer();
+	}
+	CHECK(all_found);
+}
+
+struct ThreadedInterning {
+	static const int NAMES = 64;
+
+	Vector<String> strings;
+	Vector<StringName> keep_alive;
+	const void *pointers[NAMES] = {};
+	SafeNumeric<uint32_t> mismatches;
+	int rounds = 200;
+	bool unique_names = false;
+
+	ThreadedInterning() {
+		for (int i = 0; i < NAMES; i++) {
+			strings.push_back(vformat("test_string_name_threaded_%d", i));
+			keep_alive.push_back(StringName(strings[i]));
+			pointers[i] = keep_alive[i].data_unique_pointer();
+		}
+	}
+
+	void check() {
+		CHECK(mismatches.get() == 0);
+		for (int i = 0; i < NAMES; i++) {
+			CHECK(StringName::search(strings[i]).data_unique_pointer() == pointers[i]);
+		}
+	}
+
+	static void thread_func(void *p_userdata) {
+		ThreadedInterning *self = (ThreadedInterning *)p_userdata;
+		uint64_t id = Thread::get_caller_id();
+		for (int round = 0; round < self->rounds; round++) {
+			for (int i = 0; i < NAMES; i++) {
+				if (self->unique_names) {
+					// Created and released right away, exercises insertion and removal.
+					StringName name = self->strings[i] + itos(id);
+					if (name.hash() != String(name).hash()) {
+						self->mismatches.increment();
+					}
+				} else {
+					StringName name = self->strings[i];
+					if (name.data_unique_pointer() != self->pointers[i]) {
+						self->mismatches.increment();
+					}
+				}
+			}
+		}
+	}
+
+	uint64_t run(int p_threads) {
+		Vector<Thread *> threads;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < p_threads; i++) {
+			Thread *thread = memnew(Thread);
+			thread->start(thread_func, this);
+			threads.push_back(thread);
+		}
+		for (Thread *thread : threads) {
+			thread->wait_to_finish();
+			memdelete(thread);
+		}
+		return OS::get_singleton()->get_ticks_usec() - begin;
+	}
+};
+
+TEST_CASE("[StringName] Concurrent lookups, creation and release") {
+	ThreadedInterning shared;
+	shared.unique_names = false;
+	shared.run(4);
+	shared.unique_names = true;
+	shared.run(4);
+	shared.check();
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][StringName] Concurrent lookups, creation and release") {
+	ThreadedInterning shared;
+	shared.rounds = 2000;
+	for (int threads : { 1, 2, 4, 8, 16 }) {
+		shared.unique_names = false;
+		uint64_t lookup_usec = shared.run(threads);
+		shared.unique_names = true;
+		uint64_t churn_usec = shared.run(threads);
+
+		const int64_t operations = (int64_t)threads * shared.rounds * ThreadedInterning::NAMES;
+		MESSAGE(vformat("%d thread(s), %d StringNames each: existing names in %d usec, created and released in %d usec.",
+				threads, operations / threads, (int64_t)lookup_usec, (int64_t)churn_usec));
+	}
+	shared.check();
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
@@ -125,6 +125,9 @@ public:
 
 	int func1_count = 0;
 
+	SharedThreadState(CommandQueueMT::ProducerMode p_producer_mode = CommandQueueMT::PRODUCER_MODE_LOCKED) :
+			command_queue(p_producer_mode) {}
+
 	void func1(Transform3D t) {
 		func1_count++;
 	}
@@ -246,10 +249,10 @@ public:
 	}
 };
 
-static void test_command_queue_basic(bool p_use_thread_pool_sync) {
+static void test_command_queue_basic(bool p_use_thread_pool_sync, CommandQueueMT::ProducerMode p_producer_mode = CommandQueueMT::PRODUCER_MODE_LOCKED) {
 	const char *COMMAND_QUEUE_SETTING = "memory/limits/command_queue/multithreading_queue_size_kb";
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING, 1);
-	SharedThreadState sts;
+	SharedThreadState sts(p_producer_mode);
 	sts.init_threads(p_use_thread_pool_sync);
 
 	sts.add_msg_to_write(SharedThreadState::TEST_MSG_FUNC1_TRANSFORM);
@@ -296,6 +299,14 @@ TEST_CASE("[CommandQueue] Test Queue Basics with WorkerThreadPool sync.") {
 	test_command_queue_basic(true);
 }
 
+TEST_CASE("[CommandQueue] Test Queue Basics in lock-free mode") {
+	test_command_queue_basic(false, CommandQueueMT::PRODUCER_MODE_LOCK_FREE);
+}
+
+TEST_CASE("[CommandQueue] Test Queue Basics in lock-free mode with WorkerThreadPool sync.") {
+	test_command_queue_basic(true, CommandQueueMT::PRODUCER_MODE_LOCK_FREE);
+}
+
 TEST_CASE("[CommandQueue] Test Queue Wrapping to same spot.") {
 	const char *COMMAND_QUEUE_SETTING = "memory/limits/command_queue/multithreading_queue_size_kb";
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING, 1);
@@ -446,6 +457,122 @@ TEST_CASE("[Stress][CommandQueue] Stress test command queue") {
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING,
 			ProjectSettings::get_singleton()->property_get_revert(COMMAND_QUEUE_SETTING));
 }
+
+class MultiProducerState {
+public:
+	static const uint32_t MAX_PRODUCERS = 16;
+
+	CommandQueueMT command_queue;
+	uint32_t commands_per_producer = 0;
+	bool with_syncs = false;
+
+	// Only touched by the consumer.
+	uint32_t next_sequence[MAX_PRODUCERS] = {};
+	uint32_t consumed = 0;
+	uint32_t order_errors = 0;
+
+	SafeFlag consumer_exit;
+
+	struct ProducerArg {
+		MultiProducerState *state = nullptr;
+		uint32_t index = 0;
+	};
+
+	MultiProducerState(CommandQueueMT::ProducerMode p_producer_mode) :
+			command_queue(p_producer_mode) {}
+
+	void consume(uint32_t p_producer, uint32_t p_sequence) {
+		if (next_sequence[p_producer] != p_sequence) {
+			order_errors++;
+		}
+		next_sequence[p_producer] = p_sequence + 1;
+		consumed++;
+	}
+
+	static void producer_func(void *p_userdata) {
+		ProducerArg *arg = static_cast<ProducerArg *>(p_userdata);
+		MultiProducerState *state = arg->state;
+		for (uint32_t i = 0; i < state->commands_per_producer; i++) {
+			if (state->with_syncs && (i % 64) == 63) {
+				state->command_queue.push_and_sync(state, &MultiProducerState::consume, arg->index, i);
+			} else {
+				state->command_queue.push(state, &MultiProducerState::consume, arg->index, i);
+			}
+		}
+	}
+
+	static void consumer_func(void *p_userdata) {
+		MultiProducerState *state = static_cast<MultiProducerState *>(p_userdata);
+		while (!state->consumer_exit.is_set()) {
+			state->command_queue.flush_all();
+		}
+		state->command_queue.flush_all();
+	}
+
+	// Returns the time it took for all producers to push and the consumer to run all commands.
+	uint64_t run(uint32_t p_producers, uint32_t p_commands_per_producer) {
+		commands_per_producer = p_commands_per_producer;
+		consumer_exit.clear();
+
+		Thread consumer;
+		Thread producers[MAX_PRODUCERS];
+		ProducerArg args[MAX_PRODUCERS];
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		consumer.start(&MultiProducerState::consumer_func, this);
+		for (uint32_t i = 0; i < p_producers; i++) {
+			args[i].state = this;
+			args[i].index = i;
+			producers[i].start(&MultiProducerState::producer_func, &args[i]);
+		}
+		for (uint32_t i = 0; i < p_producers; i++) {
+			producers[i].wait_to_finish();
+		}
+		consumer_exit.set();
+		consumer.wait_to_finish();
+		return OS::get_singleton()->get_ticks_usec() - begin;
+	}
+};
+
+TEST_CASE("[CommandQueue] Lock-free mode keeps the order of each producer") {
+	MultiProducerState state(CommandQueueMT::PRODUCER_MODE_LOCK_FREE);
+	state.with_syncs = true;
+	state.run(4, 4096);
+
+	CHECK(state.consumed == 4 * 4096);
+	CHECK(state.order_errors == 0);
+	for (uint32_t i = 0; i < 4; i++) {
+		CHECK(state.next_sequence[i] == 4096);
+	}
+}
+
+TEST_CASE("[CommandQueue] Locked mode keeps the order of each producer") {
+	MultiProducerState state(CommandQueueMT::PRODUCER_MODE_LOCKED);
+	state.run(4, 4096);
+
+	CHECK(state.consumed == 4 * 4096);
+	CHECK(state.order_errors == 0);
+	for (uint32_t i = 0; i < 4; i++) {
+		CHECK(state.next_sequence[i] == 4096);
+	}
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][CommandQueue] Commands per second with multiple producers") {
+	const uint32_t commands = 1 << 18;
+	const uint32_t producer_counts[] = { 1, 2, 4, 8, 16 };
+	for (uint32_t producers : producer_counts) {
+		uint64_t usec[2];
+		for (int mode = 0; mode < 2; mode++) {
+			MultiProducerState state(mode == 0 ? CommandQueueMT::PRODUCER_MODE_LOCKED : CommandQueueMT::PRODUCER_MODE_LOCK_FREE);
+			usec[mode] = MAX(state.run(producers, commands / producers), (uint64_t)1);
+			CHECK(state.consumed == (commands / producers) * producers);
+			CHECK(state.order_errors == 0);
+		}
+
+		MESSAGE(vformat("%d producer(s): locked %d commands/s, lock-free %d commands/s.",
+				producers, (int64_t)(commands * 1000000ull / usec[0]), (int64_t)(commands * 1000000ull / usec[1])));
+	}
+}
 } // namespace TestCommandQueue
 
 #endif // TEST_COMMAND_QUEUE_H
@@ -31,6 +31,7 @@
 #ifndef TEST_HASH_MAP_H
 #define TEST_HASH_MAP_H
 
+#include "core/os/os.h"
 #include "core/templates/hash_map.h"
 
 #include "tests/test_macros.h"
@@ -128,6 +129,98 @@ TEST_CASE("[HashMap] Const iteration") {
 		++idx;
 	}
 }
+
+struct CollidingHasher {
+	// Few distinct hashes, so that long runs of equal hashes span several
+	// probe groups and wrap around the end of the table.
+	static _FORCE_INLINE_ uint32_t hash(const int p_key) { return uint32_t(p_key) % 7; }
+};
+
+TEST_CASE("[HashMap] Lookup with colliding hashes") {
+	HashMap<int, int, CollidingHasher> map;
+	for (int i = 0; i < 200; i++) {
+		map.insert(i, i * 2);
+	}
+	for (int i = 0; i < 200; i += 3) {
+		map.erase(i);
+	}
+
+	for (int i = 0; i < 200; i++) {
+		if (i % 3 == 0) {
+			CHECK_FALSE(map.has(i));
+		} else {
+			REQUIRE(map.has(i));
+			CHECK(map[i] == i * 2);
+		}
+	}
+	CHECK_FALSE(map.has(200));
+	CHECK_FALSE(map.has(-1));
+}
+
+TEST_CASE("[HashMap] Insert, lookup and erase at different load factors") {
+	const float load_factors[] = { 0.25, 0.5, 0.74 };
+	for (float load_factor : load_factors) {
+		HashMap<uint32_t, uint32_t> map;
+		map.reserve(1 << 12);
+		const uint32_t capacity = map.get_capacity();
+		const uint32_t count = uint32_t(capacity * load_factor);
+
+		for (uint32_t i = 0; i < count; i++) {
+			map.insert(i * 2, i);
+		}
+		CHECK(map.get_capacity() == capacity);
+
+		uint32_t found = 0;
+		for (uint32_t i = 0; i < count * 2; i++) {
+			// Even keys hit, odd keys miss.
+			found += map.has(i) ? 1 : 0;
+		}
+		CHECK(found == count);
+
+		for (uint32_t i = 0; i < count; i++) {
+			map.erase(i * 2);
+		}
+		CHECK(map.is_empty());
+	}
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][HashMap] Throughput at different load factors") {
+	const float load_factors[] = { 0.25, 0.5, 0.74 };
+	for (float load_factor : load_factors) {
+		HashMap<uint32_t, uint32_t> map;
+		map.reserve(1 << 16);
+		const uint32_t capacity = map.get_capacity();
+		const uint32_t count = uint32_t(capacity * load_factor);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < count; i++) {
+			map.insert(i * 2, i);
+		}
+		const uint64_t insert_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		CHECK(map.get_capacity() == capacity);
+
+		uint32_t found = 0;
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int pass = 0; pass < 8; pass++) {
+			for (uint32_t i = 0; i < count * 2; i++) {
+				// Even keys hit, odd keys miss.
+				found += map.has(i) ? 1 : 0;
+			}
+		}
+		const uint64_t lookup_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		CHECK(found == count * 8);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < count; i++) {
+			map.erase(i * 2);
+		}
+		const uint64_t erase_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		CHECK(map.is_empty());
+
+		MESSAGE(vformat("Load factor %.2f (%d elements): insert %d usec, %d lookups %d usec, erase %d usec.",
+				load_factor, count, (int64_t)insert_usec, count * 16, (int64_t)lookup_usec, (int64_t)erase_usec));
+	}
+}
 } // namespace TestHashMap
 
 #endif // TEST_HASH_MAP_H
@@ -221,6 +221,25 @@ TEST_CASE("[HashSet] Copy") {
 	}
 }
 
+struct CollidingHasher {
+	static _FORCE_INLINE_ uint32_t hash(const int p_key) { return uint32_t(p_key) % 7; }
+};
+
+TEST_CASE("[HashSet] Lookup with colliding hashes") {
+	HashSet<int, CollidingHasher> set;
+	for (int i = 0; i < 200; i++) {
+		set.insert(i);
+	}
+	for (int i = 0; i < 200; i += 3) {
+		set.erase(i);
+	}
+
+	for (int i = 0; i < 200; i++) {
+		CHECK(set.has(i) == (i % 3 != 0));
+	}
+	CHECK_FALSE(set.has(200));
+}
+
 } // namespace TestHashSet
 
 #endif // TEST_HASH_SET_H
@@ -0,0 +1,118 @@
+/**************************************************************************/
+/*  test_persistent_hash_map.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PERSISTENT_HASH_MAP_H
+#define TEST_PERSISTENT_HASH_MAP_H
+
+#include "core/templates/persistent_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPersistentHashMap {
+
+TEST_CASE("[PersistentHashMap] Insert, get and erase") {
+	PersistentHashMap<int, int> map;
+	CHECK(map.is_empty());
+
+	for (int i = 0; i < 5000; i++) {
+		map.insert(i, i * 2);
+	}
+	CHECK(map.size() == 5000);
+	CHECK(map.has(42));
+	CHECK(map.get(42) == 84);
+	CHECK(map.getptr(5000) == nullptr);
+
+	map.insert(42, -1);
+	CHECK(map.size() == 5000);
+	CHECK(map.get(42) == -1);
+
+	for (int i = 0; i < 5000; i += 2) {
+		CHECK(map.erase(i));
+	}
+	CHECK_FALSE(map.erase(0));
+	CHECK(map.size() == 2500);
+	CHECK_FALSE(map.has(42));
+	CHECK(map.get(43) == 86);
+
+	int iterated = 0;
+	for (const PersistentHashMap<int, int>::Pair &pair : map) {
+		CHECK(pair.key % 2 == 1);
+		CHECK(pair.value == pair.key * 2);
+		iterated++;
+	}
+	CHECK(iterated == 2500);
+}
+
+TEST_CASE("[PersistentHashMap] Copies are independent") {
+	PersistentHashMap<String, int> map;
+	map.insert("a", 1);
+	map.insert("b", 2);
+
+	PersistentHashMap<String, int> copy = map;
+	copy.insert("a", 10);
+	copy.insert("c", 3);
+	copy.erase("b");
+
+	CHECK(map.size() == 2);
+	CHECK(map.get("a") == 1);
+	CHECK(map.get("b") == 2);
+	CHECK_FALSE(map.has("c"));
+
+	CHECK(copy.size() == 2);
+	CHECK(copy.get("a") == 10);
+	CHECK(copy.get("c") == 3);
+	CHECK_FALSE(copy.has("b"));
+}
+
+struct CollidingHasher {
+	static uint32_t hash(int p_value) { return p_value % 3; }
+};
+
+TEST_CASE("[PersistentHashMap] Full hash collisions") {
+	PersistentHashMap<int, int, CollidingHasher> map;
+	for (int i = 0; i < 30; i++) {
+		map.insert(i, i);
+	}
+	PersistentHashMap<int, int, CollidingHasher> copy = map;
+	for (int i = 0; i < 30; i += 3) {
+		copy.erase(i);
+	}
+
+	CHECK(map.size() == 30);
+	CHECK(copy.size() == 20);
+	for (int i = 0; i < 30; i++) {
+		CHECK(map.get(i) == i);
+		CHECK(copy.has(i) == (i % 3 != 0));
+	}
+}
+
+} // namespace TestPersistentHashMap
+
+#endif // TEST_PERSISTENT_HASH_MAP_H
@@ -0,0 +1,115 @@
+/**************************************************************************/
+/*  test_persistent_vector.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PERSISTENT_VECTOR_H
+#define TEST_PERSISTENT_VECTOR_H
+
+#include "core/templates/persistent_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPersistentVector {
+
+TEST_CASE("[PersistentVector] Push back and get") {
+	PersistentVector<int> vector;
+	CHECK(vector.is_empty());
+
+	// Enough elements for three trie levels.
+	const int count = 40000;
+	for (int i = 0; i < count; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.size() == count);
+	for (int i = 0; i < count; i++) {
+		if (vector[i] != i) {
+			FAIL_CHECK(vformat("Element %d has the wrong value.", i));
+			break;
+		}
+	}
+
+	int expected = 0;
+	for (int value : vector) {
+		if (value != expected) {
+			break;
+		}
+		expected++;
+	}
+	CHECK(expected == count);
+}
+
+TEST_CASE("[PersistentVector] Copies are independent") {
+	PersistentVector<int> vector;
+	for (int i = 0; i < 1000; i++) {
+		vector.push_back(i);
+	}
+
+	PersistentVector<int> copy = vector;
+	copy.set(10, -10);
+	copy.set(999, -999);
+	copy.push_back(1000);
+
+	CHECK(vector.size() == 1000);
+	CHECK(vector[10] == 10);
+	CHECK(vector[999] == 999);
+	CHECK(copy.size() == 1001);
+	CHECK(copy[10] == -10);
+	CHECK(copy[999] == -999);
+	CHECK(copy[1000] == 1000);
+
+	vector.set(10, 20);
+	CHECK(copy[10] == -10);
+	CHECK(vector[10] == 20);
+}
+
+TEST_CASE("[PersistentVector] Pop back") {
+	PersistentVector<int> vector;
+	for (int i = 0; i < 2000; i++) {
+		vector.push_back(i);
+	}
+	PersistentVector<int> snapshot = vector;
+
+	for (int i = 1999; i >= 0; i--) {
+		CHECK(vector[vector.size() - 1] == i);
+		vector.pop_back();
+	}
+	CHECK(vector.is_empty());
+
+	// Growing again after shrinking must not affect the snapshot.
+	for (int i = 0; i < 1100; i++) {
+		vector.push_back(-i);
+	}
+	CHECK(snapshot.size() == 2000);
+	CHECK(snapshot[1050] == 1050);
+	CHECK(vector[1050] == -1050);
+}
+
+} // namespace TestPersistentVector
+
+#endif // TEST_PERSISTENT_VECTOR_H
@@ -0,0 +1,216 @@
+/**************************************************************************/
+/*  test_small_vector.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SMALL_VECTOR_H
+#define TEST_SMALL_VECTOR_H
+
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/small_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSmallVector {
+
+TEST_CASE("[SmallVector] List initialization.") {
+	SmallVector<int, 4> vector{ 0, 1, 2, 3, 4 };
+
+	CHECK(vector.size() == 5);
+	CHECK_FALSE(vector.is_inline());
+	for (int i = 0; i < 5; i++) {
+		CHECK(vector[i] == i);
+	}
+}
+
+TEST_CASE("[SmallVector] Push back and spill to the heap.") {
+	SmallVector<int, 4> vector;
+	CHECK(vector.get_capacity() == 4);
+
+	for (int i = 0; i < 4; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.is_inline());
+	CHECK(vector.size() == 4);
+
+	vector.push_back(4);
+	CHECK_FALSE(vector.is_inline());
+	CHECK(vector.get_capacity() == 8);
+	for (int i = 0; i < 5; i++) {
+		CHECK(vector[i] == i);
+	}
+
+	vector.clear();
+	CHECK(vector.is_empty());
+	CHECK_FALSE(vector.is_inline());
+
+	vector.reset();
+	CHECK(vector.is_inline());
+	CHECK(vector.get_capacity() == 4);
+}
+
+TEST_CASE("[SmallVector] Remove, insert and find.") {
+	SmallVector<int, 8> vector{ 0, 1, 2, 3, 4 };
+
+	vector.remove_at(1);
+	CHECK(vector.size() == 4);
+	CHECK(vector[1] == 2);
+
+	vector.remove_at_unordered(0);
+	CHECK(vector.size() == 3);
+	CHECK(vector[0] == 4);
+
+	vector.insert(1, 7);
+	CHECK(vector[1] == 7);
+	CHECK(vector.find(7) == 1);
+	CHECK(vector.has(3));
+	CHECK_FALSE(vector.has(1));
+
+	CHECK(vector.erase(7));
+	CHECK_FALSE(vector.erase(7));
+
+	vector.sort();
+	CHECK(vector[0] == 2);
+	CHECK(vector[1] == 3);
+	CHECK(vector[2] == 4);
+
+	vector.ordered_insert(0);
+	CHECK(vector[0] == 0);
+
+	vector.invert();
+	CHECK(vector[0] == 4);
+}
+
+TEST_CASE("[SmallVector] Non-trivial elements and copies.") {
+	SmallVector<String, 2> vector;
+	vector.push_back("a");
+	vector.push_back("b");
+	vector.push_back("c");
+
+	SmallVector<String, 2> copy = vector;
+	CHECK(copy.size() == 3);
+	CHECK(copy[2] == "c");
+
+	int iterated = 0;
+	for (const String &E : copy) {
+		CHECK(E == vector[iterated]);
+		iterated++;
+	}
+	CHECK(iterated == 3);
+
+	Vector<String> converted = copy;
+	CHECK(converted.size() == 3);
+	CHECK(converted[1] == "b");
+
+	copy.resize(1);
+	CHECK(copy.size() == 1);
+	CHECK(copy[0] == "a");
+}
+
+struct CountingAllocator {
+	static inline uint64_t allocations = 0;
+
+	static void *alloc(size_t p_memory) {
+		allocations++;
+		return Memory::alloc_static(p_memory, false);
+	}
+	static void *realloc(void *p_ptr, size_t p_memory) {
+		allocations++;
+		return Memory::realloc_static(p_ptr, p_memory, false);
+	}
+	static void free(void *p_ptr) {
+		Memory::free_static(p_ptr, false);
+	}
+};
+
+template <typename V>
+static uint64_t benchmark_fill_and_iterate(uint32_t p_lists, uint32_t p_elements, int64_t &r_sum) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < p_lists; i++) {
+		V list;
+		for (uint32_t j = 0; j < p_elements; j++) {
+			list.push_back(j);
+		}
+		for (uint32_t value : list) {
+			r_sum += value;
+		}
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+TEST_CASE("[SmallVector] Allocations against LocalVector.") {
+	for (uint32_t elements : { 1u, 4u, 8u, 16u }) {
+		int64_t local_sum = 0;
+		int64_t small_sum = 0;
+
+		CountingAllocator::allocations = 0;
+		benchmark_fill_and_iterate<LocalVector<uint32_t, uint32_t, false, false, CountingAllocator>>(100, elements, local_sum);
+		uint64_t local_allocations = CountingAllocator::allocations;
+
+		CountingAllocator::allocations = 0;
+		benchmark_fill_and_iterate<SmallVector<uint32_t, 8, uint32_t, false, CountingAllocator>>(100, elements, small_sum);
+		uint64_t small_allocations = CountingAllocator::allocations;
+
+		CHECK(local_sum == small_sum);
+		if (elements <= 8) {
+			CHECK(small_allocations == 0);
+		}
+		CHECK(small_allocations <= local_allocations);
+	}
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][SmallVector] Allocations and iteration speed against LocalVector.") {
+	const uint32_t lists = 100000;
+
+	for (uint32_t elements : { 1u, 4u, 8u, 16u }) {
+		int64_t local_sum = 0;
+		int64_t small_sum = 0;
+
+		CountingAllocator::allocations = 0;
+		uint64_t local_usec = benchmark_fill_and_iterate<LocalVector<uint32_t, uint32_t, false, false, CountingAllocator>>(lists, elements, local_sum);
+		uint64_t local_allocations = CountingAllocator::allocations;
+
+		CountingAllocator::allocations = 0;
+		uint64_t small_usec = benchmark_fill_and_iterate<SmallVector<uint32_t, 8, uint32_t, false, CountingAllocator>>(lists, elements, small_sum);
+		uint64_t small_allocations = CountingAllocator::allocations;
+
+		CHECK(local_sum == small_sum);
+		if (elements <= 8) {
+			CHECK(small_allocations == 0);
+		}
+		CHECK(small_allocations <= local_allocations);
+
+		MESSAGE(vformat("%d element(s) x %d lists: LocalVector %d allocs in %d usec, SmallVector<8> %d allocs in %d usec.",
+				elements, lists, (int64_t)local_allocations, (int64_t)local_usec, (int64_t)small_allocations, (int64_t)small_usec));
+	}
+}
+
+} // namespace TestSmallVector
+
+#endif // TEST_SMALL_VECTOR_H
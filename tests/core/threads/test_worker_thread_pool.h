@@ -173,6 +173,175 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static SafeNumeric<int> dependency_stage;
+static SafeFlag dependency_order_broken;
+
+static void static_dependency_group_test(void *p_arg, uint32_t p_index) {
+	// Every element of stage N must see all of stage N - 1 done.
+	if (dependency_stage.get() != (int)(uintptr_t)p_arg) {
+		dependency_order_broken.set();
+	}
+	counter[p_index].increment();
+}
+
+static void static_dependency_task_test(void *p_arg) {
+	bool all_done = true;
+	for (uint32_t i = 0; i < counter.size(); i++) {
+		all_done &= counter[i].get() == (int)(uintptr_t)p_arg;
+	}
+	if (!all_done) {
+		dependency_order_broken.set();
+	}
+	for (uint32_t i = 0; i < counter.size(); i++) {
+		counter[i].set(0);
+	}
+	dependency_stage.increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Run tasks and groups after their dependencies") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		const int tasks = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		const bool low_priority = Math::rand() % 2;
+
+		counter.clear();
+		counter.resize(count);
+		dependency_stage.set(0);
+		dependency_order_broken.clear();
+
+		// group(0) -> task -> group(1) -> task -> empty group -> task.
+		LocalVector<WorkerThreadPool::TaskID> ids;
+		LocalVector<WorkerThreadPool::TaskID> dependencies;
+		ids.push_back(WorkerThreadPool::get_singleton()->add_native_group_task(static_dependency_group_test, (void *)0, count, tasks, !low_priority));
+		dependencies.push_back(ids[ids.size() - 1]);
+		ids.push_back(WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_dependency_task_test, (void *)1, dependencies, low_priority));
+		dependencies[0] = ids[ids.size() - 1];
+		ids.push_back(WorkerThreadPool::get_singleton()->add_native_group_task_with_dependencies(static_dependency_group_test, (void *)1, count, dependencies, tasks, !low_priority));
+		dependencies[0] = ids[ids.size() - 1];
+		ids.push_back(WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_dependency_task_test, (void *)1, dependencies, low_priority));
+		dependencies[0] = ids[ids.size() - 1];
+		ids.push_back(WorkerThreadPool::get_singleton()->add_native_group_task_with_dependencies(static_dependency_group_test, (void *)2, 0, dependencies, tasks, !low_priority));
+		// Depending on several, including one that completes much earlier.
+		dependencies[0] = ids[ids.size() - 1];
+		dependencies.push_back(ids[0]);
+		WorkerThreadPool::TaskID last_id = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_dependency_task_test, (void *)0, dependencies, low_priority);
+
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(last_id);
+		CHECK(dependency_stage.get() == 3);
+		CHECK_FALSE(dependency_order_broken.is_set());
+
+		for (uint32_t i = 0; i < ids.size(); i++) {
+			if (i % 2) {
+				WorkerThreadPool::get_singleton()->wait_for_task_completion(ids[i]);
+			} else {
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(ids[i]);
+			}
+		}
+	}
+}
+
+static void static_empty_task(void *p_arg) {
+}
+
+static void static_empty_group_task(void *p_arg, uint32_t p_index) {
+}
+
+TEST_CASE("[WorkerThreadPool] Reject invalid dependencies") {
+	WorkerThreadPool::TaskID awaited = WorkerThreadPool::get_singleton()->add_native_task(static_empty_task, nullptr);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(awaited);
+
+	LocalVector<WorkerThreadPool::TaskID> dependencies;
+	dependencies.push_back(WorkerThreadPool::INVALID_TASK_ID);
+	ERR_PRINT_OFF;
+	CHECK(WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_empty_task, nullptr, dependencies) == WorkerThreadPool::INVALID_TASK_ID);
+	dependencies[0] = awaited;
+	CHECK(WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_empty_task, nullptr, dependencies) == WorkerThreadPool::INVALID_TASK_ID);
+	CHECK(WorkerThreadPool::get_singleton()->add_native_group_task_with_dependencies(static_empty_group_task, nullptr, 4, dependencies) == WorkerThreadPool::INVALID_TASK_ID);
+	ERR_PRINT_ON;
+}
+
+static SafeNumeric<uint64_t> stress_counter;
+
+static void static_stress_leaf_task(void *p_arg) {
+	stress_counter.increment();
+}
+
+static void static_stress_spawner_task(void *p_arg) {
+	// Posted from a pool thread, so these go through its local queue and are stolen by idle threads.
+	const uint32_t leaf_count = (uintptr_t)p_arg;
+	LocalVector<WorkerThreadPool::TaskID> leaf_ids;
+	leaf_ids.resize(leaf_count);
+	for (uint32_t i = 0; i < leaf_count; i++) {
+		leaf_ids[i] = WorkerThreadPool::get_singleton()->add_native_task(static_stress_leaf_task, nullptr, true);
+	}
+	for (uint32_t i = 0; i < leaf_count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(leaf_ids[i]);
+	}
+}
+
+static void static_stress_group_task(void *p_arg, uint32_t p_index) {
+	stress_counter.increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Nested tasks and groups as the thread count grows") {
+	const int thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+	const uint32_t leaf_count = 64;
+	const uint32_t group_elements = 4096;
+
+	for (int used_threads = 1; used_threads <= MAX(1, thread_count); used_threads *= 2) {
+		stress_counter.set(0);
+		LocalVector<WorkerThreadPool::TaskID> spawner_ids;
+		for (int i = 0; i < used_threads; i++) {
+			spawner_ids.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_stress_spawner_task, (void *)(uintptr_t)leaf_count, true));
+		}
+		for (uint32_t i = 0; i < spawner_ids.size(); i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(spawner_ids[i]);
+		}
+		CHECK(stress_counter.get() == used_threads * leaf_count);
+
+		stress_counter.set(0);
+		WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_native_group_task(static_stress_group_task, nullptr, group_elements, used_threads, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+		CHECK(stress_counter.get() == group_elements);
+	}
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][WorkerThreadPool] Throughput as the thread count grows") {
+	const int thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+	const uint32_t leaf_count = 256;
+	const uint32_t group_elements = 65536;
+
+	for (int used_threads = 1; used_threads <= MAX(1, thread_count); used_threads *= 2) {
+		stress_counter.set(0);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		LocalVector<WorkerThreadPool::TaskID> spawner_ids;
+		for (int i = 0; i < used_threads; i++) {
+			spawner_ids.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_stress_spawner_task, (void *)(uintptr_t)leaf_count, true));
+		}
+		for (uint32_t i = 0; i < spawner_ids.size(); i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(spawner_ids[i]);
+		}
+		uint64_t tasks_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+		CHECK(stress_counter.get() == used_threads * leaf_count);
+
+		stress_counter.set(0);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_native_group_task(static_stress_group_task, nullptr, group_elements, used_threads, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+		uint64_t group_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+		CHECK(stress_counter.get() == group_elements);
+
+		MESSAGE(vformat("%d thread(s): %d tasks/s (nested), %d elements/s (group).",
+				used_threads,
+				(int64_t)(used_threads * leaf_count * 1000000ull / tasks_usec),
+				(int64_t)(group_elements * 1000000ull / group_usec)));
+	}
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
@@ -0,0 +1,196 @@
+/**************************************************************************/
+/*  test_persistent_collections.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PERSISTENT_COLLECTIONS_H
+#define TEST_PERSISTENT_COLLECTIONS_H
+
+#include "core/os/os.h"
+#include "core/variant/persistent_collections.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPersistentCollections {
+
+TEST_CASE("[PersistentArray] Modifications return new arrays") {
+	Array source;
+	source.push_back(1);
+	source.push_back("two");
+	Ref<PersistentArray> array = PersistentArray::from_array(source);
+	CHECK(array->size() == 2);
+	CHECK(array->to_array() == source);
+
+	Ref<PersistentArray> changed = array->set_at(-1, "three")->push_back(4.0);
+	CHECK(array->get_at(1) == Variant("two"));
+	CHECK(changed->size() == 3);
+	CHECK(changed->get_at(1) == Variant("three"));
+	CHECK(changed->get_at(2) == Variant(4.0));
+	CHECK(changed->pop_back()->pop_back()->get_at(0) == Variant(1));
+
+	ERR_PRINT_OFF;
+	CHECK(array->get_at(2) == Variant());
+	CHECK(array->set_at(5, 0).is_null());
+	CHECK(PersistentArray::from_array(Array())->pop_back().is_null());
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[PersistentDictionary] Modifications return new dictionaries") {
+	Dictionary source;
+	source["health"] = 100;
+	source[StringName("position")] = Vector2(1, 2);
+	Ref<PersistentDictionary> dictionary = PersistentDictionary::from_dictionary(source);
+	CHECK(dictionary->size() == 2);
+	CHECK(dictionary->to_dictionary() == source);
+	// String and StringName keys are interchangeable, like in Dictionary.
+	CHECK(dictionary->has("position"));
+
+	Ref<PersistentDictionary> changed = dictionary->set_value("health", 50)->erase("position");
+	CHECK(dictionary->get_value("health") == Variant(100));
+	CHECK(dictionary->has("position"));
+	CHECK(changed->size() == 1);
+	CHECK(changed->get_value("health") == Variant(50));
+	CHECK(changed->get_value("position", -1) == Variant(-1));
+	CHECK(changed->keys().size() == 1);
+	CHECK(changed->keys()[0] == Variant("health"));
+	CHECK(changed->values()[0] == Variant(50));
+}
+
+TEST_CASE("[PersistentDictionary] Snapshots match deep duplicates") {
+	const int entries = 1000;
+	const int ticks = 50;
+
+	Dictionary state;
+	for (int i = 0; i < entries; i++) {
+		state[i] = i;
+	}
+	Ref<PersistentDictionary> persistent_state = PersistentDictionary::from_dictionary(state);
+
+	// Keep a snapshot per tick, then change one entry, as rollback does.
+	Vector<Dictionary> duplicates;
+	Vector<Ref<PersistentDictionary>> snapshots;
+	for (int i = 0; i < ticks; i++) {
+		duplicates.push_back(state.duplicate(true));
+		state[i] = -i;
+		snapshots.push_back(persistent_state);
+		persistent_state = persistent_state->set_value(i, -i);
+	}
+
+	for (int i = 0; i < ticks; i++) {
+		CHECK(snapshots[i]->to_dictionary() == duplicates[i]);
+	}
+	CHECK(persistent_state->to_dictionary() == state);
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][PersistentDictionary] Snapshots compared to deep duplication") {
+	const int entries = 10000;
+	const int ticks = 200;
+
+	Dictionary state;
+	for (int i = 0; i < entries; i++) {
+		state[i] = i;
+	}
+	Ref<PersistentDictionary> persistent_state = PersistentDictionary::from_dictionary(state);
+
+	// Keep a snapshot per tick, then change one entry, as rollback does.
+	Vector<Dictionary> duplicates;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < ticks; i++) {
+		duplicates.push_back(state.duplicate(true));
+		state[i] = -i;
+	}
+	uint64_t duplicate_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	Vector<Ref<PersistentDictionary>> snapshots;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < ticks; i++) {
+		snapshots.push_back(persistent_state);
+		persistent_state = persistent_state->set_value(i, -i);
+	}
+	uint64_t persistent_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(snapshots[ticks / 2]->get_value(ticks / 2) == duplicates[ticks / 2][ticks / 2]);
+	CHECK(persistent_state->to_dictionary() == state);
+	MESSAGE(vformat("%d snapshots of %d entries: duplicate(true) %d usec, PersistentDictionary %d usec.", ticks, entries, duplicate_usec, persistent_usec));
+}
+
+TEST_CASE("[PersistentArray] Snapshots match deep duplicates") {
+	const int elements = 1000;
+	const int ticks = 50;
+
+	Array state;
+	state.resize(elements);
+	Ref<PersistentArray> persistent_state = PersistentArray::from_array(state);
+
+	Vector<Array> duplicates;
+	Vector<Ref<PersistentArray>> snapshots;
+	for (int i = 0; i < ticks; i++) {
+		duplicates.push_back(state.duplicate(true));
+		state[i] = i;
+		snapshots.push_back(persistent_state);
+		persistent_state = persistent_state->set_at(i, i);
+	}
+
+	for (int i = 0; i < ticks; i++) {
+		CHECK(snapshots[i]->to_array() == duplicates[i]);
+	}
+	CHECK(persistent_state->to_array() == state);
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][PersistentArray] Snapshots compared to deep duplication") {
+	const int elements = 10000;
+	const int ticks = 200;
+
+	Array state;
+	state.resize(elements);
+	Ref<PersistentArray> persistent_state = PersistentArray::from_array(state);
+
+	Vector<Array> duplicates;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < ticks; i++) {
+		duplicates.push_back(state.duplicate(true));
+		state[i] = i;
+	}
+	uint64_t duplicate_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	Vector<Ref<PersistentArray>> snapshots;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < ticks; i++) {
+		snapshots.push_back(persistent_state);
+		persistent_state = persistent_state->set_at(i, i);
+	}
+	uint64_t persistent_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(snapshots[ticks / 2]->get_at(ticks / 2 - 1) == duplicates[ticks / 2][ticks / 2 - 1]);
+	CHECK(persistent_state->to_array() == state);
+	MESSAGE(vformat("%d snapshots of %d elements: duplicate(true) %d usec, PersistentArray %d usec.", ticks, elements, duplicate_usec, persistent_usec));
+}
+
+} // namespace TestPersistentCollections
+
+#endif // TEST_PERSISTENT_COLLECTIONS_H
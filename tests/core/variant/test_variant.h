@@ -31,6 +31,7 @@
 #ifndef TEST_VARIANT_H
 #define TEST_VARIANT_H
 
+#include "core/os/os.h"
 #include "core/variant/variant.h"
 #include "core/variant/variant_parser.h"
 
@@ -2208,6 +2209,109 @@ TEST_CASE("[Variant] Operator NOT") {
 	}
 }
 
+TEST_CASE("[Variant] Move semantics") {
+	Array array = build_array(1, 2, 3);
+	Variant source = array;
+	Variant moved = std::move(source);
+	CHECK(source.get_type() == Variant::NIL);
+	REQUIRE(moved.get_type() == Variant::ARRAY);
+	CHECK_MESSAGE(Array(moved).id() == array.id(), "Moving should hand over the same array storage.");
+
+	Variant target = "previous value";
+	target = std::move(moved);
+	CHECK(moved.get_type() == Variant::NIL);
+	REQUIRE(target.get_type() == Variant::ARRAY);
+	CHECK(Array(target).id() == array.id());
+
+#ifdef DEV_ENABLED
+	const uint64_t operations = SafeRefCountStats::operations;
+	Variant relocated = std::move(target);
+	target = std::move(relocated);
+	CHECK_MESSAGE(SafeRefCountStats::operations == operations, "Moving a Variant should not change any reference count.");
+#endif
+
+	String string = "Godot";
+	String moved_string = std::move(string);
+	CHECK(string.is_empty());
+	CHECK(moved_string == "Godot");
+	string = std::move(moved_string);
+	CHECK(moved_string.is_empty());
+	CHECK(string == "Godot");
+
+	Variant string_variant = String("Engine");
+	CHECK(string_variant == "Engine");
+
+	Array moved_array = std::move(array);
+	CHECK(moved_array.size() == 3);
+	// Moved-from containers stay usable.
+	CHECK(array.is_empty());
+	array.push_back(1);
+	CHECK(array.size() == 1);
+	Array assigned_array = build_array(4);
+	assigned_array = std::move(moved_array);
+	CHECK(assigned_array == build_array(1, 2, 3));
+	CHECK(moved_array == build_array(4));
+
+	Dictionary dictionary;
+	dictionary["key"] = "value";
+	Dictionary moved_dictionary = std::move(dictionary);
+	CHECK(moved_dictionary["key"] == "value");
+	CHECK(dictionary.is_empty());
+	dictionary["other"] = 1;
+	CHECK(dictionary.size() == 1);
+	Dictionary assigned_dictionary;
+	assigned_dictionary = std::move(moved_dictionary);
+	CHECK(assigned_dictionary.size() == 1);
+	CHECK(moved_dictionary.is_empty());
+
+	Object object;
+	Callable bound = Callable(&object, "get_class").bind(1);
+	REQUIRE(bound.is_custom());
+	Callable moved_callable = std::move(bound);
+	CHECK(bound.is_null());
+	CHECK(moved_callable.is_custom());
+	Callable standard = Callable(&object, "get_class");
+	standard = std::move(moved_callable);
+	CHECK(moved_callable.is_null());
+	CHECK(standard.is_custom());
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Variant] Reference count operations per call") {
+#ifdef DEV_ENABLED
+	Object object;
+	Variant object_variant = &object;
+	Variant string_variant = "Godot";
+	Variant array_variant = build_array(1, 2, 3);
+
+	struct CallCase {
+		Variant *base;
+		StringName method;
+	};
+	const CallCase cases[] = {
+		{ &object_variant, "get_class" },
+		{ &string_variant, "to_upper" },
+		{ &array_variant, "duplicate" },
+	};
+
+	const int iterations = 100000;
+	for (const CallCase &call_case : cases) {
+		const uint64_t operations = SafeRefCountStats::operations;
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < iterations; i++) {
+			Callable::CallError ce;
+			Variant ret;
+			call_case.base->callp(call_case.method, nullptr, 0, ret, ce);
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+		const double per_call = double(SafeRefCountStats::operations - operations) / iterations;
+		MESSAGE(vformat("%s.%s(): %.2f reference count operations per call, %d usec for %d calls.",
+				Variant::get_type_name(call_case.base->get_type()), call_case.method, per_call, (int64_t)usec, iterations));
+	}
+#else
+	MESSAGE("Counting reference count operations requires a build with DEV_ENABLED.");
+#endif
+}
+
 } // namespace TestVariant
 
 #endif // TEST_VARIANT_H
@@ -0,0 +1,189 @@
+/**************************************************************************/
+/*  test_editor_import_cache.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_EDITOR_IMPORT_CACHE_H
+#define TEST_EDITOR_IMPORT_CACHE_H
+
+#ifdef TOOLS_ENABLED
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "editor/editor_settings.h"
+#include "editor/import/editor_import_cache.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestEditorImportCache {
+
+// Copies the source to its main output and a platform variant, and writes the
+// `side` option, if any, to a side file.
+class _CacheTestImporter : public ResourceImporter {
+public:
+	virtual String get_importer_name() const override { return "cache_test"; }
+	virtual String get_visible_name() const override { return "Cache Test"; }
+	virtual void get_recognized_extensions(List<String> *p_extensions) const override { p_extensions->push_back("cachetest"); }
+	virtual String get_save_extension() const override { return "out"; }
+	virtual String get_resource_type() const override { return "Resource"; }
+	virtual void get_import_options(const String &p_path, List<ImportOption> *r_options, int p_preset = 0) const override {}
+	virtual bool get_option_visibility(const String &p_path, const String &p_option, const HashMap<StringName, Variant> &p_options) const override { return true; }
+
+	virtual Error import(const String &p_source_file, const String &p_save_path, const HashMap<StringName, Variant> &p_options, List<String> *r_platform_variants, List<String> *r_gen_files = nullptr, Variant *r_metadata = nullptr) override {
+		const String text = FileAccess::get_file_as_string(p_source_file);
+		for (const String &file : { p_save_path + ".out", p_save_path + ".variant.out" }) {
+			Ref<FileAccess> f = FileAccess::open(file, FileAccess::WRITE);
+			ERR_FAIL_COND_V(f.is_null(), ERR_CANT_CREATE);
+			f->store_string(text);
+		}
+		const String side = p_options.has("side") ? String(p_options["side"]) : String();
+		if (!side.is_empty()) {
+			Ref<FileAccess> f = FileAccess::open(p_save_path + ".editor.side", FileAccess::WRITE);
+			ERR_FAIL_COND_V(f.is_null(), ERR_CANT_CREATE);
+			f->store_string(side);
+		}
+		r_platform_variants->push_back("variant");
+		*r_metadata = text.length();
+		return OK;
+	}
+};
+
+static void write_text(const String &p_path, const String &p_text) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(p_text);
+}
+
+static void remove_dir(const String &p_dir) {
+	Ref<DirAccess> da = DirAccess::open(p_dir);
+	if (da.is_valid()) {
+		da->erase_contents_recursive();
+		DirAccess::remove_absolute(p_dir);
+	}
+}
+
+TEST_CASE("[Editor][EditorImportCache] Keys, storing and restoring") {
+	const String cache_dir = TestUtils::get_temp_path("import_cache");
+	const String project_dir = TestUtils::get_temp_path("import_cache_project");
+	remove_dir(cache_dir);
+	remove_dir(project_dir);
+	REQUIRE(DirAccess::make_dir_recursive_absolute(project_dir.path_join("imported")) == OK);
+	EditorSettings::get_singleton()->set_setting("filesystem/import/shared_cache_path", cache_dir);
+
+	const String source = project_dir.path_join("source.cachetest");
+	const String normal = project_dir.path_join("normal.png");
+	const String base_path = project_dir.path_join("imported").path_join("source.cachetest-0123");
+	write_text(source, "hello");
+	write_text(normal, "normal A");
+
+	Ref<_CacheTestImporter> importer;
+	importer.instantiate();
+	HashMap<StringName, Variant> params;
+	params["side"] = "side A";
+	params["normal"] = normal;
+
+	const String key = EditorImportCache::make_key(source, importer, params, Variant());
+	REQUIRE_FALSE(key.is_empty());
+	CHECK(EditorImportCache::make_key(source, importer, params, Variant()) == key);
+
+	// Keys change with the options, the files they name and the source.
+	HashMap<StringName, Variant> other_params = params;
+	other_params["side"] = "side B";
+	CHECK(EditorImportCache::make_key(source, importer, other_params, Variant()) != key);
+	write_text(normal, "normal B");
+	CHECK(EditorImportCache::make_key(source, importer, params, Variant()) != key);
+	write_text(normal, "normal A");
+	write_text(source, "hello again");
+	CHECK(EditorImportCache::make_key(source, importer, params, Variant()) != key);
+	write_text(source, "hello");
+	CHECK(EditorImportCache::make_key(source, importer, params, Variant()) == key);
+
+	// Left over from an earlier import with other options, it must not be stored.
+	write_text(base_path + ".editor.stale", "stale");
+
+	List<String> variants;
+	Variant metadata;
+	CHECK_FALSE(EditorImportCache::restore(key, base_path, &variants, &metadata));
+	CHECK(EditorImportCache::begin_import(key, base_path));
+	CHECK(importer->import(source, base_path, params, &variants, nullptr, &metadata) == OK);
+	EditorImportCache::end_import(key, base_path, true, true, variants, metadata);
+	CHECK_FALSE(FileAccess::exists(base_path + ".editor.stale"));
+
+	SUBCASE("Restoring gives back the imported files") {
+		for (const String &suffix : { ".out", ".variant.out", ".editor.side" }) {
+			REQUIRE(DirAccess::remove_absolute(base_path + suffix) == OK);
+		}
+
+		List<String> restored_variants;
+		Variant restored_metadata;
+		REQUIRE(EditorImportCache::restore(key, base_path, &restored_variants, &restored_metadata));
+		CHECK(FileAccess::get_file_as_string(base_path + ".out") == "hello");
+		CHECK(FileAccess::get_file_as_string(base_path + ".variant.out") == "hello");
+		CHECK(FileAccess::get_file_as_string(base_path + ".editor.side") == "side A");
+		CHECK_FALSE(FileAccess::exists(base_path + ".editor.stale"));
+		CHECK(restored_variants.size() == 1);
+		CHECK(restored_variants.front()->get() == "variant");
+		CHECK(restored_metadata == metadata);
+	}
+
+	SUBCASE("A failed import keeps the previous outputs it didn't replace") {
+		CHECK(EditorImportCache::begin_import(key, base_path));
+		CHECK_FALSE(FileAccess::exists(base_path + ".out"));
+		EditorImportCache::end_import(key, base_path, false, false, List<String>(), Variant());
+		CHECK(FileAccess::get_file_as_string(base_path + ".out") == "hello");
+		CHECK(FileAccess::get_file_as_string(base_path + ".editor.side") == "side A");
+	}
+
+	SUBCASE("Storing again replaces the entry") {
+		write_text(source, "replaced");
+		CHECK(EditorImportCache::begin_import(key, base_path));
+		CHECK(importer->import(source, base_path, params, &variants, nullptr, &metadata) == OK);
+		EditorImportCache::end_import(key, base_path, true, true, variants, metadata);
+		REQUIRE(DirAccess::remove_absolute(base_path + ".out") == OK);
+
+		List<String> restored_variants;
+		Variant restored_metadata;
+		REQUIRE(EditorImportCache::restore(key, base_path, &restored_variants, &restored_metadata));
+		CHECK(FileAccess::get_file_as_string(base_path + ".out") == "replaced");
+	}
+
+	SUBCASE("Nothing is cached without a cache path") {
+		EditorSettings::get_singleton()->set_setting("filesystem/import/shared_cache_path", "");
+		CHECK(EditorImportCache::make_key(source, importer, params, Variant()).is_empty());
+	}
+
+	remove_dir(cache_dir);
+	remove_dir(project_dir);
+}
+
+} // namespace TestEditorImportCache
+
+#endif // TOOLS_ENABLED
+
+#endif // TEST_EDITOR_IMPORT_CACHE_H
@@ -31,6 +31,7 @@
 #ifndef TEST_PACKED_SCENE_H
 #define TEST_PACKED_SCENE_H
 
+#include "core/os/os.h"
 #include "scene/resources/packed_scene.h"
 
 #include "tests/test_macros.h"
@@ -215,6 +216,182 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+static Node *_make_spawn_scene(int p_children) {
+	Node *scene = memnew(Node);
+	scene->set_name("Spawn");
+	scene->set_process_priority(3);
+	for (int i = 0; i < p_children; i++) {
+		Node *child = memnew(Node);
+		child->set_name(vformat("Child%d", i));
+		child->set_process_priority(i + 1);
+		child->set_editor_description(vformat("Child number %d", i));
+		child->set_process_mode(Node::PROCESS_MODE_ALWAYS);
+		scene->add_child(child);
+		child->set_owner(scene);
+	}
+	return scene;
+}
+
+TEST_CASE("[PackedScene] Instantiation plans produce the same nodes") {
+	Node *scene = _make_spawn_scene(4);
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(scene);
+	memdelete(scene);
+
+	for (int pass = 0; pass < 2; pass++) {
+		SceneState::set_use_instantiation_plans(pass == 0);
+		// Instantiate twice so the second run goes through the already built plan.
+		for (int run = 0; run < 2; run++) {
+			Node *instance = packed_scene->instantiate();
+			REQUIRE(instance);
+			CHECK(instance->get_process_priority() == 3);
+			REQUIRE(instance->get_child_count() == 4);
+			for (int i = 0; i < 4; i++) {
+				Node *child = instance->get_child(i);
+				CHECK(child->get_name() == StringName(vformat("Child%d", i)));
+				CHECK(child->get_owner() == instance);
+				CHECK(child->get_process_priority() == i + 1);
+				CHECK(child->get_editor_description() == vformat("Child number %d", i));
+				CHECK(child->get_process_mode() == Node::PROCESS_MODE_ALWAYS);
+			}
+			memdelete(instance);
+		}
+	}
+	SceneState::set_use_instantiation_plans(true);
+
+	SUBCASE("Repacking drops the previous plan") {
+		Node *other = memnew(Node);
+		other->set_name("Other");
+		other->set_process_priority(7);
+		packed_scene->pack(other);
+		memdelete(other);
+
+		Node *instance = packed_scene->instantiate();
+		REQUIRE(instance);
+		CHECK(instance->get_name() == StringName("Other"));
+		CHECK(instance->get_process_priority() == 7);
+		CHECK(instance->get_child_count() == 0);
+		memdelete(instance);
+	}
+}
+
+TEST_CASE("[PackedScene] Pooled instances") {
+	Node *scene = _make_spawn_scene(2);
+	scene->add_to_group("spawned", true);
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(scene);
+	memdelete(scene);
+
+	Node *instance = packed_scene->acquire_instance();
+	REQUIRE(instance);
+	CHECK(packed_scene->get_pool_miss_count() == 1);
+	CHECK(packed_scene->get_pool_hit_count() == 0);
+
+	SUBCASE("Released instances are reset and reused") {
+		instance->set_process_priority(42);
+		instance->set_meta("temporary", true);
+		instance->add_to_group("extra", true);
+		instance->remove_from_group("spawned");
+		instance->get_child(1)->set_editor_description("Changed");
+		instance->get_child(1)->set_process_mode(Node::PROCESS_MODE_INHERIT);
+
+		packed_scene->release_instance(instance);
+		CHECK(packed_scene->get_pooled_instance_count() == 1);
+
+		Node *reused = packed_scene->acquire_instance();
+		CHECK(reused == instance);
+		CHECK(packed_scene->get_pool_hit_count() == 1);
+		CHECK(packed_scene->get_pooled_instance_count() == 0);
+		CHECK(reused->get_process_priority() == 3);
+		CHECK_FALSE(reused->has_meta("temporary"));
+		CHECK(reused->is_in_group("spawned"));
+		CHECK_FALSE(reused->is_in_group("extra"));
+		CHECK(reused->get_child(1)->get_editor_description() == "Child number 1");
+		CHECK(reused->get_child(1)->get_process_mode() == Node::PROCESS_MODE_ALWAYS);
+		memdelete(reused);
+	}
+
+	SUBCASE("Connections made after creation are dropped") {
+		Node *other = memnew(Node);
+		instance->connect("renamed", Callable(other, "get_name"));
+		instance->get_child(0)->connect("renamed", Callable(instance, "get_name"));
+		other->connect("renamed", Callable(instance->get_child(1), "get_name"));
+		instance->connect(SceneStringName(tree_entered), Callable(other, "get_name"), Object::CONNECT_PERSIST);
+
+		packed_scene->release_instance(instance);
+		REQUIRE(packed_scene->get_pooled_instance_count() == 1);
+		CHECK_FALSE(instance->is_connected("renamed", Callable(other, "get_name")));
+		CHECK_FALSE(instance->get_child(0)->is_connected("renamed", Callable(instance, "get_name")));
+		CHECK_FALSE(other->is_connected("renamed", Callable(instance->get_child(1), "get_name")));
+		CHECK(instance->is_connected(SceneStringName(tree_entered), Callable(other, "get_name")));
+
+		packed_scene->clear_pool();
+		memdelete(other);
+	}
+
+	SUBCASE("Only acquired instances are pooled") {
+		Node *other = packed_scene->instantiate();
+		packed_scene->release_instance(other);
+		CHECK(packed_scene->get_pooled_instance_count() == 0);
+		packed_scene->release_instance(instance);
+		CHECK(packed_scene->get_pooled_instance_count() == 1);
+	}
+
+	SUBCASE("Instances that changed structure are not pooled") {
+		Node *extra = memnew(Node);
+		instance->add_child(extra);
+		packed_scene->release_instance(instance);
+		CHECK(packed_scene->get_pooled_instance_count() == 0);
+	}
+
+	SUBCASE("Pool capacity") {
+		Node *second = packed_scene->acquire_instance();
+		packed_scene->set_pool_capacity(1);
+		packed_scene->release_instance(instance);
+		packed_scene->release_instance(second);
+		CHECK(packed_scene->get_pooled_instance_count() == 1);
+
+		packed_scene->set_pool_capacity(0);
+		CHECK(packed_scene->get_pooled_instance_count() == 0);
+	}
+
+	SUBCASE("Repacking clears the pool") {
+		packed_scene->release_instance(instance);
+		CHECK(packed_scene->get_pooled_instance_count() == 1);
+		Node *other = memnew(Node);
+		packed_scene->pack(other);
+		memdelete(other);
+		CHECK(packed_scene->get_pooled_instance_count() == 0);
+	}
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][PackedScene] Spawns per second with and without instantiation plans") {
+	Node *scene = _make_spawn_scene(32);
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(scene);
+	memdelete(scene);
+
+	const int spawns = 2000;
+	uint64_t usec[2] = {};
+	for (int pass = 0; pass < 2; pass++) {
+		SceneState::set_use_instantiation_plans(pass == 1);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < spawns; i++) {
+			Node *instance = packed_scene->instantiate();
+			REQUIRE(instance);
+			memdelete(instance);
+		}
+		usec[pass] = MAX<uint64_t>(OS::get_singleton()->get_ticks_usec() - begin, 1);
+	}
+	SceneState::set_use_instantiation_plans(true);
+
+	MESSAGE(vformat("%d spawns of a 33 node scene: %d spawns/s without plans, %d spawns/s with plans.",
+			spawns, (int64_t)(spawns * 1000000ull / usec[0]), (int64_t)(spawns * 1000000ull / usec[1])));
+}
+
 } // namespace TestPackedScene
 
 #endif // TEST_PACKED_SCENE_H